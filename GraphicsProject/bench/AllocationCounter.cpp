@@ -0,0 +1,52 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+//The Whole Replaceable (Pre C++17) new/delete Family Goes Through malloc/free, so Every Pairing Matches
+//Kept in its Own Translation Unit: Once Inlined into a Caller, GCC Pairs the free(...) w/ the Builtin new and Warns (-Wmismatched-new-delete)
+namespace {
+
+    std::atomic<size_t> allocations(0);
+
+    void* allocate(size_t size) noexcept {
+
+        allocations++;
+        return std::malloc(size ? size : 1);
+
+    }
+
+}
+
+size_t AllocationCounter::count() {
+
+    return allocations;
+
+}
+
+void* operator new(size_t size) {
+
+    void* memory = allocate(size);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+
+}
+
+void* operator new[](size_t size) {
+
+    void* memory = allocate(size);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
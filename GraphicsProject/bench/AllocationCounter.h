@@ -0,0 +1,14 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+//Counts Every Heap Allocation in the Process, for Benchmarks Sampling it Around the Calls they Time
+//Linking AllocationCounter.cpp Replaces the Global new/delete Family, so Only Link it into Benchmark Executables
+namespace AllocationCounter {
+
+    size_t count();
+
+}
+
+#endif
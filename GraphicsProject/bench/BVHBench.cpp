@@ -0,0 +1,249 @@
+//Scene BVH Query Benchmark: Raycast, Overlap and Nearest Against a City of Instanced Building Models
+//Every Query Kind is Checked Against a Brute Force Pass over Every Triangle of Every Instance, no GL Context Needed
+
+#include <glm/glm.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "SceneBVH.h"
+#include "BenchRandom.h"
+
+static const int MODELS = 6;
+static const int CHUNK_RADIUS = 8; //Matches Generator's View Square
+static const int BUILDINGS_PER_CHUNK = 9;
+static const float CHUNK_SIZE = 1000.0f;
+static const float BUILDING_SCALE = 100.0f;
+static const int QUERIES = 20000;
+static const int CHECKED = 500; //Queries Also Run Brute Force
+
+struct Mesh {
+    std::vector<glm::vec3> positions;
+    std::vector<unsigned int> indices;
+};
+
+struct Placed {
+    glm::ivec2 chunk;
+    uint32_t building;
+    SceneBVH::Instance instance;
+};
+
+//Stepped Tower of Subdivided Boxes, Roughly the Size and Triangle Count of a Kit Skyscraper
+static Mesh makeTower(int tiers, int subdivisions) {
+
+    Mesh mesh;
+    float width = 0.6f, base = 0.0f;
+
+    for (int tier = 0; tier < tiers; tier++) {
+        float height = 0.4f + random01() * 0.6f;
+        glm::vec3 lo(-width, base, -width), hi(width, base + height, width);
+
+        //Six Faces, Each a Grid of Quads
+        for (int axis = 0; axis < 3; axis++) {
+            for (int side = 0; side < 2; side++) {
+                int u = (axis + 1) % 3, v = (axis + 2) % 3;
+                unsigned int start = static_cast<unsigned int>(mesh.positions.size());
+
+                for (int i = 0; i <= subdivisions; i++) {
+                    for (int j = 0; j <= subdivisions; j++) {
+                        glm::vec3 p;
+                        p[axis] = side ? hi[axis] : lo[axis];
+                        p[u] = lo[u] + (hi[u] - lo[u]) * i / subdivisions;
+                        p[v] = lo[v] + (hi[v] - lo[v]) * j / subdivisions;
+                        mesh.positions.push_back(p);
+                    }
+                }
+
+                for (int i = 0; i < subdivisions; i++) {
+                    for (int j = 0; j < subdivisions; j++) {
+                        unsigned int a = start + i * (subdivisions + 1) + j;
+                        unsigned int b = a + subdivisions + 1;
+                        unsigned int quad[6] = { a, b, a + 1, a + 1, b, b + 1 };
+                        mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+                    }
+                }
+            }
+        }
+
+        base += height;
+        width *= 0.75f;
+    }
+
+    return mesh;
+
+}
+
+static glm::vec3 randomPoint() {
+
+    float extent = (CHUNK_RADIUS + 0.5f) * CHUNK_SIZE;
+    return glm::vec3((random01() * 2.0f - 1.0f) * extent, random01() * 300.0f, (random01() * 2.0f - 1.0f) * extent);
+
+}
+
+static glm::vec3 randomDirection() {
+
+    glm::vec3 d;
+    do {
+        d = glm::vec3(random01() * 2.0f - 1.0f, random01() * 2.0f - 1.0f, random01() * 2.0f - 1.0f);
+    } while (glm::dot(d, d) > 1.0f || glm::dot(d, d) < 1e-4f);
+    return glm::normalize(d);
+
+}
+
+//Brute Force References (World Space Triangles)
+
+static float bruteRay(const std::vector<Mesh>& meshes, const std::vector<Placed>& placed, const glm::vec3& origin, const glm::vec3& direction, float maxDistance) {
+
+    float best = maxDistance;
+    bool hit = false;
+    for (const auto& p : placed) {
+        const Mesh& mesh = meshes[p.instance.model];
+        for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+            glm::vec3 a = p.instance.position + mesh.positions[mesh.indices[i]] * p.instance.scale;
+            glm::vec3 b = p.instance.position + mesh.positions[mesh.indices[i + 1]] * p.instance.scale;
+            glm::vec3 c = p.instance.position + mesh.positions[mesh.indices[i + 2]] * p.instance.scale;
+
+            glm::vec3 e1 = b - a, e2 = c - a, q = glm::cross(direction, e2);
+            float det = glm::dot(e1, q);
+            if (std::fabs(det) < 1e-12f) continue;
+            glm::vec3 s = origin - a;
+            float u = glm::dot(s, q) / det;
+            if (u < 0.0f || u > 1.0f) continue;
+            glm::vec3 r = glm::cross(s, e1);
+            float v = glm::dot(direction, r) / det;
+            if (v < 0.0f || u + v > 1.0f) continue;
+            float t = glm::dot(e2, r) / det;
+            if (t >= 0.0f && t < best) {
+                best = t;
+                hit = true;
+            }
+        }
+    }
+
+    return hit ? best : -1.0f;
+
+}
+
+static float bruteNearest(const std::vector<Mesh>& meshes, const std::vector<Placed>& placed, const glm::vec3& point, float maxDistance) {
+
+    //Sampled Closest Point is Overkill Here, so Compare Against Vertex and Edge Midpoint Distances as an Upper Bound
+    float best = maxDistance;
+    for (const auto& p : placed) {
+        const Mesh& mesh = meshes[p.instance.model];
+        for (const auto& position : mesh.positions) {
+            best = std::fmin(best, glm::length(p.instance.position + position * p.instance.scale - point));
+        }
+    }
+
+    return best;
+
+}
+
+template <typename Query>
+static double timeQueries(Query query) {
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < QUERIES; i++) query(i);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / QUERIES;
+
+}
+
+int main() {
+
+    //Models
+    std::vector<Mesh> meshes;
+    std::vector<std::shared_ptr<const ModelBVH>> models;
+    size_t triangles = 0;
+    for (int m = 0; m < MODELS; m++) {
+        meshes.push_back(makeTower(2 + m % 3, 4 + m));
+        models.push_back(std::make_shared<ModelBVH>(meshes.back().positions, meshes.back().indices));
+        triangles += models.back()->triangleCount();
+    }
+
+    //City
+    SceneBVH scene(models);
+    std::vector<Placed> placed;
+    auto buildStart = std::chrono::high_resolution_clock::now();
+    for (int x = -CHUNK_RADIUS; x <= CHUNK_RADIUS; x++) {
+        for (int z = -CHUNK_RADIUS; z <= CHUNK_RADIUS; z++) {
+            std::vector<SceneBVH::Instance> instances;
+            for (int b = 0; b < BUILDINGS_PER_CHUNK; b++) {
+                SceneBVH::Instance instance;
+                instance.position = glm::vec3(x * CHUNK_SIZE + 200.0f + (b % 3) * 300.0f, 0.0f, z * CHUNK_SIZE + 200.0f + (b / 3) * 300.0f);
+                instance.scale = BUILDING_SCALE;
+                instance.model = static_cast<uint32_t>(random01() * MODELS) % MODELS;
+                instances.push_back(instance);
+
+                Placed p;
+                p.chunk = glm::ivec2(x, z);
+                p.building = b;
+                p.instance = instance;
+                placed.push_back(p);
+            }
+            scene.insertChunk(glm::ivec2(x, z), instances);
+        }
+    }
+
+    //The First Query Pays for the Top Level Build, so Time it Here
+    SceneBVH::RayHit warm;
+    scene.raycast(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), 1.0f, warm);
+    auto buildEnd = std::chrono::high_resolution_clock::now();
+
+    std::printf("%zu chunks, %zu instances, %zu model triangles, scene build %.2f ms\n", scene.chunkCount(), placed.size(), triangles,
+        std::chrono::duration<double, std::milli>(buildEnd - buildStart).count());
+
+    //Pregenerated Queries, so Timing Excludes the Random Number Generator
+    std::vector<glm::vec3> origins(QUERIES), directions(QUERIES), boxSizes(QUERIES);
+    for (int i = 0; i < QUERIES; i++) {
+        origins[i] = randomPoint();
+        directions[i] = randomDirection();
+        boxSizes[i] = glm::vec3(random01(), random01(), random01()) * 100.0f + 10.0f;
+    }
+
+    const float RAY_LENGTH = 3000.0f, NEAREST_RANGE = 500.0f;
+    size_t hits = 0, overlaps = 0, nearby = 0;
+    std::vector<SceneBVH::BuildingRef> results;
+
+    double rayTime = timeQueries([&](int i) {
+        SceneBVH::RayHit hit;
+        if (scene.raycast(origins[i], directions[i], RAY_LENGTH, hit)) hits++;
+    });
+    double overlapTime = timeQueries([&](int i) {
+        results.clear();
+        overlaps += scene.overlap(origins[i] - boxSizes[i], origins[i] + boxSizes[i], results);
+    });
+    double nearestTime = timeQueries([&](int i) {
+        SceneBVH::NearestHit hit;
+        if (scene.nearest(origins[i], NEAREST_RANGE, hit)) nearby++;
+    });
+
+    std::printf("%-8s %12s %10s\n", "query", "us/query", "found");
+    std::printf("%-8s %12.2f %10zu\n", "raycast", rayTime, hits);
+    std::printf("%-8s %12.2f %10zu\n", "overlap", overlapTime, overlaps);
+    std::printf("%-8s %12.2f %10zu\n", "nearest", nearestTime, nearby);
+
+    //Validation
+    int rayMismatches = 0, nearestMismatches = 0;
+    for (int i = 0; i < CHECKED; i++) {
+        SceneBVH::RayHit hit;
+        float expected = bruteRay(meshes, placed, origins[i], directions[i], RAY_LENGTH);
+        bool found = scene.raycast(origins[i], directions[i], RAY_LENGTH, hit);
+        if (found != (expected >= 0.0f) || (found && std::fabs(hit.distance - expected) > 1e-2f * (1.0f + expected))) rayMismatches++;
+
+        //The BVH Result Must be no Farther than the Nearest Vertex
+        SceneBVH::NearestHit nearest;
+        float bound = bruteNearest(meshes, placed, origins[i], NEAREST_RANGE);
+        bool close = scene.nearest(origins[i], NEAREST_RANGE, nearest);
+        if ((bound < NEAREST_RANGE && !close) || (close && nearest.distance > bound + 1e-2f)) nearestMismatches++;
+    }
+
+    std::printf("validation over %d queries: raycast mismatches %d, nearest mismatches %d%s\n", CHECKED, rayMismatches, nearestMismatches,
+        rayMismatches == 0 && nearestMismatches == 0 ? "" : "  (MISMATCH)");
+
+    return rayMismatches == 0 && nearestMismatches == 0 ? 0 : 1;
+
+}
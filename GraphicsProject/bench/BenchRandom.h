@@ -0,0 +1,17 @@
+#ifndef BENCH_RANDOM_H
+#define BENCH_RANDOM_H
+
+#include <cstdint>
+
+//Xorshift32 in [0, 1). Fixed Seed, so Every Run of a Benchmark or Check Sees the Same Inputs
+inline float random01() {
+
+    static uint32_t state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return (state >> 8) * (1.0f / 16777216.0f);
+
+}
+
+#endif
@@ -0,0 +1,212 @@
+//Chunk Table Microbenchmark: Flat Open Addressing ChunkTable vs the Previous std::unordered_map + Vec2Hash
+//Replays the Insert/Find/Erase Pattern Generator::update Produces as the Camera Moves, no GL Context Needed
+
+#include <glm/glm.hpp>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ChunkTable.h"
+
+//Stand-in for Generator::ChunkData (Same Size and Heap Behaviour)
+struct Payload {
+    glm::ivec2 position;
+    uint32_t seed = 0;
+    std::vector<glm::vec4> buildings;
+};
+
+//Previous Chunk Hash, Kept Here as the Baseline
+struct Vec2Hash {
+
+    size_t operator()(const glm::ivec2& v) const {
+
+        return std::hash<int>()(v.x) ^ (std::hash<int>()(v.y) << 1);
+
+    }
+};
+
+static const int VIEW_DISTANCE = 4;
+static const int UNLOAD_DISTANCE = VIEW_DISTANCE + 2;
+static const int STEPS = 20000;
+static const int REPEATS = 5;
+
+//Camera Paths in Chunk Coordinates, One Sample per Frame
+static std::vector<glm::ivec2> makePath(const std::string& name) {
+
+    std::vector<glm::ivec2> path;
+    path.reserve(STEPS);
+    uint32_t state = 12345;
+
+    glm::vec2 position(0.0f);
+    for (int i = 0; i < STEPS; i++) {
+        if (name == "straight") {
+            position = glm::vec2(i * 0.05f, i * 0.02f);
+        }
+        else if (name == "diagonal") {
+            position = glm::vec2(i * 0.05f, i * 0.05f);
+        }
+        else if (name == "oscillate") {
+            position = glm::vec2(std::sin(i * 0.1f) * 0.6f, 0.0f);
+        }
+        else {
+            state = state * 1664525u + 1013904223u;
+            float angle = (state >> 8) * (6.2831853f / 16777216.0f);
+            position += glm::vec2(std::cos(angle), std::sin(angle)) * 0.08f;
+        }
+        path.push_back(glm::ivec2(static_cast<int>(std::floor(position.x)), static_cast<int>(std::floor(position.y))));
+    }
+
+    return path;
+
+}
+
+static bool within(const glm::ivec2& a, const glm::ivec2& b, int distance) {
+
+    return std::abs(a.x - b.x) <= distance && std::abs(a.y - b.y) <= distance;
+
+}
+
+static Payload makePayload(const glm::ivec2& position) {
+
+    Payload payload;
+    payload.position = position;
+    payload.seed = static_cast<uint32_t>(position.x) * 12345u + static_cast<uint32_t>(position.y) * 67890u;
+    payload.buildings.resize(9);
+    return payload;
+
+}
+
+static double runUnorderedMap(const std::vector<glm::ivec2>& path, size_t& checksum) {
+
+    std::unordered_map<glm::ivec2, Payload, Vec2Hash> chunks;
+    glm::ivec2 lastCenter(INT_MIN);
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (const auto& center : path) {
+        for (int x = -VIEW_DISTANCE; x <= VIEW_DISTANCE; x++) {
+            for (int z = -VIEW_DISTANCE; z <= VIEW_DISTANCE; z++) {
+                glm::ivec2 pos = center + glm::ivec2(x, z);
+                auto found = chunks.find(pos);
+                if (found == chunks.end()) {
+                    chunks[pos] = makePayload(pos);
+                }
+                else {
+                    checksum += found->second.seed;
+                }
+            }
+        }
+
+        //Unload Pass Only Runs when the Camera Crosses into a New Chunk, as in Generator::update
+        if (center == lastCenter) continue;
+        lastCenter = center;
+
+        for (auto i = chunks.begin(); i != chunks.end();) {
+            if (!within(i->first, center, UNLOAD_DISTANCE)) i = chunks.erase(i);
+            else ++i;
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+
+}
+
+static double runChunkTable(const std::vector<glm::ivec2>& path, size_t& checksum) {
+
+    ChunkTable<Payload> chunks((UNLOAD_DISTANCE * 2 + 1) * (UNLOAD_DISTANCE * 2 + 1));
+    glm::ivec2 lastCenter(INT_MIN);
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (const auto& center : path) {
+        for (int x = -VIEW_DISTANCE; x <= VIEW_DISTANCE; x++) {
+            for (int z = -VIEW_DISTANCE; z <= VIEW_DISTANCE; z++) {
+                glm::ivec2 pos = center + glm::ivec2(x, z);
+                Payload* found = chunks.find(pos);
+                if (!found) {
+                    chunks[pos] = makePayload(pos);
+                }
+                else {
+                    checksum += found->seed;
+                }
+            }
+        }
+
+        if (center == lastCenter) continue;
+        lastCenter = center;
+
+        chunks.eraseIf([&center](const glm::ivec2& pos, Payload&) {
+            return !within(pos, center, UNLOAD_DISTANCE);
+        });
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+
+}
+
+//Probe Length Statistics Show How Well Each Hash Spreads a Diagonal Band of Chunks
+static void reportCollisions() {
+
+    const int N = 64;
+    std::unordered_map<glm::ivec2, int, Vec2Hash> legacy;
+    legacy.reserve(N * 8);
+    for (int i = 0; i < N; i++) {
+        for (int d = 0; d < 8; d++) {
+            legacy[glm::ivec2(i, i + d)] = 0;
+        }
+    }
+
+    size_t worstBucket = 0;
+    for (size_t b = 0; b < legacy.bucket_count(); b++) {
+        if (legacy.bucket_size(b) > worstBucket) worstBucket = legacy.bucket_size(b);
+    }
+
+    std::unordered_map<size_t, int> legacyHashes;
+    std::unordered_map<uint64_t, int> mixedHashes;
+    for (int i = 0; i < N; i++) {
+        for (int d = 0; d < 8; d++) {
+            glm::ivec2 key(i, i + d);
+            legacyHashes[Vec2Hash()(key)]++;
+            mixedHashes[hashChunkCoords(key)]++;
+        }
+    }
+
+    std::printf("diagonal band of %d keys: legacy %zu distinct hashes (worst bucket %zu), mixed %zu distinct hashes\n",
+        N * 8, legacyHashes.size(), worstBucket, mixedHashes.size());
+
+}
+
+int main() {
+
+    const char* paths[] = { "straight", "diagonal", "oscillate", "random_walk" };
+
+    std::printf("%-12s %16s %16s %8s\n", "path", "unordered_map ms", "ChunkTable ms", "speedup");
+
+    for (const char* name : paths) {
+        std::vector<glm::ivec2> path = makePath(name);
+
+        double bestMap = 1e30, bestTable = 1e30;
+        size_t checksumMap = 0, checksumTable = 0;
+
+        for (int r = 0; r < REPEATS; r++) {
+            double t = runUnorderedMap(path, checksumMap);
+            if (t < bestMap) bestMap = t;
+
+            t = runChunkTable(path, checksumTable);
+            if (t < bestTable) bestTable = t;
+        }
+
+        std::printf("%-12s %16.2f %16.2f %7.2fx%s\n", name, bestMap, bestTable, bestMap / bestTable,
+            checksumMap == checksumTable ? "" : "  (CHECKSUM MISMATCH)");
+    }
+
+    reportCollisions();
+    return 0;
+
+}
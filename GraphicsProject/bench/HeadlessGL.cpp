@@ -0,0 +1,101 @@
+#include "HeadlessGL.h"
+
+#include <EGL/egl.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+bool HeadlessGL::createContext() {
+
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        std::printf("ERROR::EGL:: No display\n");
+        return false;
+    }
+
+    EGLint configAttributes[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config;
+    EGLint configs = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configs) || configs == 0 || !eglBindAPI(EGL_OPENGL_API)) {
+        std::printf("ERROR::EGL:: No desktop GL config\n");
+        return false;
+    }
+
+    EGLint contextAttributes[] = { EGL_CONTEXT_MAJOR_VERSION, 3, EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE };
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+
+    EGLint surfaceAttributes[] = { EGL_WIDTH, 16, EGL_HEIGHT, 16, EGL_NONE };
+    EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+
+    if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, surface, surface, context)) {
+        std::printf("ERROR::EGL:: Couldn't create a GL 3.3 core context\n");
+        return false;
+    }
+
+    if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+        std::printf("ERROR::GLAD:: Failed to load GL\n");
+        return false;
+    }
+
+    std::printf("%s, %s\n", glGetString(GL_RENDERER), glGetString(GL_VERSION));
+    return true;
+
+}
+
+std::string HeadlessGL::readShader(const char* name) {
+
+    std::ifstream file(std::string(PROJECT_ROOT) + "/src/shaders/" + name);
+    std::stringstream source;
+    source << file.rdbuf();
+    return source.str();
+
+}
+
+GLuint HeadlessGL::compileShader(GLenum type, const std::string& source, const char* name) {
+
+    const char* code = source.c_str();
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &code, nullptr);
+    glCompileShader(shader);
+
+    GLint success;
+    char infoLog[1024];
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
+        std::printf("ERROR::SHADER_COMPILATION_ERROR:: %s\n%s\n", name, infoLog);
+    }
+
+    return shader;
+
+}
+
+GLuint HeadlessGL::linkProgram(const std::string& vertexSource, const char* vertexName, const std::string& fragmentSource, const char* fragmentName,
+    const std::vector<const char*>& feedbackVaryings) {
+
+    GLuint program = glCreateProgram();
+    GLuint vertex = compileShader(GL_VERTEX_SHADER, vertexSource, vertexName);
+    GLuint fragment = compileShader(GL_FRAGMENT_SHADER, fragmentSource, fragmentName);
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    if (!feedbackVaryings.empty()) {
+        glTransformFeedbackVaryings(program, static_cast<GLsizei>(feedbackVaryings.size()), feedbackVaryings.data(), GL_INTERLEAVED_ATTRIBS);
+    }
+    glLinkProgram(program);
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+
+    GLint success;
+    char infoLog[1024];
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+        std::printf("ERROR::PROGRAM_LINKING_ERROR:: %s\n%s\n", vertexName, infoLog);
+        return 0;
+    }
+
+    return program;
+
+}
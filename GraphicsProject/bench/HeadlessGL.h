@@ -0,0 +1,26 @@
+#ifndef HEADLESS_GL_H
+#define HEADLESS_GL_H
+
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+
+//GL 3.3 Core Context w/o a Window, for the Checks that Need Real Shaders. Made w/ EGL on a Pbuffer, so Mesa's Software
+//Rasteriser is Enough (EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1)
+namespace HeadlessGL {
+
+    //Prints the Renderer on Success, the Failing Step Otherwise
+    bool createContext();
+
+    //Source of a File in src/shaders
+    std::string readShader(const char* name);
+
+    GLuint compileShader(GLenum type, const std::string& source, const char* name);
+
+    //Vertex Outputs in feedbackVaryings are Captured Interleaved, in Order. 0 When Linking Fails
+    GLuint linkProgram(const std::string& vertexSource, const char* vertexName, const std::string& fragmentSource, const char* fragmentName,
+        const std::vector<const char*>& feedbackVaryings = {});
+
+}
+
+#endif
@@ -0,0 +1,389 @@
+//Impostor Check: the Octahedral Mapping, then a Real Bake and Billboard Draw Against the Mesh it Stands in For
+//A Stepped Tower is Baked into a One Layer Atlas w/ impostorBake.vert/.frag (the Same Frame Views as ImpostorAtlas), then
+//from Every Frame's Direction the Billboard (impostor.vert/.frag) and the Mesh (Lit Like impostor.frag) are Drawn into
+//Matching Offscreen Targets and their Coverage and Colour Compared. Needs a GL 3.3 Context, Made Headless w/ EGL, so it
+//Runs on Mesa's Software Rasteriser (EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 impostor_check)
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Octahedral.h"
+#include "HeadlessGL.h"
+
+//Mirrors ImpostorAtlas's Bake Layout
+static const int FRAMES = 8;
+static const int FRAME_SIZE = 64;
+static const int ATLAS_SIZE = FRAMES * FRAME_SIZE;
+
+static const float ROUND_TRIP_TOLERANCE = 1e-5f;
+static const float MIN_COVERAGE_OVERLAP = 0.95f; //Intersection over Union of Billboard and Mesh Pixels
+static const float MAX_COLOUR_DIFFERENCE = 0.03f; //Mean per Channel, over Pixels Both Cover
+
+static const glm::vec3 LIGHT_DIR(-0.3f, -1.0f, -0.4f);
+
+//The Mesh Lit as impostor.frag Lights the Billboard: Same Terms, and the View Vector Taken from the Point on the
+//Billboard's Plane (Through the Bounding Sphere's Centre) the Fragment Projects to, Rather than from the Surface Itself
+static const char* LIT_MESH_VERTEX = R"(#version 330 core
+layout (location = 0) in vec3 vertexPosition;
+layout (location = 1) in vec3 vertexNormal;
+layout (location = 3) in vec3 vertexColour;
+out vec3 Normal;
+out vec3 VertexColour;
+out vec3 PlanePos;
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 centre;
+uniform vec3 viewDirection;
+void main() {
+    Normal = vertexNormal;
+    VertexColour = vertexColour;
+    PlanePos = vertexPosition - dot(vertexPosition - centre, viewDirection) * viewDirection;
+    gl_Position = projection * view * vec4(vertexPosition, 1.0);
+}
+)";
+
+static const char* LIT_MESH_FRAGMENT = R"(#version 330 core
+out vec4 fragColour;
+in vec3 Normal;
+in vec3 VertexColour;
+in vec3 PlanePos;
+uniform vec3 lightDir;
+uniform vec3 viewPosition;
+void main() {
+    vec3 normal = normalize(Normal);
+    vec3 lightDirNorm = normalize(-lightDir);
+    vec3 halfwayDir = normalize(lightDirNorm + normalize(viewPosition - PlanePos));
+    vec3 ambient = 0.2 * VertexColour;
+    vec3 diffuse = 0.5 * max(dot(normal, lightDirNorm), 0.0) * VertexColour;
+    vec3 specular = 0.6 * pow(max(dot(normal, halfwayDir), 0.0), 32.0) * vec3(1.0);
+    fragColour = vec4(ambient + diffuse + specular, 1.0);
+}
+)";
+
+//BuildingBatch's Vertex Layout
+struct BatchVertex {
+    glm::vec3 Position;
+    glm::vec3 Normal;
+    glm::vec3 Colour;
+};
+
+struct Impostor {
+    glm::vec4 positionScale;
+    float layer;
+};
+
+static void setMat4(GLuint program, const char* name, const glm::mat4& value) {
+
+    glUniformMatrix4fv(glGetUniformLocation(program, name), 1, GL_FALSE, glm::value_ptr(value));
+
+}
+
+//Stepped Tower of Boxes, a Different Colour per Tier, Roughly the Proportions of a Kit Skyscraper
+static void makeTower(std::vector<BatchVertex>& vertices, std::vector<GLuint>& indices) {
+
+    const glm::vec3 COLOURS[] = { glm::vec3(0.8f, 0.3f, 0.2f), glm::vec3(0.2f, 0.6f, 0.8f), glm::vec3(0.9f, 0.8f, 0.3f) };
+    float width = 0.6f, base = 0.0f;
+
+    for (int tier = 0; tier < 3; tier++) {
+        float height = 1.2f - tier * 0.3f;
+        glm::vec3 lo(-width, base, -width * 0.7f), hi(width, base + height, width * 0.7f);
+
+        for (int axis = 0; axis < 3; axis++) {
+            for (int side = 0; side < 2; side++) {
+                int u = (axis + 1) % 3, v = (axis + 2) % 3;
+                glm::vec3 normal(0.0f);
+                normal[axis] = side ? 1.0f : -1.0f;
+
+                GLuint start = static_cast<GLuint>(vertices.size());
+                for (int corner = 0; corner < 4; corner++) {
+                    glm::vec3 p;
+                    p[axis] = side ? hi[axis] : lo[axis];
+                    p[u] = (corner & 1) ? hi[u] : lo[u];
+                    p[v] = (corner & 2) ? hi[v] : lo[v];
+                    vertices.push_back({ p, normal, COLOURS[tier] });
+                }
+
+                GLuint quad[6] = { start, start + 1, start + 3, start, start + 3, start + 2 };
+                indices.insert(indices.end(), quad, quad + 6);
+            }
+        }
+
+        base += height;
+        width *= 0.7f;
+    }
+
+}
+
+//Round Trip, Every Frame Centre Selecting its Own Frame, and Orthonormal Frame Bases
+static int checkMapping() {
+
+    int failures = 0;
+    float worstRoundTrip = 0.0f, worstBasis = 0.0f, worstSelection = 1.0f;
+    uint32_t state = 2463534242u;
+
+    for (int i = 0; i < 20000; i++) {
+        float sample[3];
+        for (float& s : sample) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            s = (state >> 8) * (2.0f / 16777216.0f) - 1.0f;
+        }
+
+        glm::vec3 direction(sample[0], std::fabs(sample[1]), sample[2]);
+        if (glm::length(direction) < 1e-3f) continue;
+        direction = glm::normalize(direction);
+
+        worstRoundTrip = std::max(worstRoundTrip, glm::length(decodeHemiOctahedral(encodeHemiOctahedral(direction)) - direction));
+
+        //The Selected Frame's Centre can't be Farther than a Frame's Angular Size Away
+        glm::vec3 centre = octahedralFrameDirection(octahedralFrame(direction, FRAMES), FRAMES);
+        worstSelection = std::min(worstSelection, glm::dot(centre, direction));
+    }
+
+    for (int y = 0; y < FRAMES; y++) {
+        for (int x = 0; x < FRAMES; x++) {
+            glm::vec3 direction = octahedralFrameDirection(glm::ivec2(x, y), FRAMES);
+            if (octahedralFrame(direction, FRAMES) != glm::ivec2(x, y)) failures++;
+
+            glm::vec3 right, up;
+            octahedralFrameBasis(direction, right, up);
+            worstBasis = std::max(worstBasis, std::fabs(glm::dot(right, up)) + std::fabs(glm::dot(right, direction)) +
+                std::fabs(glm::length(up) - 1.0f) + std::fabs(glm::dot(glm::cross(right, up), direction) - 1.0f));
+        }
+    }
+
+    float worstAngle = std::acos(std::min(1.0f, worstSelection)) * 57.29578f;
+    bool passed = failures == 0 && worstRoundTrip <= ROUND_TRIP_TOLERANCE && worstBasis <= 1e-4f && worstAngle < 90.0f / FRAMES * 2.0f;
+    std::printf("mapping: round trip %.2e, frame centres reselected %d/%d, basis error %.2e, worst view to frame %.1f deg%s\n",
+        worstRoundTrip, FRAMES * FRAMES - failures, FRAMES * FRAMES, worstBasis, worstAngle, passed ? "" : "  (FAIL)");
+
+    return passed ? 0 : 1;
+
+}
+
+static GLuint createTarget(int size, GLenum format, GLuint& colour, GLuint& depth) {
+
+    GLuint fbo;
+    glGenFramebuffers(1, &fbo);
+    glGenTextures(1, &colour);
+    glGenRenderbuffers(1, &depth);
+
+    glBindTexture(GL_TEXTURE_2D, colour);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colour, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+    return fbo;
+
+}
+
+int main() {
+
+    int failures = checkMapping();
+    if (!HeadlessGL::createContext()) return 1;
+
+    std::vector<BatchVertex> vertices;
+    std::vector<GLuint> indices;
+    makeTower(vertices, indices);
+
+    glm::vec3 boundsMin(1e30f), boundsMax(-1e30f);
+    for (const auto& vertex : vertices) {
+        boundsMin = glm::min(boundsMin, vertex.Position);
+        boundsMax = glm::max(boundsMax, vertex.Position);
+    }
+    glm::vec3 centre = (boundsMin + boundsMax) * 0.5f;
+    float radius = glm::length(boundsMax - boundsMin) * 0.5f;
+
+    //Buffer Setup
+    GLuint meshVAO, meshVBO, meshEBO;
+    glGenVertexArrays(1, &meshVAO);
+    glGenBuffers(1, &meshVBO);
+    glGenBuffers(1, &meshEBO);
+    glBindVertexArray(meshVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(BatchVertex), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)offsetof(BatchVertex, Position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)offsetof(BatchVertex, Normal));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)offsetof(BatchVertex, Colour));
+
+    //One Identity Instance Matrix, as a Constant Attribute
+    for (int j = 0; j < 4; j++) {
+        glm::vec4 column(0.0f);
+        column[j] = 1.0f;
+        glVertexAttrib4fv(7 + j, glm::value_ptr(column));
+    }
+    //Buffer Setup
+
+    //Bake, Frame by Frame into One Atlas Layer (as ImpostorAtlas::bake)
+    GLuint atlases[2];
+    glGenTextures(2, atlases);
+    for (GLuint atlas : atlases) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, atlas);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, ATLAS_SIZE, ATLAS_SIZE, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    GLuint bakeFBO, bakeDepth;
+    glGenFramebuffers(1, &bakeFBO);
+    glGenRenderbuffers(1, &bakeDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, bakeDepth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, ATLAS_SIZE, ATLAS_SIZE);
+    glBindFramebuffer(GL_FRAMEBUFFER, bakeFBO);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, bakeDepth);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, atlases[0], 0, 0);
+    glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, atlases[1], 0, 0);
+    GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::printf("ERROR::IMPOSTOR_CHECK:: Bake framebuffer is incomplete\n");
+        return 1;
+    }
+
+    GLuint bakeProgram = HeadlessGL::linkProgram(HeadlessGL::readShader("impostorBake.vert"), "impostorBake.vert", HeadlessGL::readShader("impostorBake.frag"), "impostorBake.frag");
+    GLuint litProgram = HeadlessGL::linkProgram(LIT_MESH_VERTEX, "lit mesh", LIT_MESH_FRAGMENT, "lit mesh");
+    GLuint impostorProgram = HeadlessGL::linkProgram(HeadlessGL::readShader("impostor.vert"), "impostor.vert", HeadlessGL::readShader("impostor.frag"), "impostor.frag");
+    if (!bakeProgram || !litProgram || !impostorProgram) return 1;
+
+    glEnable(GL_DEPTH_TEST);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glViewport(0, 0, ATLAS_SIZE, ATLAS_SIZE);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    glUseProgram(bakeProgram);
+    setMat4(bakeProgram, "projection", octahedralBakeProjection(radius));
+    for (int y = 0; y < FRAMES; y++) {
+        for (int x = 0; x < FRAMES; x++) {
+            glViewport(x * FRAME_SIZE, y * FRAME_SIZE, FRAME_SIZE, FRAME_SIZE);
+            setMat4(bakeProgram, "view", octahedralBakeView(glm::ivec2(x, y), FRAMES, centre, radius));
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+        }
+    }
+
+    //Billboard Quad w/ One Instance at the Origin (Mirrors ImpostorAtlas::setupQuad)
+    float corners[8] = { -1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f };
+    GLuint quadIndices[6] = { 0, 1, 2, 0, 2, 3 };
+    Impostor instance = { glm::vec4(0.0f, 0.0f, 0.0f, 1.0f), 0.0f };
+
+    //Buffer Setup
+    GLuint quadVAO, quadVBO, quadEBO, instanceVBO;
+    glGenVertexArrays(1, &quadVAO);
+    glGenBuffers(1, &quadVBO);
+    glGenBuffers(1, &quadEBO);
+    glGenBuffers(1, &instanceVBO);
+    glBindVertexArray(quadVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(quadIndices), quadIndices, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(Impostor), &instance, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(7);
+    glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(Impostor), (void*)offsetof(Impostor, positionScale));
+    glVertexAttribDivisor(7, 1);
+    glEnableVertexAttribArray(8);
+    glVertexAttribPointer(8, 1, GL_FLOAT, GL_FALSE, sizeof(Impostor), (void*)offsetof(Impostor, layer));
+    glVertexAttribDivisor(8, 1);
+    //Buffer Setup
+
+    glUseProgram(impostorProgram);
+    glUniform1i(glGetUniformLocation(impostorProgram, "frames"), FRAMES);
+    glUniform4fv(glGetUniformLocation(impostorProgram, "modelSpheres[0]"), 1, glm::value_ptr(glm::vec4(centre, radius)));
+    glUniform3fv(glGetUniformLocation(impostorProgram, "lightDir"), 1, glm::value_ptr(LIGHT_DIR));
+    glUniform1i(glGetUniformLocation(impostorProgram, "colourAtlas"), 0);
+    glUniform1i(glGetUniformLocation(impostorProgram, "normalAtlas"), 1);
+    setMat4(impostorProgram, "projection", octahedralBakeProjection(radius));
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, atlases[0]);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, atlases[1]);
+
+    glUseProgram(litProgram);
+    glUniform3fv(glGetUniformLocation(litProgram, "lightDir"), 1, glm::value_ptr(LIGHT_DIR));
+    glUniform3fv(glGetUniformLocation(litProgram, "centre"), 1, glm::value_ptr(centre));
+    setMat4(litProgram, "projection", octahedralBakeProjection(radius));
+
+    //Both Views Drawn at the Bake's Frame Resolution, so Billboard Texels Land One to a Pixel
+    GLuint targetColour, targetDepth;
+    GLuint target = createTarget(FRAME_SIZE, GL_RGBA8, targetColour, targetDepth);
+    std::vector<unsigned char> meshPixels(FRAME_SIZE * FRAME_SIZE * 4), impostorPixels(FRAME_SIZE * FRAME_SIZE * 4);
+    glViewport(0, 0, FRAME_SIZE, FRAME_SIZE);
+
+    float worstOverlap = 1.0f, worstColour = 0.0f;
+    for (int y = 0; y < FRAMES; y++) {
+        for (int x = 0; x < FRAMES; x++) {
+            glm::ivec2 frame(x, y);
+            glm::vec3 direction = octahedralFrameDirection(frame, FRAMES);
+            glm::mat4 view = octahedralBakeView(frame, FRAMES, centre, radius);
+            glm::vec3 viewPosition = centre + direction * radius * 2.0f;
+
+            glBindFramebuffer(GL_FRAMEBUFFER, target);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            glUseProgram(litProgram);
+            setMat4(litProgram, "view", view);
+            glUniform3fv(glGetUniformLocation(litProgram, "viewDirection"), 1, glm::value_ptr(direction));
+            glUniform3fv(glGetUniformLocation(litProgram, "viewPosition"), 1, glm::value_ptr(viewPosition));
+            glBindVertexArray(meshVAO);
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+            glReadPixels(0, 0, FRAME_SIZE, FRAME_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, meshPixels.data());
+
+            //The Billboard Picks its Frame from the Viewer Position, so this Also Checks impostor.vert's Selection
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            glUseProgram(impostorProgram);
+            setMat4(impostorProgram, "view", view);
+            glUniform3fv(glGetUniformLocation(impostorProgram, "viewPosition"), 1, glm::value_ptr(viewPosition));
+            glBindVertexArray(quadVAO);
+            glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, 1);
+            glReadPixels(0, 0, FRAME_SIZE, FRAME_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, impostorPixels.data());
+
+            size_t both = 0, either = 0;
+            double colourDifference = 0.0;
+            for (size_t p = 0; p < meshPixels.size(); p += 4) {
+                bool mesh = meshPixels[p + 3] > 0, impostor = impostorPixels[p + 3] > 0;
+                either += mesh || impostor;
+                if (!mesh || !impostor) continue;
+
+                both++;
+                for (int c = 0; c < 3; c++) {
+                    colourDifference += std::abs(meshPixels[p + c] - impostorPixels[p + c]) / 255.0;
+                }
+            }
+
+            float overlap = either ? static_cast<float>(both) / either : 0.0f;
+            float colour = both ? static_cast<float>(colourDifference / (both * 3)) : 1.0f;
+            worstOverlap = std::min(worstOverlap, overlap);
+            worstColour = std::max(worstColour, colour);
+        }
+    }
+
+    bool passed = worstOverlap >= MIN_COVERAGE_OVERLAP && worstColour <= MAX_COLOUR_DIFFERENCE;
+    failures += passed ? 0 : 1;
+    std::printf("billboard vs mesh over %d frame views: worst coverage overlap %.3f, worst mean colour difference %.4f%s\n",
+        FRAMES * FRAMES, worstOverlap, worstColour, passed ? "" : "  (MISMATCH)");
+
+    if (failures == 0) std::printf("impostor bake and billboards match the mesh\n");
+    return failures == 0 ? 0 : 1;
+
+}
@@ -0,0 +1,183 @@
+//Noise Microbenchmark: perlinNoise, octaveNoise (w/ and w/o Gradient) and Full generateHeightMap, Scalar vs AVX2 vs Thread Pool
+//Every Variant's Output is Compared Against the Scalar Path (they're Meant to be Bit Identical), no GL Context Needed
+//Usage: noise_bench [--json]   (--json Prints One JSON Object per Line, for Tracking Results Across Commits)
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Noise.h"
+#include "WorldGen.h"
+#include "ThreadPool.h"
+#include "BenchRandom.h"
+
+static const size_t POINTS = 1 << 16;
+static const size_t BLOCK = 4096; //Points per Parallel Task
+static const int REPEATS = 7;
+static const int OCTAVES[] = { 1, 3, 6, 8 };
+static const int RESOLUTIONS[] = { 33, 100, 257, 513 };
+static const float PERSISTENCE = 0.5f;
+
+struct Result {
+    std::string benchmark;
+    std::string variant;
+    int octaves;
+    int resolution; //0 for Point Sets
+    size_t samples;
+    double bestMilliseconds;
+    bool matches;
+};
+
+//Best of REPEATS, so One Descheduled Run Doesn't Skew the Result
+static double bestOf(const std::function<void()>& run) {
+
+    double best = 1e30;
+    for (int r = 0; r < REPEATS; r++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        run();
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    return best;
+
+}
+
+static bool identical(const std::vector<float>& a, const std::vector<float>& b) {
+
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+
+}
+
+static void report(const Result& result, bool json) {
+
+    double nanosecondsPerSample = result.bestMilliseconds * 1e6 / result.samples;
+
+    if (json) {
+        std::printf("{\"benchmark\":\"%s\",\"variant\":\"%s\",\"octaves\":%d,\"resolution\":%d,\"samples\":%zu,\"best_ms\":%.4f,"
+            "\"ns_per_sample\":%.3f,\"matches_scalar\":%s}\n", result.benchmark.c_str(), result.variant.c_str(), result.octaves,
+            result.resolution, result.samples, result.bestMilliseconds, nanosecondsPerSample, result.matches ? "true" : "false");
+    }
+    else {
+        std::printf("%-20s %-10s %8d %10d %10zu %10.3f %12.2f%s\n", result.benchmark.c_str(), result.variant.c_str(), result.octaves,
+            result.resolution, result.samples, result.bestMilliseconds, nanosecondsPerSample, result.matches ? "" : "  (MISMATCH)");
+    }
+
+}
+
+int main(int argc, char** argv) {
+
+    bool json = argc > 1 && std::strcmp(argv[1], "--json") == 0;
+    ThreadPool pool;
+    std::vector<Result> results;
+
+    //Points Spread over the Permutation Table's Whole Period
+    std::vector<float> x(POINTS), y(POINTS), out(POINTS), reference(POINTS);
+    for (size_t i = 0; i < POINTS; i++) {
+        x[i] = random01() * 256.0f;
+        y[i] = random01() * 256.0f;
+    }
+
+    //Single Perlin Evaluations (No Batched Form, so Scalar Only)
+    double perlinTime = bestOf([&]() {
+        for (size_t i = 0; i < POINTS; i++) out[i] = perlinNoise(x[i], y[i]);
+    });
+    results.push_back({ "perlin_noise", "scalar", 1, 0, POINTS, perlinTime, true });
+
+    //Fractal Sums per Octave Count
+    for (int octaves : OCTAVES) {
+        setNoiseSIMD(false);
+        double scalarTime = bestOf([&]() {
+            octaveNoiseBatch(x.data(), y.data(), POINTS, octaves, PERSISTENCE, reference.data());
+        });
+        results.push_back({ "octave_noise", "scalar", octaves, 0, POINTS, scalarTime, true });
+
+        setNoiseSIMD(true);
+        double simdTime = bestOf([&]() {
+            octaveNoiseBatch(x.data(), y.data(), POINTS, octaves, PERSISTENCE, out.data());
+        });
+        results.push_back({ "octave_noise", noiseUsesAVX2() ? "simd" : "simd_off", octaves, 0, POINTS, simdTime, identical(out, reference) });
+
+        std::fill(out.begin(), out.end(), 0.0f);
+        double threadedTime = bestOf([&]() {
+            pool.parallelFor((POINTS + BLOCK - 1) / BLOCK, [&](size_t block) {
+                size_t first = block * BLOCK;
+                octaveNoiseBatch(x.data() + first, y.data() + first, std::min(BLOCK, POINTS - first), octaves, PERSISTENCE, out.data() + first);
+            });
+        });
+        results.push_back({ "octave_noise", "threaded", octaves, 0, POINTS, threadedTime, identical(out, reference) });
+
+        //Value and Gradient Together, All Three Outputs Against the Scalar Batch
+        std::vector<float> gradientX(POINTS), gradientY(POINTS), referenceX(POINTS), referenceY(POINTS);
+        setNoiseSIMD(false);
+        double gradientScalarTime = bestOf([&]() {
+            octaveNoiseGradientBatch(x.data(), y.data(), POINTS, octaves, PERSISTENCE, reference.data(), referenceX.data(), referenceY.data());
+        });
+        results.push_back({ "octave_gradient", "scalar", octaves, 0, POINTS, gradientScalarTime, true });
+
+        setNoiseSIMD(true);
+        double gradientSimdTime = bestOf([&]() {
+            octaveNoiseGradientBatch(x.data(), y.data(), POINTS, octaves, PERSISTENCE, out.data(), gradientX.data(), gradientY.data());
+        });
+        results.push_back({ "octave_gradient", noiseUsesAVX2() ? "simd" : "simd_off", octaves, 0, POINTS, gradientSimdTime,
+            identical(out, reference) && identical(gradientX, referenceX) && identical(gradientY, referenceY) });
+    }
+
+    //Whole Heightmaps (generateHeightMap Always Sums 6 Octaves)
+    for (int resolution : RESOLUTIONS) {
+        size_t samples = static_cast<size_t>(resolution) * resolution;
+        glm::ivec2 chunk(3, -2);
+        std::vector<float> scalarHeights, heights;
+
+        setNoiseSIMD(false);
+        double scalarTime = bestOf([&]() {
+            scalarHeights = WorldGen::generateHeightMap(WorldGen::DEFAULT_WORLD_SEED, chunk, resolution);
+        });
+        results.push_back({ "generate_heightmap", "scalar", 6, resolution, samples, scalarTime, true });
+
+        setNoiseSIMD(true);
+        double simdTime = bestOf([&]() {
+            heights = WorldGen::generateHeightMap(WorldGen::DEFAULT_WORLD_SEED, chunk, resolution);
+        });
+        results.push_back({ "generate_heightmap", noiseUsesAVX2() ? "simd" : "simd_off", 6, resolution, samples, simdTime, identical(heights, scalarHeights) });
+
+        double threadedTime = bestOf([&]() {
+            heights = WorldGen::generateHeightMap(WorldGen::DEFAULT_WORLD_SEED, chunk, resolution, &pool);
+        });
+        results.push_back({ "generate_heightmap", "threaded", 6, resolution, samples, threadedTime, identical(heights, scalarHeights) });
+
+        //Analytic Normals Batch the Gradient Too. Heights Must Still Match, and the Normals Must Match the Scalar Gradient's
+        std::vector<float> normals, scalarNormals;
+        setNoiseSIMD(false);
+        WorldGen::generateHeightMap(WorldGen::DEFAULT_WORLD_SEED, chunk, resolution, nullptr, &scalarNormals);
+        setNoiseSIMD(true);
+        double normalsTime = bestOf([&]() {
+            heights = WorldGen::generateHeightMap(WorldGen::DEFAULT_WORLD_SEED, chunk, resolution, &pool, &normals);
+        });
+        results.push_back({ "generate_heightmap", "normals", 6, resolution, samples, normalsTime,
+            identical(heights, scalarHeights) && identical(normals, scalarNormals) });
+    }
+
+    bool allMatch = true;
+    if (json) {
+        std::printf("{\"benchmark\":\"config\",\"avx2\":%s,\"threads\":%zu,\"repeats\":%d}\n", noiseUsesAVX2() ? "true" : "false", pool.size() + 1, REPEATS);
+    }
+    else {
+        std::printf("avx2 %s, %zu threads (pool + caller), best of %d runs\n", noiseUsesAVX2() ? "on" : "off", pool.size() + 1, REPEATS);
+        std::printf("%-20s %-10s %8s %10s %10s %10s %12s\n", "benchmark", "variant", "octaves", "resolution", "samples", "best ms", "ns/sample");
+    }
+
+    for (const auto& result : results) {
+        report(result, json);
+        allMatch &= result.matches;
+    }
+
+    if (!allMatch && !json) std::printf("a variant's output differs from the scalar path\n");
+    return allMatch ? 0 : 1;
+
+}
@@ -0,0 +1,439 @@
+//Spawn Chunk Terrain Shader Check: the Packed Vertex Path and the CDLOD Height Tile Path Against the Float Mesh Path
+//Draws Each the Way Terrain and TerrainLOD Do (Same Shaders, Buffers, Index Grids and Textures) w/ Transform Feedback Capturing
+//what the Vertex Shaders Output per Triangle Corner, then Compares Them. Needs a GL 3.3 Context, Made Headless w/ EGL, so it
+//Runs on Mesa's Software Rasteriser (EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 terrain_shader_check)
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "WorldGen.h"
+#include "HeightmapMesher.h"
+#include "CDLOD.h"
+#include "HeadlessGL.h"
+
+static const uint32_t SEEDS[] = { 1u, 1234567u, 0xDEADBEEFu };
+static const int RESOLUTIONS[] = { WorldGen::HEIGHTMAP_RESOLUTION, 33, 257 };
+
+//Worst Acceptable Difference per Output (World Units for Positions)
+static const float POSITION_TOLERANCE = 1e-3f;
+static const float UV_TOLERANCE = 1e-5f;
+
+//Packed Vertices: One 16 Bit Height Step (Relative to the Height Range), and 8 Bit Octahedral Normals
+static const float PACKED_HEIGHT_STEPS = 1.0f;
+static const float PACKED_NORMAL_TOLERANCE = 0.02f;
+
+//Mirrors TerrainLOD
+static const float LOD_LEAF_RANGE = 400.0f;
+static const float LOD_BASE_HEIGHT = -50.0f;
+
+//CDLOD Normals Come from Half Float Slopes
+static const float LOD_NORMAL_TOLERANCE = 2e-3f;
+
+//Looking Across the Chunk from Near its Edge, so Nodes of More than One Level are Selected
+static const glm::vec3 LOD_CAMERA(0.0f, 150.0f, -450.0f);
+
+//TerrainLOD's Per Node Instance Data
+struct NodeInstance {
+    glm::vec4 node;
+    glm::vec4 tile;
+};
+
+//Vertex Outputs in varyings are Captured Interleaved, in Order
+static GLuint captureProgram(const char* vertexName, const char* fragmentName, const std::vector<const char*>& varyings) {
+
+    GLuint program = HeadlessGL::linkProgram(HeadlessGL::readShader(vertexName), vertexName, HeadlessGL::readShader(fragmentName), fragmentName, varyings);
+    if (!program) return 0;
+
+    //Identity Transforms, so Outputs are Model Space
+    glUseProgram(program);
+    glm::mat4 identity(1.0f);
+    const char* matrices[] = { "model", "view", "projection", "lightSpaceMatrix" };
+    for (const char* matrix : matrices) {
+        glUniformMatrix4fv(glGetUniformLocation(program, matrix), 1, GL_FALSE, glm::value_ptr(identity));
+    }
+    return program;
+
+}
+
+//floatsPerVertex Captured Floats for Each of the vertices Vertices draw Emits as primitive
+static std::vector<float> captureDraw(GLuint program, size_t vertices, size_t floatsPerVertex, GLenum primitive, const std::function<void()>& draw) {
+
+    std::vector<float> outputs(vertices * floatsPerVertex);
+
+    GLuint feedback;
+    glGenBuffers(1, &feedback);
+    glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, feedback);
+    glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, outputs.size() * sizeof(float), nullptr, GL_STATIC_READ);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, feedback);
+
+    glUseProgram(program);
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBeginTransformFeedback(primitive);
+    draw();
+    glEndTransformFeedback();
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    glGetBufferSubData(GL_TRANSFORM_FEEDBACK_BUFFER, 0, outputs.size() * sizeof(float), outputs.data());
+    glDeleteBuffers(1, &feedback);
+    return outputs;
+
+}
+
+//One Captured Float per Component, floatsPerVertex per Triangle Corner, Drawn w/ Whatever VAO is Bound
+//Strips Come Out as Separate Triangles, in the Same Corner Order as the Equivalent Triangle List
+static std::vector<float> capture(GLuint program, size_t triangles, size_t floatsPerVertex, GLenum mode, GLsizei indexCount, GLenum indexType) {
+
+    return captureDraw(program, triangles * 3, floatsPerVertex, GL_TRIANGLES, [&]() {
+        glEnable(GL_PRIMITIVE_RESTART);
+        glPrimitiveRestartIndex(indexType == GL_UNSIGNED_SHORT ? 0xFFFF : 0xFFFFFFFFu);
+        glDrawElements(mode, indexCount, indexType, 0);
+        glDisable(GL_PRIMITIVE_RESTART);
+    });
+
+}
+
+static GLuint uploadArray(GLuint location, const std::vector<float>& data, int components) {
+
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(float), data.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(location, components, GL_FLOAT, GL_FALSE, 0, 0);
+    glEnableVertexAttribArray(location);
+    return buffer;
+
+}
+
+static float maxDifference(const std::vector<float>& a, const std::vector<float>& b, size_t stride, size_t offset, size_t count) {
+
+    float worst = 0.0f;
+    for (size_t i = offset; i < a.size(); i += stride) {
+        for (size_t c = 0; c < count; c++) {
+            float difference = std::fabs(a[i + c] - b[i + c]);
+            if (std::isnan(difference)) return difference; //Fails Every Tolerance
+            worst = std::max(worst, difference);
+        }
+    }
+
+    return worst;
+
+}
+
+struct Difference {
+    float position = 0.0f, normal = 0.0f, uv = 0.0f, depth = 0.0f;
+};
+
+static Difference compare(const std::vector<float>& outputs, const std::vector<float>& expected, const std::vector<float>& depth,
+    const std::vector<float>& expectedDepth) {
+
+    Difference difference;
+    difference.uv = maxDifference(outputs, expected, 8, 0, 2);
+    difference.position = maxDifference(outputs, expected, 8, 2, 3);
+    difference.normal = maxDifference(outputs, expected, 8, 5, 3);
+    difference.depth = maxDifference(depth, expectedDepth, 4, 0, 4);
+    return difference;
+
+}
+
+static bool within(const Difference& difference, float position, float normal) {
+
+    return difference.position <= position && difference.depth <= position && difference.normal <= normal && difference.uv <= UV_TOLERANCE;
+
+}
+
+//CDLOD Path (as TerrainLOD Lays it Out): the Shared Patch, One Instance per Node, and the Chunk's Flattened Height Tile
+//and Slope Tiles in Layer 0 of Texture Arrays on GL_TEXTURE3 and GL_TEXTURE4. Returns the Patch's Index Count, w/ the VAO Left Bound
+static GLsizei setupLOD(const std::vector<float>& heights, const std::vector<float>& normals, int resolution, const std::vector<CDLOD::Node>& nodes,
+    GLuint VAO, GLuint* buffers, const GLuint* textures) {
+
+    int patchQuads = CDLOD::patchQuadsFor(resolution);
+    std::vector<glm::vec2> grid;
+    std::vector<uint16_t> indices;
+    for (int z = 0; z <= patchQuads; z++) {
+        for (int x = 0; x <= patchQuads; x++) {
+            grid.push_back(glm::vec2(x, z) / static_cast<float>(patchQuads));
+        }
+    }
+    for (int z = 0; z < patchQuads; z++) {
+        for (int x = 0; x < patchQuads; x++) {
+            uint16_t topLeft = static_cast<uint16_t>(z * (patchQuads + 1) + x);
+            uint16_t bottomLeft = static_cast<uint16_t>((z + 1) * (patchQuads + 1) + x);
+            uint16_t quad[6] = { topLeft, bottomLeft, static_cast<uint16_t>(topLeft + 1), static_cast<uint16_t>(topLeft + 1), bottomLeft,
+                static_cast<uint16_t>(bottomLeft + 1) };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+
+    std::vector<NodeInstance> instances;
+    for (const auto& node : nodes) {
+        NodeInstance instance;
+        glm::vec2 chunkMin = glm::vec2(node.chunk) * WorldGen::CHUNK_SIZE - glm::vec2(WorldGen::CHUNK_SIZE * 0.5f);
+        instance.node = glm::vec4(node.origin.x, node.origin.y, node.size, static_cast<float>(node.level));
+        instance.tile = glm::vec4(chunkMin.x, chunkMin.y, static_cast<float>(node.tile), 0.0f);
+        instances.push_back(instance);
+    }
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    glBufferData(GL_ARRAY_BUFFER, grid.size() * sizeof(glm::vec2), grid.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers[1]);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[2]);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(NodeInstance), instances.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(NodeInstance), (void*)offsetof(NodeInstance, node));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(NodeInstance), (void*)offsetof(NodeInstance, tile));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    //Texels as TerrainLOD::setTile(...) Uploads Them
+    std::vector<float> texels, slopes;
+    CDLOD::tileTexels(heights.data(), normals.data(), resolution, WorldGen::CHUNK_SIZE, texels, slopes);
+
+    const GLenum formats[2][2] = { { GL_R32F, GL_RED }, { GL_RG16F, GL_RG } };
+    const float* data[2] = { texels.data(), slopes.data() };
+    for (int i = 0; i < 2; i++) {
+        glActiveTexture(GL_TEXTURE3 + i);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, textures[i]);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, formats[i][0], resolution, resolution, 1, 0, formats[i][1], GL_FLOAT, data[i]);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+    glActiveTexture(GL_TEXTURE0);
+
+    return static_cast<GLsizei>(indices.size());
+
+}
+
+//TerrainLOD::render(...)'s Uniforms, w/ the Morph Ranges Pushed Out of Reach so No Vertex Morphs
+static void setLODUniforms(GLuint program, int resolution) {
+
+    glUseProgram(program);
+    glUniform3fv(glGetUniformLocation(program, "cameraPosition"), 1, glm::value_ptr(LOD_CAMERA));
+    glUniform1f(glGetUniformLocation(program, "chunkSize"), WorldGen::CHUNK_SIZE);
+    glUniform1f(glGetUniformLocation(program, "tileResolution"), static_cast<float>(resolution));
+    glUniform1f(glGetUniformLocation(program, "patchQuads"), static_cast<float>(CDLOD::patchQuadsFor(resolution)));
+    glUniform1f(glGetUniformLocation(program, "baseHeight"), LOD_BASE_HEIGHT);
+    glUniform1i(glGetUniformLocation(program, "heightTiles"), 3);
+    glUniform1i(glGetUniformLocation(program, "slopeTiles"), 4);
+    for (int level = 0; level < CDLOD::LEVELS; level++) {
+        std::string name = "morphRanges[" + std::to_string(level) + "]";
+        glUniform2f(glGetUniformLocation(program, name.c_str()), 1e8f, 2e8f);
+    }
+
+}
+
+//Every CDLOD Vertex Against the Float Mesh's Per Vertex Outputs (TexCoords, FragPos, Normal), Bilinearly Interpolated at
+//its x/z the Way the Tiles are Filtered. The Depth Pass Must Land on the Main Pass's Positions
+static Difference compareLOD(const std::vector<float>& outputs, const std::vector<float>& depth, const std::vector<float>& meshVertices, int resolution) {
+
+    Difference difference;
+    float gridSize = WorldGen::CHUNK_SIZE / (resolution - 1);
+
+    for (size_t vertex = 0; vertex * 8 < outputs.size(); vertex++) {
+        const float* output = &outputs[vertex * 8];
+        float gridX = (output[2] + WorldGen::CHUNK_SIZE * 0.5f) / gridSize;
+        float gridZ = (output[4] + WorldGen::CHUNK_SIZE * 0.5f) / gridSize;
+        int x0 = std::min(std::max(static_cast<int>(std::floor(gridX)), 0), resolution - 2);
+        int z0 = std::min(std::max(static_cast<int>(std::floor(gridZ)), 0), resolution - 2);
+        float tx = gridX - x0, tz = gridZ - z0;
+
+        float expected[8];
+        for (int c = 0; c < 8; c++) {
+            auto at = [&](int x, int z) { return meshVertices[(static_cast<size_t>(z) * resolution + x) * 8 + c]; };
+            float bottom = at(x0, z0) + (at(x0 + 1, z0) - at(x0, z0)) * tx;
+            float top = at(x0, z0 + 1) + (at(x0 + 1, z0 + 1) - at(x0, z0 + 1)) * tx;
+            expected[c] = bottom + (top - bottom) * tz;
+        }
+
+        //Slopes Interpolate Linearly, Unit Normals Don't: Scale Each Corner's Normal to y = 1 First
+        glm::vec3 slope(0.0f);
+        for (int corner = 0; corner < 4; corner++) {
+            int x = x0 + (corner & 1), z = z0 + (corner >> 1);
+            const float* cornerNormal = &meshVertices[(static_cast<size_t>(z) * resolution + x) * 8 + 5];
+            float weight = ((corner & 1) ? tx : 1.0f - tx) * ((corner >> 1) ? tz : 1.0f - tz);
+            slope += glm::vec3(cornerNormal[0], cornerNormal[1], cornerNormal[2]) / cornerNormal[1] * weight;
+        }
+        glm::vec3 normal = glm::normalize(slope);
+
+        for (int c = 0; c < 2; c++) difference.uv = std::max(difference.uv, std::fabs(output[c] - expected[c]));
+        difference.position = std::max(difference.position, std::fabs(output[3] - expected[3]));
+        for (int c = 0; c < 3; c++) difference.depth = std::max(difference.depth, std::fabs(depth[vertex * 4 + c] - output[2 + c]));
+        for (int c = 0; c < 3; c++) difference.normal = std::max(difference.normal, std::fabs(output[5 + c] - normal[c]));
+
+        if (std::isnan(output[3]) || std::isnan(output[5])) difference.position = output[3] + output[5];
+    }
+
+    return difference;
+
+}
+
+static void setUniforms(GLuint program, int usePackedVertices, int resolution, float heightMin, float heightRange) {
+
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "usePackedVertices"), usePackedVertices);
+    glUniform1i(glGetUniformLocation(program, "heightResolution"), resolution);
+    glUniform1f(glGetUniformLocation(program, "heightMin"), heightMin);
+    glUniform1f(glGetUniformLocation(program, "heightRange"), heightRange);
+
+}
+
+int main() {
+
+    if (!HeadlessGL::createContext()) return 1;
+
+    //TexCoords, FragPos, Normal (8 Floats), and gl_Position from the Depth Shader (4 Floats)
+    GLuint spawn = captureProgram("spawn.vert", "spawn.frag", { "TexCoords", "FragPos", "Normal" });
+    GLuint depth = captureProgram("spawnDepth.vert", "spawnDepth.frag", { "gl_Position" });
+    GLuint lod = captureProgram("terrainLOD.vert", "spawn.frag", { "TexCoords", "FragPos", "Normal" });
+    GLuint lodDepth = captureProgram("terrainLODDepth.vert", "spawnDepth.frag", { "gl_Position" });
+    if (!spawn || !depth || !lod || !lodDepth) return 1;
+
+    glm::mat4 lodViewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 5000.0f)
+        * glm::lookAt(LOD_CAMERA, glm::vec3(0.0f, -50.0f, 200.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    //Per Mesh GPU Memory. The Packed Path's Strip Grid is Shared Across Every Mesh of a Resolution, so is Listed Apart
+    std::printf("%-8s %-10s %5s %11s %11s %10s %10s %10s %10s\n", "path", "seed", "res", "mesh bytes", "grid bytes", "position", "normal", "uv", "depth");
+    bool passed = true;
+
+    for (int resolution : RESOLUTIONS) {
+        std::vector<unsigned int> grid;
+        HeightmapMesher::gridIndices(resolution, grid);
+        size_t triangles = grid.size() / 3;
+
+        bool shortIndices = HeightmapMesher::shortStripIndices(resolution);
+        std::vector<uint16_t> shortStrips;
+        std::vector<uint32_t> longStrips;
+        if (shortIndices) HeightmapMesher::stripIndices(resolution, shortStrips);
+        else HeightmapMesher::stripIndices(resolution, longStrips);
+        size_t stripCount = shortIndices ? shortStrips.size() : longStrips.size();
+        size_t stripBytes = shortIndices ? shortStrips.size() * sizeof(uint16_t) : longStrips.size() * sizeof(uint32_t);
+
+        for (uint32_t seed : SEEDS) {
+            //Analytic Normals, as the Spawn Chunk Gets Them
+            std::vector<float> normals;
+            std::vector<float> heights = WorldGen::generateHeightMap(seed, glm::ivec2(0, 0), resolution, nullptr, &normals);
+            HeightmapMesher::MeshData mesh;
+            HeightmapMesher::build(heights.data(), resolution, mesh, nullptr, normals.data());
+            HeightmapMesher::PackedMeshData packed;
+            HeightmapMesher::buildPacked(heights.data(), resolution, packed, nullptr, normals.data());
+
+            GLuint VAOs[2], EBOs[2], VBOs[4];
+            glGenVertexArrays(2, VAOs);
+            glGenBuffers(2, EBOs);
+
+            //Float Mesh Path (as Terrain::beginHeightmapMesh Lays it Out)
+            glBindVertexArray(VAOs[0]);
+            VBOs[0] = uploadArray(0, mesh.vertices, 3);
+            VBOs[1] = uploadArray(1, mesh.normals, 3);
+            VBOs[2] = uploadArray(2, mesh.uvs, 2);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBOs[0]);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(unsigned int), mesh.indices.data(), GL_STATIC_DRAW);
+
+            setUniforms(spawn, 0, resolution, 0.0f, 0.0f);
+            setUniforms(depth, 0, resolution, 0.0f, 0.0f);
+            std::vector<float> meshOutputs = capture(spawn, triangles, 8, GL_TRIANGLES, static_cast<GLsizei>(mesh.indices.size()), GL_UNSIGNED_INT);
+            std::vector<float> meshDepth = capture(depth, triangles, 4, GL_TRIANGLES, static_cast<GLsizei>(mesh.indices.size()), GL_UNSIGNED_INT);
+
+            //Packed Path (as Terrain::buildPackedHeightmapMesh Lays it Out)
+            glBindVertexArray(VAOs[1]);
+            glGenBuffers(1, &VBOs[3]);
+            glBindBuffer(GL_ARRAY_BUFFER, VBOs[3]);
+            glBufferData(GL_ARRAY_BUFFER, packed.vertices.size() * sizeof(HeightmapMesher::PackedVertex), packed.vertices.data(), GL_STATIC_DRAW);
+            glVertexAttribPointer(5, 1, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(HeightmapMesher::PackedVertex), (void*)offsetof(HeightmapMesher::PackedVertex, height));
+            glEnableVertexAttribArray(5);
+            glVertexAttribPointer(6, 2, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(HeightmapMesher::PackedVertex), (void*)offsetof(HeightmapMesher::PackedVertex, normal));
+            glEnableVertexAttribArray(6);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBOs[1]);
+            if (shortIndices) glBufferData(GL_ELEMENT_ARRAY_BUFFER, stripBytes, shortStrips.data(), GL_STATIC_DRAW);
+            else glBufferData(GL_ELEMENT_ARRAY_BUFFER, stripBytes, longStrips.data(), GL_STATIC_DRAW);
+
+            GLenum stripType = shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+            setUniforms(spawn, 1, resolution, packed.heightMin, packed.heightRange);
+            setUniforms(depth, 1, resolution, packed.heightMin, packed.heightRange);
+            std::vector<float> packedOutputs = capture(spawn, triangles, 8, GL_TRIANGLE_STRIP, static_cast<GLsizei>(stripCount), stripType);
+            std::vector<float> packedDepth = capture(depth, triangles, 4, GL_TRIANGLE_STRIP, static_cast<GLsizei>(stripCount), stripType);
+
+            Difference packedDifference = compare(packedOutputs, meshOutputs, packedDepth, meshDepth);
+
+            //Float Mesh Outputs per Grid Vertex, the Reference the CDLOD Vertices are Interpolated From
+            glBindVertexArray(VAOs[0]);
+            setUniforms(spawn, 0, resolution, 0.0f, 0.0f);
+            GLsizei gridVertices = resolution * resolution;
+            std::vector<float> meshVertices = captureDraw(spawn, static_cast<size_t>(gridVertices), 8, GL_POINTS, [&]() {
+                glDrawArrays(GL_POINTS, 0, gridVertices);
+            });
+
+            //CDLOD Path, w/ the Nodes TerrainLOD::select(...) would Pick for the Chunk at the Origin
+            CDLOD selector(WorldGen::CHUNK_SIZE, LOD_LEAF_RANGE);
+            selector.setTile(glm::ivec2(0, 0), 0, heights.data(), resolution, LOD_BASE_HEIGHT);
+            std::vector<CDLOD::Node> nodes;
+            selector.select(LOD_CAMERA, lodViewProjection, [](const glm::ivec2&) { return true; }, nodes);
+            int levels = 0; //Bit per Level w/ Selected Nodes
+            for (const auto& node : nodes) levels |= 1 << node.level;
+
+            GLuint lodVAO, lodBuffers[3], tiles[2];
+            glGenVertexArrays(1, &lodVAO);
+            glGenBuffers(3, lodBuffers);
+            glGenTextures(2, tiles);
+            GLsizei patchIndices = setupLOD(heights, normals, resolution, nodes, lodVAO, lodBuffers, tiles);
+            GLsizei nodeCount = static_cast<GLsizei>(nodes.size());
+            size_t lodVertices = static_cast<size_t>(patchIndices) * nodes.size();
+
+            setLODUniforms(lod, resolution);
+            setLODUniforms(lodDepth, resolution);
+            auto drawNodes = [&]() { glDrawElementsInstanced(GL_TRIANGLES, patchIndices, GL_UNSIGNED_SHORT, 0, nodeCount); };
+            std::vector<float> lodOutputs = captureDraw(lod, lodVertices, 8, GL_TRIANGLES, drawNodes);
+            std::vector<float> lodDepthOutputs = captureDraw(lodDepth, lodVertices, 4, GL_TRIANGLES, drawNodes);
+
+            Difference lodDifference = compareLOD(lodOutputs, lodDepthOutputs, meshVertices, resolution);
+            bool lodMatches = within(lodDifference, POSITION_TOLERANCE, LOD_NORMAL_TOLERANCE) && (levels & (levels - 1)) != 0;
+
+            //Quantisation Rounds to the Nearest Step, so Half a Step Plus Float Slack
+            float heightStep = packed.heightRange / 65535.0f;
+            bool packedMatches = within(packedDifference, POSITION_TOLERANCE + heightStep * PACKED_HEIGHT_STEPS, PACKED_NORMAL_TOLERANCE);
+            bool clean = glGetError() == GL_NO_ERROR;
+            passed &= packedMatches && lodMatches && clean;
+
+            size_t meshBytes = (mesh.vertices.size() + mesh.normals.size() + mesh.uvs.size()) * sizeof(float) + mesh.indices.size() * sizeof(unsigned int);
+            size_t packedBytes = packed.vertices.size() * sizeof(HeightmapMesher::PackedVertex);
+
+            std::printf("%-8s %-10u %5d %11zu %11s %10s %10s %10s %10s\n", "float", seed, resolution, meshBytes, "-", "-", "-", "-", "-");
+            std::printf("%-8s %-10u %5d %11zu %11zu %10.2e %10.2e %10.2e %10.2e%s\n", "packed", seed, resolution, packedBytes, stripBytes,
+                packedDifference.position, packedDifference.normal, packedDifference.uv, packedDifference.depth, packedMatches && clean ? "" : "  (MISMATCH)");
+            std::printf("%-8s %-10u %5d %11zu %11s %10.2e %10.2e %10.2e %10.2e  %zu nodes%s\n", "cdlod", seed, resolution,
+                static_cast<size_t>(resolution) * resolution * (sizeof(float) + 2 * sizeof(uint16_t)), "-", lodDifference.position, lodDifference.normal, lodDifference.uv,
+                lodDifference.depth, nodes.size(), lodMatches && clean ? "" : "  (MISMATCH)");
+
+            glDeleteVertexArrays(1, &lodVAO);
+            glDeleteBuffers(3, lodBuffers);
+            glDeleteTextures(2, tiles);
+
+            glBindVertexArray(0);
+            glDeleteVertexArrays(2, VAOs);
+            glDeleteBuffers(2, EBOs);
+            glDeleteBuffers(4, VBOs);
+        }
+    }
+
+    std::printf(passed ? "packed and CDLOD paths match the mesh path\n" : "packed or CDLOD path differs from the mesh path\n");
+    return passed ? 0 : 1;
+
+}
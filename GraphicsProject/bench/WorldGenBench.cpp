@@ -0,0 +1,216 @@
+//World Generation Benchmark and Determinism Check
+//Streams Chunks Around Scripted Camera Paths the Way Generator::update Does, Timing Only Content Generation (no GL Context)
+//Every Generated Chunk is Hashed, so an Accidental Change to the Deterministic World Shows up as a Hash Mismatch
+//Heightmaps of Neighbouring Chunks are Also Checked to Share their Border Rows Exactly
+//Usage: worldgen_bench [chunksPerPath]
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "WorldGen.h"
+#include "ChunkTable.h"
+#include "Hash.h"
+#include "AllocationCounter.h"
+
+//Mirrors Generator's Streaming Parameters
+static const int VIEW_DISTANCE = 8;
+static const int UNLOAD_DISTANCE = VIEW_DISTANCE + 2;
+static const float CAMERA_SPEED = 25.0f; //World Units per Frame
+static const int DEFAULT_CHUNKS = 4000;
+static const int MAX_STEPS = 400000;
+
+//Main's Building Weights (Assembled Buildings Need GL to Build, so they're Left Out Here)
+static const std::vector<float> BUILDING_WEIGHTS = { 20.0f, 25.0f, 20.0f, 15.0f, 10.0f, 10.0f };
+
+struct PathResult {
+    size_t chunks = 0;
+    size_t allocations = 0;
+    double generateSeconds = 0.0;
+    std::vector<double> updateMilliseconds;
+    uint64_t contentHash = 0xCBF29CE484222325ull;
+};
+
+//Expected Content Hash per Path. Update Deliberately (w/ a GENERATOR_VERSION Bump) when Generation Rules Change
+struct Golden {
+    const char* path;
+    uint64_t hash;
+};
+
+static const Golden GOLDEN[] = {
+    { "straight", 0xe3c7ac36387af020ull },
+    { "spiral", 0x81fd26da257c345cull },
+    { "random_walk", 0xd5e78c2d45a381d0ull }
+};
+
+//Random Walk State (Heading Drifts a Little Every Frame)
+struct Walker {
+    uint32_t state = 88172645u;
+    float heading = 0.0f;
+    glm::vec2 position = glm::vec2(0.0f);
+};
+
+static glm::vec2 cameraPosition(const std::string& path, int step, Walker& walker) {
+
+    if (path == "straight") {
+        return glm::vec2(step * CAMERA_SPEED, step * CAMERA_SPEED * 0.35f);
+    }
+
+    if (path == "spiral") {
+
+        //Archimedean Spiral Travelled at Constant Speed (Arc Length ~ 0.5 * b * theta^2)
+        const float b = 600.0f;
+        float theta = std::sqrt(2.0f * step * CAMERA_SPEED / b);
+        return glm::vec2(std::cos(theta), std::sin(theta)) * (b * theta);
+
+    }
+
+    walker.state ^= walker.state << 13;
+    walker.state ^= walker.state >> 17;
+    walker.state ^= walker.state << 5;
+    walker.heading += ((walker.state >> 8) * (1.0f / 16777216.0f) - 0.5f) * 0.2f;
+    walker.position += glm::vec2(std::cos(walker.heading), std::sin(walker.heading)) * CAMERA_SPEED;
+    return walker.position;
+
+}
+
+static void hashChunk(const WorldGen::Chunk& chunk, uint64_t& hash) {
+
+    int32_t position[2] = { chunk.position.x, chunk.position.y };
+    hash = hashBytes(position, sizeof(position), hash);
+    hash = hashBytes(&chunk.seed, sizeof(chunk.seed), hash);
+
+    for (const auto& building : chunk.buildings) {
+        float placement[4] = { building.position.x, building.position.y, building.position.z, building.rotation };
+        uint32_t model = static_cast<uint32_t>(building.modelIndex);
+        hash = hashBytes(placement, sizeof(placement), hash);
+        hash = hashBytes(&model, sizeof(model), hash);
+    }
+
+    hash = hashBytes(chunk.heightMap.data(), chunk.heightMap.size() * sizeof(float), hash);
+
+}
+
+static PathResult runPath(const WorldGen& worldGen, const std::string& path, size_t targetChunks) {
+
+    PathResult result;
+    result.updateMilliseconds.reserve(MAX_STEPS);
+
+    ChunkTable<WorldGen::Chunk> chunks((UNLOAD_DISTANCE * 2 + 1) * (UNLOAD_DISTANCE * 2 + 1));
+    glm::ivec2 lastCenter(INT_MIN);
+    Walker walker;
+
+    for (int step = 0; step < MAX_STEPS && result.chunks < targetChunks; step++) {
+        glm::vec2 camera = cameraPosition(path, step, walker);
+        glm::ivec2 center(static_cast<int>(std::floor(camera.x / WorldGen::CHUNK_SIZE)), static_cast<int>(std::floor(camera.y / WorldGen::CHUNK_SIZE)));
+
+        auto updateStart = std::chrono::high_resolution_clock::now();
+
+        //Generate Every Missing Chunk in the View Square, then Unload Beyond the Hysteresis Band
+        for (int x = -VIEW_DISTANCE; x <= VIEW_DISTANCE; x++) {
+            for (int z = -VIEW_DISTANCE; z <= VIEW_DISTANCE; z++) {
+                glm::ivec2 position = center + glm::ivec2(x, z);
+                if (chunks.contains(position)) continue;
+
+                size_t allocationsBefore = AllocationCounter::count();
+                auto start = std::chrono::high_resolution_clock::now();
+                WorldGen::Chunk chunk;
+                worldGen.generate(position, chunk);
+                auto end = std::chrono::high_resolution_clock::now();
+                result.allocations += AllocationCounter::count() - allocationsBefore;
+                result.generateSeconds += std::chrono::duration<double>(end - start).count();
+
+                hashChunk(chunk, result.contentHash);
+                chunks[position] = std::move(chunk);
+                result.chunks++;
+            }
+        }
+
+        if (center != lastCenter) {
+            lastCenter = center;
+            chunks.eraseIf([&center](const glm::ivec2& position, WorldGen::Chunk&) {
+                return std::abs(position.x - center.x) > UNLOAD_DISTANCE || std::abs(position.y - center.y) > UNLOAD_DISTANCE;
+            });
+        }
+
+        auto updateEnd = std::chrono::high_resolution_clock::now();
+        result.updateMilliseconds.push_back(std::chrono::duration<double, std::milli>(updateEnd - updateStart).count());
+    }
+
+    return result;
+
+}
+
+//Generates Heights for Pairs of Neighbouring Chunks (Near and Far from the Origin, Both Signs) and Counts Border Samples that Differ
+static size_t countSeams(uint32_t worldSeed) {
+
+    const glm::ivec2 CHUNKS[] = { glm::ivec2(0, 0), glm::ivec2(-1, -1), glm::ivec2(3, -7), glm::ivec2(-86, 85), glm::ivec2(1000, -2500) };
+    const int RESOLUTIONS[] = { WorldGen::HEIGHTMAP_RESOLUTION, 33 };
+    size_t seams = 0;
+
+    for (int resolution : RESOLUTIONS) {
+        int last = resolution - 1;
+        for (const auto& chunk : CHUNKS) {
+            std::vector<float> here = WorldGen::generateHeightMap(worldSeed, chunk, resolution);
+            std::vector<float> east = WorldGen::generateHeightMap(worldSeed, chunk + glm::ivec2(1, 0), resolution);
+            std::vector<float> north = WorldGen::generateHeightMap(worldSeed, chunk + glm::ivec2(0, 1), resolution);
+
+            for (int i = 0; i < resolution; i++) {
+                if (here[i * resolution + last] != east[i * resolution]) seams++;
+                if (here[last * resolution + i] != north[i]) seams++;
+            }
+        }
+    }
+
+    return seams;
+
+}
+
+static double percentile(std::vector<double> values, double fraction) {
+
+    if (values.empty()) return 0.0;
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+
+}
+
+int main(int argc, char** argv) {
+
+    size_t targetChunks = argc > 1 ? static_cast<size_t>(std::max(1, std::atoi(argv[1]))) : DEFAULT_CHUNKS;
+    WorldGen worldGen(BUILDING_WEIGHTS);
+    bool changed = false;
+
+    std::printf("%-12s %8s %8s %12s %12s %10s %10s  %-18s\n", "path", "chunks", "frames", "chunks/s", "allocs/chunk", "p50 ms", "p99 ms", "content hash");
+
+    for (const auto& golden : GOLDEN) {
+        PathResult result = runPath(worldGen, golden.path, targetChunks);
+
+        double chunksPerSecond = result.generateSeconds > 0.0 ? result.chunks / result.generateSeconds : 0.0;
+        double allocationsPerChunk = result.chunks ? static_cast<double>(result.allocations) / result.chunks : 0.0;
+
+        //Hashes Only Match for the Same Chunk Count, so Compare Against the Golden Value at the Default Count
+        bool comparable = targetChunks == DEFAULT_CHUNKS && golden.hash != 0;
+        bool matches = !comparable || result.contentHash == golden.hash;
+        changed |= !matches;
+
+        std::printf("%-12s %8zu %8zu %12.0f %12.2f %10.3f %10.3f  %016llx%s\n", golden.path, result.chunks, result.updateMilliseconds.size(),
+            chunksPerSecond, allocationsPerChunk, percentile(result.updateMilliseconds, 0.5), percentile(result.updateMilliseconds, 0.99),
+            static_cast<unsigned long long>(result.contentHash), matches ? "" : "  (CHANGED)");
+    }
+
+    if (changed) std::printf("generated content differs from the recorded world\n");
+
+    size_t seams = countSeams(WorldGen::DEFAULT_WORLD_SEED);
+    std::printf("heightmap seams between neighbouring chunks: %zu%s\n", seams, seams ? "  (MISMATCH)" : "");
+
+    return changed || seams ? 1 : 0;
+
+}
@@ -0,0 +1,63 @@
+#include "AliasTable.h"
+
+AliasTable::AliasTable(const std::vector<float>& weights) {
+
+    build(weights);
+
+}
+
+void AliasTable::build(const std::vector<float>& weights) {
+
+    const size_t n = weights.size();
+    probability.assign(n, 1.0f);
+    alias.resize(n);
+
+    if (n == 0) return;
+
+    double total = 0.0;
+    for (float w : weights) {
+        total += w > 0.0f ? w : 0.0f;
+    }
+
+    //Scale Weights so the Average Column Holds Exactly 1, Falling Back to Uniform if All Weights are Zero
+    std::vector<double> scaled(n);
+    for (size_t i = 0; i < n; i++) {
+        scaled[i] = total > 0.0 ? (weights[i] > 0.0f ? weights[i] : 0.0f) * n / total : 1.0;
+        alias[i] = static_cast<uint32_t>(i);
+    }
+
+    //Split Columns into Under and Over Full
+    std::vector<uint32_t> small, large;
+    small.reserve(n);
+    large.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+
+    //Top up Each Under Full Column with the Excess of an Over Full One
+    while (!small.empty() && !large.empty()) {
+        uint32_t s = small.back(); small.pop_back();
+        uint32_t l = large.back(); large.pop_back();
+
+        probability[s] = static_cast<float>(scaled[s]);
+        alias[s] = l;
+
+        scaled[l] = (scaled[l] + scaled[s]) - 1.0;
+        (scaled[l] < 1.0 ? small : large).push_back(l);
+    }
+
+    //Anything Left Over is Full up to Rounding Error
+    for (uint32_t i : large) probability[i] = 1.0f;
+    for (uint32_t i : small) probability[i] = 1.0f;
+
+}
+
+size_t AliasTable::sample(uint64_t random) const {
+
+    //High 32 Bits Pick the Column (Lemire's Multiply-Shift Range Reduction), Low 24 Bits Flip the Biased Coin
+    size_t column = static_cast<size_t>(((random >> 32) * probability.size()) >> 32);
+    float coin = static_cast<float>(random & 0xFFFFFF) * (1.0f / 16777216.0f);
+
+    return coin < probability[column] ? column : alias[column];
+
+}
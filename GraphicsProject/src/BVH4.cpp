@@ -0,0 +1,247 @@
+#include "BVH4.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace {
+
+    BVH4::Box emptyBox() {
+
+        BVH4::Box box;
+        box.min = glm::vec3(FLT_MAX);
+        box.max = glm::vec3(-FLT_MAX);
+        return box;
+
+    }
+
+    void grow(BVH4::Box& box, const BVH4::Box& other) {
+
+        box.min = glm::min(box.min, other.min);
+        box.max = glm::max(box.max, other.max);
+
+    }
+
+    float surfaceArea(const BVH4::Box& box) {
+
+        glm::vec3 extent = glm::max(box.max - box.min, glm::vec3(0.0f));
+        return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+
+    }
+
+}
+
+void BVH4::clear() {
+
+    nodes.clear();
+    primitiveOrder.clear();
+    rootBounds = emptyBox();
+
+}
+
+void BVH4::build(const std::vector<Box>& primitives) {
+
+    clear();
+    if (primitives.empty()) return;
+
+    primitiveOrder.resize(primitives.size());
+    std::vector<glm::vec3> centroids(primitives.size());
+    for (size_t i = 0; i < primitives.size(); i++) {
+        primitiveOrder[i] = static_cast<uint32_t>(i);
+        centroids[i] = (primitives[i].min + primitives[i].max) * 0.5f;
+    }
+
+    std::vector<BinaryNode> binary;
+    binary.reserve(primitives.size() * 2 / LEAF_SIZE + 1);
+    buildBinary(binary, primitives, centroids, 0, static_cast<uint32_t>(primitives.size()), 0);
+    rootBounds = binary[0].bounds;
+
+    //A Lone Leaf Still Needs a Root Node Above it
+    nodes.reserve(binary.size() / 2 + 1);
+    if (binary[0].count > 0) {
+        Node root = {};
+        const Box& box = binary[0].bounds;
+        root.bounds.minX[0] = box.min.x; root.bounds.minY[0] = box.min.y; root.bounds.minZ[0] = box.min.z;
+        root.bounds.maxX[0] = box.max.x; root.bounds.maxY[0] = box.max.y; root.bounds.maxZ[0] = box.max.z;
+        root.first[0] = binary[0].first;
+        root.count[0] = binary[0].count;
+        root.childMask = 1;
+        nodes.push_back(root);
+    }
+    else {
+        collapse(binary, 0);
+    }
+
+}
+
+uint32_t BVH4::buildBinary(std::vector<BinaryNode>& binary, const std::vector<Box>& primitives,
+    const std::vector<glm::vec3>& centroids, uint32_t first, uint32_t count, int depth) {
+
+    uint32_t index = static_cast<uint32_t>(binary.size());
+    binary.emplace_back();
+
+    Box bounds = emptyBox(), centroidBounds = emptyBox();
+    for (uint32_t i = first; i < first + count; i++) {
+        grow(bounds, primitives[primitiveOrder[i]]);
+        centroidBounds.min = glm::min(centroidBounds.min, centroids[primitiveOrder[i]]);
+        centroidBounds.max = glm::max(centroidBounds.max, centroids[primitiveOrder[i]]);
+    }
+
+    BinaryNode node;
+    node.bounds = bounds;
+    node.first = first;
+    node.count = count;
+    node.left = node.right = 0;
+
+    if (count <= LEAF_SIZE || depth >= MAX_DEPTH) {
+        binary[index] = node;
+        return index;
+    }
+
+    //Split Along the Widest Centroid Axis
+    glm::vec3 extent = centroidBounds.max - centroidBounds.min;
+    int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+    uint32_t* begin = primitiveOrder.data() + first;
+    uint32_t* end = begin + count;
+    uint32_t* middle = begin + count / 2;
+
+    if (extent[axis] > 0.0f) {
+
+        //Binned SAH: Bucket Centroids, then Sweep to Find the Cheapest Boundary
+        Box binBounds[SAH_BINS];
+        uint32_t binCounts[SAH_BINS] = {};
+        for (int b = 0; b < SAH_BINS; b++) binBounds[b] = emptyBox();
+
+        float scale = SAH_BINS / extent[axis];
+        auto binOf = [&](uint32_t primitive) {
+            int bin = static_cast<int>((centroids[primitive][axis] - centroidBounds.min[axis]) * scale);
+            return std::min(bin, SAH_BINS - 1);
+        };
+        for (uint32_t* i = begin; i < end; i++) {
+            int bin = binOf(*i);
+            binCounts[bin]++;
+            grow(binBounds[bin], primitives[*i]);
+        }
+
+        float leftArea[SAH_BINS - 1];
+        uint32_t leftCount[SAH_BINS - 1];
+        Box sweep = emptyBox();
+        uint32_t sweepCount = 0;
+        for (int b = 0; b < SAH_BINS - 1; b++) {
+            grow(sweep, binBounds[b]);
+            sweepCount += binCounts[b];
+            leftArea[b] = surfaceArea(sweep);
+            leftCount[b] = sweepCount;
+        }
+
+        float bestCost = FLT_MAX;
+        int bestSplit = -1;
+        sweep = emptyBox();
+        sweepCount = 0;
+        for (int b = SAH_BINS - 1; b > 0; b--) {
+            grow(sweep, binBounds[b]);
+            sweepCount += binCounts[b];
+            if (leftCount[b - 1] == 0 || sweepCount == 0) continue;
+
+            float cost = leftArea[b - 1] * leftCount[b - 1] + surfaceArea(sweep) * sweepCount;
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+
+        //Stop When no Split Beats Testing Every Primitive, Unless the Leaf Would be Too Large
+        if (bestSplit < 0 || (bestCost >= surfaceArea(bounds) * count && count <= MAX_LEAF)) {
+            binary[index] = node;
+            return index;
+        }
+
+        middle = std::partition(begin, end, [&](uint32_t primitive) { return binOf(primitive) < bestSplit; });
+
+    }
+
+    //Coincident Centroids Fall Back to an Even Split
+    if (middle == begin || middle == end) {
+        middle = begin + count / 2;
+        std::nth_element(begin, middle, end, [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+    }
+
+    uint32_t leftCountTotal = static_cast<uint32_t>(middle - begin);
+    node.count = 0;
+    node.left = buildBinary(binary, primitives, centroids, first, leftCountTotal, depth + 1);
+    node.right = buildBinary(binary, primitives, centroids, first + leftCountTotal, count - leftCountTotal, depth + 1);
+    binary[index] = node;
+
+    return index;
+
+}
+
+uint32_t BVH4::collapse(const std::vector<BinaryNode>& binary, uint32_t index) {
+
+    //Open the Largest Inner Grandchild Until Four Children are Gathered
+    uint32_t children[4] = { binary[index].left, binary[index].right, 0, 0 };
+    int childCount = 2;
+    while (childCount < 4) {
+        int largest = -1;
+        float largestArea = -1.0f;
+        for (int i = 0; i < childCount; i++) {
+            const BinaryNode& child = binary[children[i]];
+            if (child.count > 0) continue;
+            float area = surfaceArea(child.bounds);
+            if (area > largestArea) {
+                largestArea = area;
+                largest = i;
+            }
+        }
+        if (largest < 0) break;
+
+        const BinaryNode& opened = binary[children[largest]];
+        children[largest] = opened.left;
+        children[childCount++] = opened.right;
+    }
+
+    uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+
+    Node node = {};
+    node.childMask = (1 << childCount) - 1;
+    for (int i = 0; i < childCount; i++) {
+        const BinaryNode& child = binary[children[i]];
+        node.bounds.minX[i] = child.bounds.min.x; node.bounds.minY[i] = child.bounds.min.y; node.bounds.minZ[i] = child.bounds.min.z;
+        node.bounds.maxX[i] = child.bounds.max.x; node.bounds.maxY[i] = child.bounds.max.y; node.bounds.maxZ[i] = child.bounds.max.z;
+
+        if (child.count > 0) {
+            node.first[i] = child.first;
+            node.count[i] = child.count;
+        }
+        else {
+            node.first[i] = collapse(binary, children[i]);
+            node.count[i] = 0;
+        }
+    }
+    nodes[nodeIndex] = node;
+
+    return nodeIndex;
+
+}
+
+void BVH4::pushOrdered(const Node& node, int mask, const float keys[4], StackEntry* stack, int& top) {
+
+    //Insertion Sort of at Most Four Children by Descending Key
+    int order[4];
+    int hits = 0;
+    for (int i = 0; i < 4; i++) {
+        if (!(mask & (1 << i))) continue;
+        int j = hits++;
+        while (j > 0 && keys[order[j - 1]] < keys[i]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    for (int h = 0; h < hits; h++) {
+        int i = order[h];
+        stack[top++] = { node.first[i], node.count[i], keys[i] };
+    }
+
+}
@@ -1,10 +1,15 @@
 #include "Boid.h"
 
+#include <algorithm>
+
 BoidManager::BoidManager(const std::string& modelPath, Shader& shader) {
     
     //Load Model
     boidModel = std::make_shared<Model>(modelPath);
 
+    //Bounding Radius at the Scale getModelMatrix() Applies, for LOD Selection
+    boidRadius = glm::length(boidModel->boundsMax - boidModel->boundsMin) * 0.5f * 2.0f;
+
     //Instance Buffer
     glGenBuffers(1, &instanceVBO);
     glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
@@ -51,12 +56,27 @@ void BoidManager::initialize(int numBoids, float spawnRadius) {
 
 }
 
-void BoidManager::update(float deltaTime) {
+void BoidManager::update(float deltaTime, const Camera& camera, const HeightField* ground) {
 
     modelMatrices.clear();
     modelMatrices.reserve(boids.size());
+    for (auto& matrices : lodMatrices) {
+        matrices.clear();
+    }
+
+    //Ground Under Every Boid in One Batched Query
+    const float FLAT_GROUND = -50.0f;
+    groundHeights.assign(boids.size(), FLAT_GROUND);
+    if (ground) {
+        groundPoints.resize(boids.size());
+        for (size_t i = 0; i < boids.size(); i++) {
+            groundPoints[i] = glm::vec2(boids[i].position.x, boids[i].position.z);
+        }
+        ground->sampleHeights(groundPoints.data(), groundPoints.size(), groundHeights.data());
+    }
 
-    for (auto& boid : boids) {
+    for (size_t i = 0; i < boids.size(); i++) {
+        Boid& boid = boids[i];
 
         //Calculate and Apply Weighted Forces
         glm::vec3 separation = calculateSeparation(boid) * separationWeight;
@@ -92,9 +112,10 @@ void BoidManager::update(float deltaTime) {
             boid.applyForce(avoidanceForce);
         }
 
-        //Vertical Boundary Forces
-        const float MIN_HEIGHT = 200.0f;
-        const float MAX_HEIGHT = 800.0f;
+        //Vertical Boundary Forces (Band Rises w/ the Ground, Unchanged Over Flat Terrain)
+        float groundRise = std::max(groundHeights[i] - FLAT_GROUND, 0.0f);
+        const float MIN_HEIGHT = 200.0f + groundRise;
+        const float MAX_HEIGHT = 800.0f + groundRise;
         const float HEIGHT_MARGIN = 20.0f;
         const float HEIGHT_FORCE = 1.5f;
 
@@ -112,8 +133,17 @@ void BoidManager::update(float deltaTime) {
 
         //Update Boids with Applied Forces
         boid.update(deltaTime);
-        modelMatrices.push_back(boid.getModelMatrix());
 
+        //Bucket by Projected Size
+        int lod = Mesh::selectLod(camera.screenCoverage(boid.position, boidRadius));
+        lodMatrices[lod].push_back(boid.getModelMatrix());
+
+    }
+
+    //Lay Each LOD's Instances out Contiguously
+    for (int lod = 0; lod < Mesh::LOD_COUNT; lod++) {
+        lodFirstInstance[lod] = modelMatrices.size();
+        modelMatrices.insert(modelMatrices.end(), lodMatrices[lod].begin(), lodMatrices[lod].end());
     }
 
     glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
@@ -126,7 +156,29 @@ void BoidManager::render(Shader& shader) {
     if (modelMatrices.empty()) return;
 
     shader.use();
-    boidModel->render(shader, true, modelMatrices.size());
+
+    //One Instanced Draw per LOD, w/ the Instance Attributes Pointed at that LOD's Range
+    for (int lod = 0; lod < Mesh::LOD_COUNT; lod++) {
+        if (lodMatrices[lod].empty()) continue;
+
+        setInstanceOffset(lodFirstInstance[lod]);
+        boidModel->render(shader, true, lodMatrices[lod].size(), lod);
+    }
+    setInstanceOffset(0);
+
+}
+
+void BoidManager::setInstanceOffset(size_t firstInstance) {
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    for (auto& mesh : boidModel->meshes) {
+        glBindVertexArray(mesh.VAO);
+        for (int i = 0; i < 4; i++) {
+            glVertexAttribPointer(7 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                (void*)(firstInstance * sizeof(glm::mat4) + sizeof(glm::vec4) * i));
+        }
+    }
+    glBindVertexArray(0);
 
 }
 
@@ -254,4 +306,5 @@ BoidManager::~BoidManager() {
         glDeleteBuffers(1, &instanceVBO);
         instanceVBO = 0;
     }
+    boidModel->releaseTextures();
 }
\ No newline at end of file
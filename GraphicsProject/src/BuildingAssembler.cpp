@@ -0,0 +1,292 @@
+#include "BuildingAssembler.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+    const char* PART_FILES[] = {
+        "wall_solid.glb", "wall_doorA.glb", "wall_doorB.glb",
+        "wall_windowA.glb", "wall_windowB.glb", "wall_windowC.glb", "wall_windowD.glb", "wall_windowE.glb", "wall_windowF.glb",
+        "roof_center.glb", "roof_side.glb", "roof_corner.glb",
+        "detail_awning.glb", "sign_billboard.glb"
+    };
+
+    //The Kit's Plain Wall Material, Recoloured per Building
+    const glm::vec3 DEFAULT_WALL_COLOUR = glm::vec3(0.764151f);
+    const glm::vec3 FACADE_TINTS[] = {
+        glm::vec3(0.764151f),
+        glm::vec3(0.85f, 0.78f, 0.66f),
+        glm::vec3(0.72f, 0.45f, 0.38f),
+        glm::vec3(0.55f, 0.62f, 0.70f)
+    };
+
+    //Next Value in [0, range) from a SplitMix64 Stream
+    uint32_t roll(uint64_t& state, uint32_t range) {
+
+        state = splitmix64(state);
+        return static_cast<uint32_t>(state % range);
+
+    }
+
+    //Same Node Walk and Material Colour as Model::processNode(...), Minus Textures and GL Buffers
+    void collectMeshes(const aiNode* node, const aiScene* scene, std::vector<BuildingAssembler::PartMesh>& meshes) {
+
+        for (unsigned int i = 0; i < node->mNumMeshes; i++) {
+            const aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
+            BuildingAssembler::PartMesh part;
+
+            part.positions.reserve(mesh->mNumVertices);
+            part.normals.reserve(mesh->mNumVertices);
+            for (unsigned int v = 0; v < mesh->mNumVertices; v++) {
+                part.positions.push_back(glm::vec3(mesh->mVertices[v].x, mesh->mVertices[v].y, mesh->mVertices[v].z));
+                part.normals.push_back(mesh->HasNormals() ? glm::vec3(mesh->mNormals[v].x, mesh->mNormals[v].y, mesh->mNormals[v].z) : glm::vec3(0.0f));
+            }
+
+            for (unsigned int f = 0; f < mesh->mNumFaces; f++) {
+                const aiFace& face = mesh->mFaces[f];
+                part.indices.insert(part.indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+            }
+
+            const aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
+            aiColor4D colour(1.0f, 1.0f, 1.0f, 1.0f);
+            if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_DIFFUSE, &colour)) part.colour = glm::vec3(colour.r, colour.g, colour.b);
+            else part.colour = material->GetTextureCount(aiTextureType_DIFFUSE) > 0 ? glm::vec3(1.0f) : glm::vec3(0.8f);
+
+            meshes.push_back(std::move(part));
+        }
+
+        for (unsigned int i = 0; i < node->mNumChildren; i++) {
+            collectMeshes(node->mChildren[i], scene, meshes);
+        }
+
+    }
+
+}
+
+BuildingAssembler::BuildingAssembler(const std::string& partsDirectory) {
+
+    static_assert(sizeof(PART_FILES) / sizeof(PART_FILES[0]) == PART_COUNT, "Every part needs a file");
+    static_assert(sizeof(FACADE_TINTS) / sizeof(FACADE_TINTS[0]) == TINT_COUNT, "Every tint needs a colour");
+
+    //Parts are Only Ever Read Here, so they're Loaded CPU Side (No LODs, Buffers or Textures)
+    parts.resize(PART_COUNT);
+    for (int i = 0; i < PART_COUNT; i++) {
+        Assimp::Importer importer;
+        const aiScene* scene = importer.ReadFile(partsDirectory + "/" + PART_FILES[i], aiProcess_Triangulate | aiProcess_GenSmoothNormals);
+
+        if (scene && !(scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) && scene->mRootNode) {
+            collectMeshes(scene->mRootNode, scene, parts[i]);
+        }
+        if (parts[i].empty()) {
+            std::cout << "ERROR::BUILDING_ASSEMBLER:: Missing part " << PART_FILES[i] << std::endl;
+        }
+    }
+
+}
+
+size_t BuildingAssembler::assemble(uint32_t seed) {
+
+    Recipe recipe = design(seed);
+    uint64_t hash = hashRecipe(recipe);
+
+    auto existing = buildingIndex.find(hash);
+    if (existing != buildingIndex.end()) return existing->second;
+
+    size_t index = uniqueBuildings.size();
+    uniqueBuildings.push_back(build(recipe));
+    buildingHashes.push_back(hash);
+    buildingIndex[hash] = index;
+
+    return index;
+
+}
+
+BuildingAssembler::Recipe BuildingAssembler::design(uint32_t seed) const {
+
+    uint64_t state = seed;
+    Recipe recipe;
+
+    int width = MIN_CELLS + static_cast<int>(roll(state, MAX_CELLS - MIN_CELLS + 1));
+    int depth = MIN_CELLS + static_cast<int>(roll(state, MAX_CELLS - MIN_CELLS + 1));
+    int floors = MIN_FLOORS + static_cast<int>(roll(state, MAX_FLOORS - MIN_FLOORS + 1));
+
+    uint32_t door = WALL_DOOR_A + roll(state, 2);
+    uint32_t groundWindow = WALL_WINDOW_A + roll(state, 6);
+    uint32_t upperWindow = WALL_WINDOW_A + roll(state, 6);
+    bool banded = roll(state, 3) == 0; //Every Other Upper Floor is Solid
+    int doorCell = static_cast<int>(roll(state, width));
+    bool awnings = roll(state, 2) == 0;
+    bool billboard = floors <= 4 && roll(state, 4) == 0;
+    recipe.tint = roll(state, TINT_COUNT);
+
+    //Walls: Door and Shopfront at Ground Level on the Front (+z), Blank Back, Windows Everywhere Else
+    for (int floor = 0; floor < floors; floor++) {
+        for (uint32_t face = 0; face < 4; face++) {
+            int cells = face % 2 == 0 ? width : depth;
+            for (int cell = 0; cell < cells; cell++) {
+                int along = 2 * cell - (cells - 1);
+
+                Placement wall;
+                wall.y = 2 * floor;
+                wall.quarterTurns = face;
+                switch (face) {
+                    case 0: wall.x = along;  wall.z = depth;  break;
+                    case 1: wall.x = width;  wall.z = -along; break;
+                    case 2: wall.x = -along; wall.z = -depth; break;
+                    default: wall.x = -width; wall.z = along; break;
+                }
+
+                if (floor == 0) {
+                    if (face == 0 && cell == doorCell) wall.part = door;
+                    else if (face == 2) wall.part = WALL_SOLID;
+                    else wall.part = groundWindow;
+                }
+                else {
+                    wall.part = banded && floor % 2 == 0 ? static_cast<uint32_t>(WALL_SOLID) : upperWindow;
+                }
+                recipe.placements.push_back(wall);
+
+                if (floor == 0 && face == 0 && awnings) {
+                    Placement awning = wall;
+                    awning.part = DETAIL_AWNING;
+                    recipe.placements.push_back(awning);
+                }
+            }
+        }
+    }
+
+    //Roof: Corner Tiles Cover Faces k and k - 1 at k Quarter Turns, Side Tiles Face Outwards, Centre Tiles Fill the Rest
+    for (int i = 0; i < width; i++) {
+        for (int j = 0; j < depth; j++) {
+            bool edge[4] = { j == depth - 1, i == width - 1, j == 0, i == 0 };
+
+            Placement tile;
+            tile.x = 2 * i - (width - 1);
+            tile.y = 2 * floors;
+            tile.z = 2 * j - (depth - 1);
+            tile.part = ROOF_CENTER;
+            tile.quarterTurns = 0;
+
+            for (uint32_t face = 0; face < 4; face++) {
+                if (!edge[face]) continue;
+                uint32_t previous = (face + 3) % 4;
+                if (edge[previous]) {
+                    tile.part = ROOF_CORNER;
+                    tile.quarterTurns = face;
+                    break;
+                }
+                tile.part = ROOF_SIDE;
+                tile.quarterTurns = face;
+            }
+            recipe.placements.push_back(tile);
+        }
+    }
+
+    if (billboard) {
+        Placement sign;
+        sign.part = SIGN_BILLBOARD;
+        sign.x = 0;
+        sign.y = 2 * floors;
+        sign.z = 0;
+        sign.quarterTurns = 1;
+        recipe.placements.push_back(sign);
+    }
+
+    return recipe;
+
+}
+
+uint64_t BuildingAssembler::hashRecipe(const Recipe& recipe) const {
+
+    //Placements are Plain Integers, so Hashing the Bytes is Exact and Platform Independent
+    uint64_t hash = hashBytes(recipe.placements.data(), recipe.placements.size() * sizeof(Placement));
+    return hashBytes(&recipe.tint, sizeof(recipe.tint), hash);
+
+}
+
+std::shared_ptr<Model> BuildingAssembler::build(const Recipe& recipe) const {
+
+    //One Bucket per Material Colour, Vertices Welded on Quantised Position and Normal
+    struct Bucket {
+        glm::vec3 colour;
+        vector<Vertex> vertices;
+        vector<unsigned int> indices;
+        std::unordered_map<uint64_t, unsigned int> welded;
+    };
+    std::vector<Bucket> buckets;
+
+    float halfCell = CELL_SIZE * 0.5f;
+    for (const auto& placement : recipe.placements) {
+        if (parts[placement.part].empty()) continue;
+
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), glm::vec3(placement.x, placement.y, placement.z) * halfCell);
+        transform = glm::rotate(transform, glm::radians(90.0f * placement.quarterTurns), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat3 rotation = glm::mat3(transform);
+
+        for (const auto& mesh : parts[placement.part]) {
+            glm::vec3 colour = mesh.colour;
+            if (glm::all(glm::lessThan(glm::abs(colour - DEFAULT_WALL_COLOUR), glm::vec3(0.01f)))) {
+                colour = FACADE_TINTS[recipe.tint];
+            }
+
+            size_t b = 0;
+            while (b < buckets.size() && buckets[b].colour != colour) b++;
+            if (b == buckets.size()) {
+                buckets.emplace_back();
+                buckets.back().colour = colour;
+            }
+            Bucket& bucket = buckets[b];
+
+            std::vector<unsigned int> remap(mesh.positions.size());
+            for (size_t v = 0; v < mesh.positions.size(); v++) {
+                Vertex vertex = {};
+                vertex.Position = glm::vec3(transform * glm::vec4(mesh.positions[v], 1.0f));
+                vertex.Normal = rotation * mesh.normals[v];
+
+                //Shared Edges Between Neighbouring Parts Collapse to One Vertex Where their Normals Agree
+                int32_t key[6] = {
+                    static_cast<int32_t>(std::lround(vertex.Position.x * 10000.0f)),
+                    static_cast<int32_t>(std::lround(vertex.Position.y * 10000.0f)),
+                    static_cast<int32_t>(std::lround(vertex.Position.z * 10000.0f)),
+                    static_cast<int32_t>(std::lround(vertex.Normal.x * 64.0f)),
+                    static_cast<int32_t>(std::lround(vertex.Normal.y * 64.0f)),
+                    static_cast<int32_t>(std::lround(vertex.Normal.z * 64.0f))
+                };
+                uint64_t hash = hashBytes(key, sizeof(key));
+
+                auto found = bucket.welded.find(hash);
+                if (found != bucket.welded.end()) {
+                    remap[v] = found->second;
+                }
+                else {
+                    remap[v] = static_cast<unsigned int>(bucket.vertices.size());
+                    bucket.welded[hash] = remap[v];
+                    bucket.vertices.push_back(vertex);
+                }
+            }
+
+            //Welding can Collapse Sliver Triangles, so Drop any that Became Degenerate
+            for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+                unsigned int a = remap[mesh.indices[i]], c = remap[mesh.indices[i + 1]], d = remap[mesh.indices[i + 2]];
+                if (a == c || c == d || a == d) continue;
+                bucket.indices.push_back(a);
+                bucket.indices.push_back(c);
+                bucket.indices.push_back(d);
+            }
+        }
+    }
+
+    vector<Mesh> meshes;
+    for (auto& bucket : buckets) {
+        if (bucket.indices.empty()) continue;
+        meshes.emplace_back(std::move(bucket.vertices), std::move(bucket.indices), vector<Texture>(), bucket.colour);
+    }
+
+    return std::make_shared<Model>(std::move(meshes));
+
+}
@@ -0,0 +1,225 @@
+#include "BuildingBatch.h"
+
+#include <GLFW/glfw3.h>
+#include <algorithm>
+
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+BuildingBatch::BuildingBatch(const std::vector<std::shared_ptr<Model>>& models, size_t maxInstances)
+    : maxInstances(maxInstances) {
+
+    std::vector<BatchVertex> vertices;
+    std::vector<GLuint> indices;
+
+    //Append Every Model into the Arena as One Range per LOD: Colour is Per Vertex, so a Model's Meshes Merge into a
+    //Single Vertex Range, and Each LOD's Indices from Every Mesh are Laid Out Back to Back
+    modelRanges.resize(models.size());
+    for (size_t i = 0; i < models.size(); i++) {
+        MeshRange& range = modelRanges[i];
+        range.baseVertex = static_cast<GLint>(vertices.size());
+
+        for (const auto& mesh : models[i]->meshes) {
+            for (const auto& vertex : mesh.vertices) {
+                BatchVertex batchVertex;
+                batchVertex.Position = vertex.Position;
+                batchVertex.Normal = vertex.Normal;
+                batchVertex.Colour = mesh.diffuseColor;
+                vertices.push_back(batchVertex);
+            }
+        }
+
+        for (int lod = 0; lod < Mesh::LOD_COUNT; lod++) {
+            range.firstIndex[lod] = static_cast<GLuint>(indices.size());
+
+            GLuint meshBase = 0; //Mesh's First Vertex Relative to the Model's Range
+            for (const auto& mesh : models[i]->meshes) {
+                const unsigned int* source = mesh.lodFirstIndex[lod] < mesh.indices.size()
+                    ? mesh.indices.data() + mesh.lodFirstIndex[lod]
+                    : mesh.lodIndices.data() + (mesh.lodFirstIndex[lod] - mesh.indices.size());
+                for (unsigned int j = 0; j < mesh.lodIndexCount[lod]; j++) {
+                    indices.push_back(source[j] + meshBase);
+                }
+                meshBase += static_cast<GLuint>(mesh.vertices.size());
+            }
+
+            range.indexCount[lod] = static_cast<GLuint>(indices.size()) - range.firstIndex[lod];
+        }
+    }
+
+    packedMatrices.reserve(maxInstances);
+    baseInstances.resize(models.size() * Mesh::LOD_COUNT);
+    commands.reserve(models.size() * Mesh::LOD_COUNT);
+
+    //Buffer Setup
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+    glGenBuffers(1, &instanceVBO);
+
+    glBindVertexArray(VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(BatchVertex), vertices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)offsetof(BatchVertex, Position));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)offsetof(BatchVertex, Normal));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)offsetof(BatchVertex, Colour));
+
+    //Instance Matrices for all Models Share One Buffer, Each Model Owning a Contiguous Range
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, maxInstances * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+
+    for (int j = 0; j < 4; j++) {
+        glEnableVertexAttribArray(7 + j);
+        glVertexAttribPointer(7 + j, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * j));
+        glVertexAttribDivisor(7 + j, 1);
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    //Buffer Setup
+
+    loadIndirectSupport();
+
+}
+
+void BuildingBatch::loadIndirectSupport() {
+
+    //glad is Generated for GL 3.3, so the 4.3 Entry Point is Fetched by Hand When the Context Supports it
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+    if (major > 4 || (major == 4 && minor >= 3)) {
+        multiDrawElementsIndirect = reinterpret_cast<MultiDrawElementsIndirectProc>(glfwGetProcAddress("glMultiDrawElementsIndirect"));
+    }
+
+    if (!multiDrawElementsIndirect) return;
+
+    glGenBuffers(1, &indirectBuffer);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, modelRanges.size() * Mesh::LOD_COUNT * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+}
+
+void BuildingBatch::setInstanceOffset(size_t firstInstance) {
+
+    //GL 3.3 has no baseInstance, so Point the Instance Attributes at the Start of the Model's Range Instead
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    for (int j = 0; j < 4; j++) {
+        glVertexAttribPointer(7 + j, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+            (void*)(firstInstance * sizeof(glm::mat4) + sizeof(glm::vec4) * j));
+    }
+
+}
+
+void BuildingBatch::render(Shader& shader, const std::vector<std::vector<glm::mat4>>& modelMatrices) {
+
+    //Pack Each (Model, LOD) Group's Instances Contiguously
+    size_t groups = baseInstances.size();
+    packedMatrices.clear();
+    for (size_t i = 0; i < groups; i++) {
+        baseInstances[i] = static_cast<GLuint>(packedMatrices.size());
+
+        size_t count = i < modelMatrices.size() ? modelMatrices[i].size() : 0;
+        count = std::min(count, maxInstances - packedMatrices.size());
+        if (count > 0) {
+            packedMatrices.insert(packedMatrices.end(), modelMatrices[i].begin(), modelMatrices[i].begin() + count);
+        }
+    }
+
+    if (packedMatrices.empty()) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, packedMatrices.size() * sizeof(glm::mat4), packedMatrices.data());
+
+    shader.use();
+    shader.setInt("useTexture", 3);
+
+    glBindVertexArray(VAO);
+
+    if (multiDrawElementsIndirect) {
+
+        //One Command per (Model, LOD) Group, Instanced over its Range
+        commands.clear();
+        for (size_t i = 0; i < groups; i++) {
+            GLuint end = i + 1 < groups ? baseInstances[i + 1] : static_cast<GLuint>(packedMatrices.size());
+            GLuint instanceCount = end - baseInstances[i];
+            if (instanceCount == 0) continue;
+
+            int lod = static_cast<int>(i % Mesh::LOD_COUNT);
+            const MeshRange& range = modelRanges[i / Mesh::LOD_COUNT];
+            DrawElementsIndirectCommand command;
+            command.count = range.indexCount[lod];
+            command.instanceCount = instanceCount;
+            command.firstIndex = range.firstIndex[lod];
+            command.baseVertex = range.baseVertex;
+            command.baseInstance = baseInstances[i];
+            commands.push_back(command);
+        }
+
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data());
+        multiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(commands.size()), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    }
+    else {
+
+        //GL 3.3 Fallback: Still One Shared VAO and One Draw per (Model, LOD) Group
+        for (size_t i = 0; i < groups; i++) {
+            GLuint end = i + 1 < groups ? baseInstances[i + 1] : static_cast<GLuint>(packedMatrices.size());
+            GLuint instanceCount = end - baseInstances[i];
+            if (instanceCount == 0) continue;
+
+            int lod = static_cast<int>(i % Mesh::LOD_COUNT);
+            const MeshRange& range = modelRanges[i / Mesh::LOD_COUNT];
+            setInstanceOffset(baseInstances[i]);
+            glDrawElementsInstancedBaseVertex(GL_TRIANGLES, range.indexCount[lod], GL_UNSIGNED_INT,
+                (void*)(range.firstIndex[lod] * sizeof(GLuint)), instanceCount, range.baseVertex);
+        }
+        setInstanceOffset(0);
+
+    }
+
+    glBindVertexArray(0);
+    shader.setInt("useTexture", 0);
+
+}
+
+void BuildingBatch::renderModel(size_t modelIndex, const glm::mat4& transform) {
+
+    if (modelIndex >= modelRanges.size()) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(glm::mat4), &transform);
+
+    const MeshRange& range = modelRanges[modelIndex];
+    glBindVertexArray(VAO);
+    glDrawElementsInstancedBaseVertex(GL_TRIANGLES, range.indexCount[0], GL_UNSIGNED_INT,
+        (void*)(range.firstIndex[0] * sizeof(GLuint)), 1, range.baseVertex);
+    glBindVertexArray(0);
+
+}
+
+BuildingBatch::~BuildingBatch() {
+
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+    glDeleteBuffers(1, &instanceVBO);
+    if (indirectBuffer) glDeleteBuffers(1, &indirectBuffer);
+
+}
@@ -0,0 +1,234 @@
+#include "CDLOD.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+
+    bool sphereIntersectsBox(const glm::vec3& centre, float radius, const glm::vec3& boxMin, const glm::vec3& boxMax) {
+
+        glm::vec3 closest = glm::clamp(centre, boxMin, boxMax);
+        glm::vec3 offset = closest - centre;
+        return glm::dot(offset, offset) <= radius * radius;
+
+    }
+
+    //Attrib: Gribb & Hartmann, Fast Extraction of Viewing Frustum Planes from the World-View-Projection Matrix
+    void frustumPlanes(const glm::mat4& m, glm::vec4 planes[6]) {
+
+        glm::vec4 rows[4];
+        for (int i = 0; i < 4; i++) rows[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+
+        for (int i = 0; i < 3; i++) {
+            planes[i * 2] = rows[3] + rows[i];
+            planes[i * 2 + 1] = rows[3] - rows[i];
+        }
+
+    }
+
+    //Outside if the Box's Most Positive Corner is Behind Any Plane
+    bool boxInFrustum(const glm::vec4 planes[6], const glm::vec3& boxMin, const glm::vec3& boxMax) {
+
+        for (int i = 0; i < 6; i++) {
+            glm::vec3 corner(planes[i].x >= 0.0f ? boxMax.x : boxMin.x, planes[i].y >= 0.0f ? boxMax.y : boxMin.y, planes[i].z >= 0.0f ? boxMax.z : boxMin.z);
+            if (glm::dot(glm::vec3(planes[i]), corner) + planes[i].w < 0.0f) return false;
+        }
+
+        return true;
+
+    }
+
+}
+
+CDLOD::CDLOD(float chunkSize, float leafRange) : chunkSize(chunkSize) {
+
+    for (int level = 0; level < LEVELS; level++) {
+        ranges[level] = leafRange * static_cast<float>(1 << level);
+    }
+
+}
+
+glm::vec2 CDLOD::morphRange(int level) const {
+
+    float previous = level > 0 ? ranges[level - 1] : 0.0f;
+    float end = ranges[level];
+    return glm::vec2(previous + (end - previous) * MORPH_START, end);
+
+}
+
+int CDLOD::patchQuadsFor(int tileResolution) {
+
+    //Leaves Split a Chunk 2^(LEVELS - 1) Ways per Side, and the Tile's Samples Split it (tileResolution - 1) Ways
+    float leafSamples = static_cast<float>(tileResolution - 1) / static_cast<float>(1 << (LEVELS - 1));
+    int quads = 2 * static_cast<int>(std::lround(leafSamples * 0.5f));
+    return std::min(std::max(quads, 2), 254);
+
+}
+
+void CDLOD::tileTexels(const float* heights, const float* normals, int resolution, float chunkSize, std::vector<float>& texels,
+    std::vector<float>& slopes) {
+
+    texels.assign(heights, heights + static_cast<size_t>(resolution) * resolution);
+    for (int i = 0; i < resolution; i++) {
+        texels[i] = 0.0f;
+        texels[(resolution - 1) * resolution + i] = 0.0f;
+        texels[i * resolution] = 0.0f;
+        texels[i * resolution + resolution - 1] = 0.0f;
+    }
+
+    //Interior Slopes Match the Spawn Chunk Mesh's Normals, so Central Differences Read the Unflattened Heights
+    slopes.assign(static_cast<size_t>(resolution) * resolution * 2, 0.0f);
+    float spacing = chunkSize / (resolution - 1);
+    for (int z = 1; z < resolution - 1; z++) {
+        for (int x = 1; x < resolution - 1; x++) {
+            size_t sample = static_cast<size_t>(z) * resolution + x;
+            if (normals) {
+                slopes[sample * 2] = -normals[sample * 3] / normals[sample * 3 + 1];
+                slopes[sample * 2 + 1] = -normals[sample * 3 + 2] / normals[sample * 3 + 1];
+            }
+            else {
+                slopes[sample * 2] = (heights[sample + 1] - heights[sample - 1]) / (2.0f * spacing);
+                slopes[sample * 2 + 1] = (heights[sample + resolution] - heights[sample - resolution]) / (2.0f * spacing);
+            }
+        }
+    }
+
+}
+
+void CDLOD::setTile(const glm::ivec2& chunk, uint32_t tile, const float* heights, int resolution, float baseHeight) {
+
+    uint32_t* existing = tileIndex.find(chunk);
+    uint32_t slot = existing ? *existing : static_cast<uint32_t>(tiles.size());
+    if (!existing) {
+        tiles.emplace_back();
+        tileIndex[chunk] = slot;
+    }
+
+    Tile& entry = tiles[slot];
+    entry.chunk = chunk;
+    entry.tile = tile;
+
+    //Min/Max over the Samples Each Node Covers (Inclusive of its Edges, so Bilinear Heights Between Samples Stay Inside)
+    float spacing = chunkSize / (resolution - 1);
+    for (int level = 0; level < LEVELS; level++) {
+        int nodes = 1 << (LEVELS - 1 - level);
+        float size = nodeSize(level);
+        entry.heightRange[level].assign(nodes * nodes, glm::vec2(FLT_MAX, -FLT_MAX));
+
+        for (int z = 0; z < nodes; z++) {
+            for (int x = 0; x < nodes; x++) {
+                int x0 = std::max(0, static_cast<int>(std::floor(x * size / spacing)));
+                int x1 = std::min(resolution - 1, static_cast<int>(std::ceil((x + 1) * size / spacing)));
+                int z0 = std::max(0, static_cast<int>(std::floor(z * size / spacing)));
+                int z1 = std::min(resolution - 1, static_cast<int>(std::ceil((z + 1) * size / spacing)));
+
+                glm::vec2& range = entry.heightRange[level][z * nodes + x];
+                for (int sz = z0; sz <= z1; sz++) {
+                    for (int sx = x0; sx <= x1; sx++) {
+                        bool isEdge = sx == 0 || sx == resolution - 1 || sz == 0 || sz == resolution - 1;
+                        float height = (isEdge ? 0.0f : heights[sz * resolution + sx]) + baseHeight;
+                        range.x = std::min(range.x, height);
+                        range.y = std::max(range.y, height);
+                    }
+                }
+            }
+        }
+    }
+
+}
+
+void CDLOD::removeTile(const glm::ivec2& chunk) {
+
+    uint32_t* found = tileIndex.find(chunk);
+    if (!found) return;
+
+    //Swap the Last Tile into the Hole
+    uint32_t slot = *found;
+    tileIndex.erase(chunk);
+    if (slot + 1 != tiles.size()) {
+        tiles[slot] = std::move(tiles.back());
+        tileIndex[tiles[slot].chunk] = slot;
+    }
+    tiles.pop_back();
+
+}
+
+void CDLOD::nodeBounds(const Tile& tile, int level, int x, int z, glm::vec3& boxMin, glm::vec3& boxMax) const {
+
+    //Chunks are Centred on chunk * chunkSize
+    float size = nodeSize(level);
+    glm::vec2 chunkMin = glm::vec2(tile.chunk) * chunkSize - glm::vec2(chunkSize * 0.5f);
+    glm::vec2 origin = chunkMin + glm::vec2(x, z) * size;
+    const glm::vec2& heights = tile.heightRange[level][z * (1 << (LEVELS - 1 - level)) + x];
+
+    boxMin = glm::vec3(origin.x, heights.x, origin.y);
+    boxMax = glm::vec3(origin.x + size, heights.y, origin.y + size);
+
+}
+
+void CDLOD::addNode(const Tile& tile, int level, int x, int z, std::vector<Node>& nodes) const {
+
+    glm::vec3 boxMin, boxMax;
+    nodeBounds(tile, level, x, z, boxMin, boxMax);
+
+    Node node;
+    node.origin = glm::vec2(boxMin.x, boxMin.z);
+    node.size = nodeSize(level);
+    node.level = level;
+    node.chunk = tile.chunk;
+    node.tile = tile.tile;
+    node.boundsMin = boxMin;
+    node.boundsMax = boxMax;
+    nodes.push_back(node);
+
+}
+
+//False if the Node is Beyond its Level's Range, in which Case the Parent Covers it (Fully Morphed to the Parent's Grid)
+bool CDLOD::selectNode(const Tile& tile, int level, int x, int z, const glm::vec3& camera, std::vector<Node>& nodes) const {
+
+    glm::vec3 boxMin, boxMax;
+    nodeBounds(tile, level, x, z, boxMin, boxMax);
+    if (!sphereIntersectsBox(camera, ranges[level], boxMin, boxMax)) return false;
+
+    //Finest Level, or No Part of the Node Needs the Next Finer Level
+    if (level == 0 || !sphereIntersectsBox(camera, ranges[level - 1], boxMin, boxMax)) {
+        addNode(tile, level, x, z, nodes);
+        return true;
+    }
+
+    for (int child = 0; child < 4; child++) {
+        int childX = x * 2 + (child & 1);
+        int childZ = z * 2 + (child >> 1);
+        if (!selectNode(tile, level - 1, childX, childZ, camera, nodes)) {
+            addNode(tile, level - 1, childX, childZ, nodes);
+        }
+    }
+
+    return true;
+
+}
+
+size_t CDLOD::select(const glm::vec3& camera, const glm::mat4& viewProjection, const std::function<bool(const glm::ivec2&)>& include,
+    std::vector<Node>& nodes) const {
+
+    nodes.clear();
+    for (const auto& tile : tiles) {
+        if (!include(tile.chunk)) continue;
+
+        //Chunks Beyond the Coarsest Range are Still Drawn, as a Single Fully Morphed Node
+        if (!selectNode(tile, LEVELS - 1, 0, 0, camera, nodes)) {
+            addNode(tile, LEVELS - 1, 0, 0, nodes);
+        }
+    }
+
+    glm::vec4 planes[6];
+    frustumPlanes(viewProjection, planes);
+
+    auto inside = std::stable_partition(nodes.begin(), nodes.end(), [&planes](const Node& node) {
+        return boxInFrustum(planes, node.boundsMin, node.boundsMax);
+    });
+
+    return static_cast<size_t>(inside - nodes.begin());
+
+}
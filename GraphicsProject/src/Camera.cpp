@@ -1,5 +1,7 @@
 #include "Camera.h"
 
+#include <cmath>
+
 //Attrib: Adapted from LearnOpenGL Camera Class Template, with Alterations to Produce Projection Matrices, and Handle Speed Up and Down
 Camera::Camera(glm::vec3 position, float near, float far, unsigned int height, unsigned int width, glm::vec3 up, float yaw, float pitch)
     : Front(glm::vec3(0.0f, 0.0f, -1.0f)), MovementSpeed(SPEED), MouseSensitivity(SENSITIVITY), Zoom(ZOOM) {
@@ -16,13 +18,21 @@ Camera::Camera(glm::vec3 position, float near, float far, unsigned int height, u
 
 }
 
-glm::mat4 Camera::projectionMatrix() {
+glm::mat4 Camera::projectionMatrix() const {
 
     return glm::perspective(glm::radians(Zoom), (float)screenWidth / (float)screenHeight, zNear, zFar);
 
 }
 
-glm::mat4 Camera::viewMatrix() {
+float Camera::screenCoverage(const glm::vec3& centre, float radius) const {
+
+    float distance = glm::length(centre - Position);
+    if (distance <= radius) return 1.0f;
+    return radius / (distance * std::tan(glm::radians(Zoom) * 0.5f));
+
+}
+
+glm::mat4 Camera::viewMatrix() const {
 
     return glm::lookAt(Position, Position + Front, Up);
 
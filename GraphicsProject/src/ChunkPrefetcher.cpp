@@ -0,0 +1,99 @@
+#include "ChunkPrefetcher.h"
+
+#include <algorithm>
+#include <cmath>
+
+ChunkPrefetcher::ChunkPrefetcher(float chunkSize, int viewDistance, int reach, float horizon)
+    : chunkSize(chunkSize), viewDistance(viewDistance), reach(reach), horizon(horizon), lastPosition(0.0f) {
+}
+
+void ChunkPrefetcher::observe(const glm::vec3& position) {
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+    if (hasSample) {
+        float elapsed = std::chrono::duration<float>(now - lastSample).count();
+
+        //Skip Degenerate Samples (Two Updates in the Same Tick)
+        if (elapsed > 1e-4f) {
+            glm::vec3 sample = (position - lastPosition) / elapsed;
+            velocity = glm::mix(velocity, sample, VELOCITY_SMOOTHING);
+        }
+    }
+
+    lastPosition = position;
+    lastSample = now;
+    hasSample = true;
+
+}
+
+void ChunkPrefetcher::plan(const glm::ivec2& centerChunk) {
+
+    queue = std::priority_queue<Request, std::vector<Request>, LaterFirst>();
+    arrivals.clear();
+
+    //Only Horizontal Motion Moves the View Square
+    glm::vec2 planar(velocity.x, velocity.z);
+    float speed = glm::length(planar);
+    if (speed < MIN_SPEED || horizon <= 0.0f) return;
+
+    glm::vec2 direction = planar / speed;
+    glm::vec2 origin(lastPosition.x, lastPosition.z);
+
+    //Step Half a Chunk at a Time so No Center Chunk Along the Path is Skipped
+    float step = chunkSize * 0.5f / speed;
+    int steps = static_cast<int>(std::ceil(horizon / step));
+
+    for (int i = 1; i <= steps; i++) {
+        float t = std::min(i * step, horizon);
+        glm::vec2 predicted = origin + planar * t;
+        glm::ivec2 predictedCenter(
+            static_cast<int>(std::floor(predicted.x / chunkSize)),
+            static_cast<int>(std::floor(predicted.y / chunkSize)));
+
+        if (predictedCenter == centerChunk) continue;
+
+        //The Path Only Moves Away from Here, so Once a Whole View Square is Past reach Nothing Later Can Qualify
+        glm::ivec2 travelled = predictedCenter - centerChunk;
+        if (std::max(std::abs(travelled.x), std::abs(travelled.y)) - viewDistance > reach) break;
+
+        for (int x = -viewDistance; x <= viewDistance; x++) {
+            for (int z = -viewDistance; z <= viewDistance; z++) {
+                glm::ivec2 position = predictedCenter + glm::ivec2(x, z);
+
+                //Already Inside the Current View Square, so Loaded by the Regular Path
+                glm::ivec2 offset = position - centerChunk;
+                if (std::abs(offset.x) <= viewDistance && std::abs(offset.y) <= viewDistance) continue;
+
+                //Too Far to be Kept when its Job Runs
+                if (std::abs(offset.x) > reach || std::abs(offset.y) > reach) continue;
+
+                //Samples are in Time Order, so the First Sighting is the Earliest Arrival
+                if (arrivals.contains(position)) continue;
+                arrivals[position] = t;
+
+                //Chunks the Camera is Heading Straight at Outrank Ones it Only Clips the Edge of
+                glm::vec2 toChunk = (glm::vec2(position) + 0.5f) * chunkSize - origin;
+                float distance = glm::length(toChunk);
+                float alignment = distance > 0.0f ? glm::dot(toChunk / distance, direction) : 1.0f;
+
+                Request request;
+                request.position = position;
+                request.arrivalTime = t;
+                request.priority = t + (1.0f - alignment) * 0.5f * DIRECTION_PENALTY;
+                queue.push(request);
+            }
+        }
+    }
+
+}
+
+bool ChunkPrefetcher::next(Request& request) {
+
+    if (queue.empty()) return false;
+
+    request = queue.top();
+    queue.pop();
+    return true;
+
+}
@@ -0,0 +1,180 @@
+#include "ChunkStore.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+static const char REGION_MAGIC[4] = { 'G', 'P', 'C', 'R' };
+
+ChunkStore::ChunkStore(const std::string& directory, uint32_t contentSignature)
+    : directory(directory), signature(contentSignature) {
+
+    createDirectories(directory);
+
+}
+
+glm::ivec2 ChunkStore::regionCoords(const glm::ivec2& position) const {
+
+    //Floor Division so Negative Chunks Land in the Correct Region
+    return glm::ivec2(
+        position.x >= 0 ? position.x / REGION_SIZE : (position.x - REGION_SIZE + 1) / REGION_SIZE,
+        position.y >= 0 ? position.y / REGION_SIZE : (position.y - REGION_SIZE + 1) / REGION_SIZE
+    );
+
+}
+
+int ChunkStore::slotIndex(const glm::ivec2& position) const {
+
+    glm::ivec2 local = position - regionCoords(position) * REGION_SIZE;
+    return local.y * REGION_SIZE + local.x;
+
+}
+
+std::string ChunkStore::regionPath(const glm::ivec2& region) const {
+
+    return directory + "/r." + std::to_string(region.x) + "." + std::to_string(region.y) + ".gpr";
+
+}
+
+ChunkStore::Region& ChunkStore::getRegion(const glm::ivec2& region) {
+
+    std::unique_ptr<Region>& entry = regions[region];
+    if (!entry) entry.reset(new Region());
+    return *entry;
+
+}
+
+const ChunkStore::RegionHeader* ChunkStore::mapRegion(const glm::ivec2& region) {
+
+    Region& entry = getRegion(region);
+
+    if (!entry.checked) {
+        entry.checked = true;
+        entry.valid = false;
+
+        if (entry.file.open(regionPath(region)) && entry.file.size() >= sizeof(RegionHeader)) {
+            const RegionHeader* header = reinterpret_cast<const RegionHeader*>(entry.file.data());
+            entry.valid = std::memcmp(header->magic, REGION_MAGIC, 4) == 0 &&
+                header->version == FORMAT_VERSION &&
+                header->signature == signature &&
+                header->regionX == region.x && header->regionZ == region.y;
+        }
+    }
+
+    return entry.valid ? reinterpret_cast<const RegionHeader*>(entry.file.data()) : nullptr;
+
+}
+
+bool ChunkStore::load(const glm::ivec2& position, ChunkView& view) {
+
+    const RegionHeader* header = mapRegion(regionCoords(position));
+    if (!header) return false;
+
+    const ChunkSlot& slot = header->slots[slotIndex(position)];
+    size_t fileSize = getRegion(regionCoords(position)).file.size();
+
+    if (slot.size < sizeof(ChunkHeader) || static_cast<size_t>(slot.offset) + slot.size > fileSize) return false;
+
+    const unsigned char* blob = reinterpret_cast<const unsigned char*>(header) + slot.offset;
+    const ChunkHeader* chunk = reinterpret_cast<const ChunkHeader*>(blob);
+
+    //Reject Blobs Whose Counts Don't Fit Inside their Slot
+    size_t heightCount = static_cast<size_t>(chunk->heightResolution) * chunk->heightResolution;
+    size_t expected = sizeof(ChunkHeader) +
+        static_cast<size_t>(chunk->buildingCount) * sizeof(BuildingRecord) +
+        heightCount * (chunk->hasNormals ? 4 : 1) * sizeof(float);
+
+    if (expected > slot.size || chunk->x != position.x || chunk->z != position.y) return false;
+
+    const unsigned char* cursor = blob + sizeof(ChunkHeader);
+
+    view.position = position;
+    view.seed = chunk->seed;
+    view.buildingCount = chunk->buildingCount;
+    view.buildings = reinterpret_cast<const BuildingRecord*>(cursor);
+    cursor += chunk->buildingCount * sizeof(BuildingRecord);
+    view.heightResolution = chunk->heightResolution;
+    view.heights = chunk->heightResolution > 0 ? reinterpret_cast<const float*>(cursor) : nullptr;
+    view.normals = view.heights && chunk->hasNormals ? view.heights + heightCount : nullptr;
+
+    return true;
+
+}
+
+bool ChunkStore::save(const glm::ivec2& position, uint32_t seed,
+    const BuildingRecord* buildings, uint32_t buildingCount,
+    const float* heights, uint32_t heightResolution, const float* normals) {
+
+    glm::ivec2 region = regionCoords(position);
+    std::string path = regionPath(region);
+
+    //Release the Mapping Before Writing so the File can Grow (Required on Windows)
+    bool existingValid = mapRegion(region) != nullptr;
+    Region& entry = getRegion(region);
+    entry.file.close();
+    entry.checked = false;
+
+    //Start a Fresh Region File if None Exists or the Old One is Stale
+    if (!existingValid) {
+        RegionHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, REGION_MAGIC, 4);
+        header.version = FORMAT_VERSION;
+        header.signature = signature;
+        header.regionX = region.x;
+        header.regionZ = region.y;
+
+        std::ofstream fresh(path, std::ios::binary | std::ios::trunc);
+        fresh.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        if (!fresh) {
+            std::cout << "ERROR::CHUNK_STORE:: Could not create region file " << path << std::endl;
+            return false;
+        }
+    }
+
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file) return false;
+
+    //Serialise the Blob
+    ChunkHeader chunk;
+    chunk.x = position.x;
+    chunk.z = position.y;
+    chunk.seed = seed;
+    chunk.buildingCount = buildingCount;
+    chunk.heightResolution = heights ? heightResolution : 0;
+    chunk.hasNormals = chunk.heightResolution > 0 && normals ? 1 : 0;
+
+    size_t heightCount = static_cast<size_t>(chunk.heightResolution) * chunk.heightResolution;
+    std::vector<unsigned char> blob(sizeof(ChunkHeader) +
+        buildingCount * sizeof(BuildingRecord) +
+        heightCount * (chunk.hasNormals ? 4 : 1) * sizeof(float));
+
+    unsigned char* cursor = blob.data();
+    std::memcpy(cursor, &chunk, sizeof(ChunkHeader));
+    cursor += sizeof(ChunkHeader);
+    if (buildingCount > 0) std::memcpy(cursor, buildings, buildingCount * sizeof(BuildingRecord));
+    cursor += buildingCount * sizeof(BuildingRecord);
+    if (chunk.heightResolution > 0) std::memcpy(cursor, heights, heightCount * sizeof(float));
+    cursor += heightCount * sizeof(float);
+    if (chunk.hasNormals) std::memcpy(cursor, normals, heightCount * 3 * sizeof(float));
+
+    //Append at a 4 Byte Aligned Offset so Records can be Read in Place
+    file.seekp(0, std::ios::end);
+    size_t end = static_cast<size_t>(file.tellp());
+    size_t offset = (end + 3) & ~static_cast<size_t>(3);
+    static const char padding[4] = { 0, 0, 0, 0 };
+    file.write(padding, offset - end);
+    file.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+
+    //Point the Slot at the New Blob (Any Older Copy is Left Behind as Dead Space)
+    ChunkSlot slot;
+    slot.offset = static_cast<uint32_t>(offset);
+    slot.size = static_cast<uint32_t>(blob.size());
+    file.seekp(offsetof(RegionHeader, slots) + slotIndex(position) * sizeof(ChunkSlot));
+    file.write(reinterpret_cast<const char*>(&slot), sizeof(slot));
+
+    return static_cast<bool>(file);
+
+}
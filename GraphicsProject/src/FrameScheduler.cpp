@@ -0,0 +1,41 @@
+#include "FrameScheduler.h"
+
+#include <chrono>
+
+FrameScheduler::FrameScheduler(float budgetMilliseconds) : budget(budgetMilliseconds) {
+}
+
+void FrameScheduler::submit(std::function<void()> job, Priority priority) {
+
+    Job entry;
+    entry.work = std::move(job);
+    entry.priority = priority;
+    entry.sequence = nextSequence++;
+    jobs.push(std::move(entry));
+
+}
+
+void FrameScheduler::runFrame() {
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    float elapsed = 0.0f;
+    bool ranAny = false;
+
+    while (!jobs.empty()) {
+
+        //Critical Jobs Ignore the Budget, Everything Else Stops Once it's Spent
+        if (ranAny && jobs.top().priority != CRITICAL && elapsed >= budget) break;
+
+        //Pop Before Running so Jobs can Safely Submit Follow Up Work
+        std::function<void()> work = jobs.top().work;
+        jobs.pop();
+        work();
+
+        ranAny = true;
+        elapsed = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+
+    lastFrameTime = elapsed;
+
+}
@@ -1,34 +1,113 @@
 #include "Generator.h"
 
-Generator::Generator(Shader& shader, Shader& spawnShader, const std::vector<std::string>& buildingPaths)
-    : shader(shader), spawnShader(spawnShader) {
+#include <algorithm>
+#include <sstream>
 
-    //Allocate Space for Instance Buffers and Model Matrices Vectors According to Number of Building Models
-    buildingModels.reserve(buildingPaths.size());
-    instanceVBOs.resize(buildingPaths.size());
-    modelMatrices.resize(buildingPaths.size());
+Generator::Generator(Shader& shader, Shader& spawnShader, const std::vector<std::string>& buildingPaths, const std::vector<float>& buildingWeights,
+    FrameScheduler* scheduler)
+    : shader(shader), spawnShader(spawnShader),
+      chunks((UNLOAD_DISTANCE * 2 + 1) * (UNLOAD_DISTANCE * 2 + 1)),
+      scheduler(scheduler),
+      heightField(CHUNK_SIZE, TerrainLOD::BASE_HEIGHT),
+      prefetcher(CHUNK_SIZE, VIEW_DISTANCE, UNLOAD_DISTANCE, PREFETCH_HORIZON) {
 
     //Load Building Models
+    buildingModels.reserve(buildingPaths.size() + ASSEMBLED_SEEDS);
     for (const auto& path : buildingPaths) {
         buildingModels.push_back(std::make_shared<Model>(path));
     }
 
+    //Uniform Weights if None Given for Each Model
+    std::vector<float> weights = buildingWeights.size() == buildingPaths.size() ? buildingWeights : std::vector<float>(buildingPaths.size(), 1.0f);
+    std::vector<std::string> modelKeys = buildingPaths;
+
+    //Assemble Modular Buildings, Keeping One Model per Distinct Building. Each Seed Weighs the Same as an Average Loaded Model,
+    //and Seeds that Assemble an Identical Building Pool their Weight on the Shared Model
+    float seedWeight = 1.0f;
+    if (!weights.empty()) {
+        seedWeight = 0.0f;
+        for (float weight : weights) seedWeight += weight;
+        seedWeight /= weights.size();
+    }
+
+    BuildingAssembler assembler(std::string(PROJECT_ROOT) + "/assets/models/city");
+    std::vector<float> assembledWeights;
+    for (uint32_t i = 0; i < ASSEMBLED_SEEDS; i++) {
+        size_t building = assembler.assemble(static_cast<uint32_t>(hashCombine(ASSEMBLY_SEED, i)));
+        if (building >= assembledWeights.size()) assembledWeights.resize(building + 1, 0.0f);
+        assembledWeights[building] += seedWeight;
+    }
+
+    for (size_t i = 0; i < assembler.buildings().size(); i++) {
+        buildingModels.push_back(assembler.buildings()[i]);
+        weights.push_back(assembledWeights[i]);
+
+        //Assembled Buildings are Keyed by Content Hash in Place of a File Path
+        std::ostringstream key;
+        key << "assembled/" << std::hex << assembler.contentHash(i);
+        modelKeys.push_back(key.str());
+    }
+
+    //Allocate Space for Model Matrices Vectors According to Number of Building Models
+    modelMatrices.resize(buildingModels.size() * Mesh::LOD_COUNT);
+    shadowMatrices.resize(buildingModels.size() * Mesh::LOD_COUNT);
+
+    //Query Trees over Each Model's Full Detail Triangles
+    std::vector<std::shared_ptr<const ModelBVH>> modelTrees;
+    modelTrees.reserve(buildingModels.size());
+    for (const auto& model : buildingModels) {
+        std::vector<glm::vec3> positions;
+        std::vector<unsigned int> indices;
+        for (const auto& mesh : model->meshes) {
+            unsigned int base = static_cast<unsigned int>(positions.size());
+            for (const auto& vertex : mesh.vertices) positions.push_back(vertex.Position);
+            for (unsigned int index : mesh.indices) indices.push_back(base + index);
+        }
+        modelTrees.push_back(std::make_shared<ModelBVH>(positions, indices));
+    }
+    sceneBVH.setModels(std::move(modelTrees));
+
+    //Proxy Colours for Distant Chunks
+    modelColours.reserve(buildingModels.size());
+    for (const auto& model : buildingModels) {
+        modelColours.push_back(HLOD::averageColour(*model));
+    }
+
+    //Precompute Alias Table for Weighted Building Selection
+    worldGen.setBuildingWeights(weights);
+    worldGen.setThreadPool(&workers);
+
+    //Chunk Store is Keyed on Everything that Affects Chunk Content, so Stale Region Files are Ignored
+    chunkStore = std::make_unique<ChunkStore>(std::string(PROJECT_ROOT) + "/cache/chunks", contentSignature(modelKeys, weights));
+
     //Load Flat Terrain Geometry
     terrainTemplate = std::make_unique<Terrain>(shader);
 
-    //Reserve Space For Model Matrices for Each Building Model
-    for (auto& matrices : modelMatrices) {
-        matrices.reserve(BUILDINGS_PER_CHUNK * (VIEW_DISTANCE * 2 + 1) * (VIEW_DISTANCE * 2 + 1));
+    //CDLOD Terrain for Chunks w/ Heights (Currently Just the Spawn Chunk)
+    terrainLOD = std::make_unique<TerrainLOD>(CHUNK_SIZE, HEIGHTMAP_RESOLUTION, TERRAIN_TILES);
+
+    //Reserve Space For Model Matrices for Each Building Model and LOD (Sized for the Full Detail Neighbourhood, Grows if Needed)
+    for (size_t i = 0; i < modelMatrices.size(); i++) {
+        modelMatrices[i].reserve(BUILDINGS_PER_CHUNK * 9);
+        shadowMatrices[i].reserve(BUILDINGS_PER_CHUNK * 9);
     }
+    candidates.reserve(BUILDINGS_PER_CHUNK * (VIEW_DISTANCE * 2 + 1) * (VIEW_DISTANCE * 2 + 1));
 
     //Reserve Space for All Visible Terrain Tiles
     terrainMatrices.reserve((VIEW_DISTANCE * 2 + 1) * (VIEW_DISTANCE * 2 + 1));
 
     setupInstanceBuffers();
 
-    //Load Spire Model for Spawn/Origing Chunk
-    std::string spirePath = std::string(PROJECT_ROOT) + "/assets/models/spire/spire.gltf";
-    spireModel = std::make_shared<Model>(spirePath);
+    //Bake (or Load the Cached) Impostor Atlas from the Building Arena
+    impostors = std::make_unique<ImpostorAtlas>(buildingModels, modelKeys, *buildingBatch,
+        std::string(PROJECT_ROOT) + "/cache/impostors", BUILDINGS_PER_CHUNK * (VIEW_DISTANCE * 2 + 1) * (VIEW_DISTANCE * 2 + 1));
+    impostorInstances.reserve(BUILDINGS_PER_CHUNK * (VIEW_DISTANCE * 2 + 1) * (VIEW_DISTANCE * 2 + 1));
+
+    //Load Spire Model for Spawn/Origing Chunk (Only Drawn w/ the Origin, so it can Wait for a Quiet Frame)
+    schedule([this]() {
+        std::string spirePath = std::string(PROJECT_ROOT) + "/assets/models/spire/spire.gltf";
+        spireModel = std::make_shared<Model>(spirePath);
+    }, FrameScheduler::LOW);
 
     spireMatrix = glm::mat4(1.0f);
     spireMatrix = glm::scale(spireMatrix, glm::vec3(20.0f));
@@ -37,27 +116,9 @@ Generator::Generator(Shader& shader, Shader& spawnShader, const std::vector<std:
 
 void Generator::setupInstanceBuffers() {
 
-    //Setup Instance Buffers for Each Building Model 
-    for (size_t i = 0; i < buildingModels.size(); i++) {
-        glGenBuffers(1, &instanceVBOs[i]);
-        glBindBuffer(GL_ARRAY_BUFFER, instanceVBOs[i]);
-        glBufferData(GL_ARRAY_BUFFER,
-            sizeof(glm::mat4) * modelMatrices[i].capacity(),
-            nullptr, GL_DYNAMIC_DRAW);
-
-        //Setup VAO for Instancing for Each Mesh in Each Model
-        for (auto& mesh : buildingModels[i]->meshes) {
-            glBindVertexArray(mesh.VAO);
-            glBindBuffer(GL_ARRAY_BUFFER, instanceVBOs[i]);
-
-            for (int j = 0; j < 4; j++) {
-                glEnableVertexAttribArray(7 + j);
-                glVertexAttribPointer(7 + j, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * j));
-                glVertexAttribDivisor(7 + j, 1);
-            }
-        }
-    }
-    //Buildings
+    //Pack All Building Models into One Arena, Sized for Every Building in the View Square
+    size_t maxBuildings = BUILDINGS_PER_CHUNK * (VIEW_DISTANCE * 2 + 1) * (VIEW_DISTANCE * 2 + 1);
+    buildingBatch = std::make_unique<BuildingBatch>(buildingModels, maxBuildings);
 
     //Terrain
     glGenBuffers(1, &terrainInstanceVBO);
@@ -72,56 +133,160 @@ void Generator::generateChunk(const glm::ivec2& position) {
 
     ChunkData chunk;
     chunk.position = position;
-    chunk.seed = generateChunkSeed(position);
+    chunk.seed = WorldGen::chunkSeed(position);
 
-    //Set Aside Spawn/Origin Chunk for Perlin Noise Park
-    if (chunk.position == glm::ivec2(0, 0)) {
-        terrainTemplate->generateHeightmapMesh();
+    //Previously Explored Chunks are Read Back from Disk, so Revisiting Only Costs I/O
+    if (loadStoredChunk(chunk)) {
+        insertChunk(std::move(chunk));
+        return;
     }
-    else {
 
-        //Calculate Building Positions on a 3x3 Grid Within the Chunk
-        const float halfChunkSize = CHUNK_SIZE / 2.0f;
-        const float buildingOffset = (halfChunkSize - (ROAD_WIDTH / 2.0f)) * 0.75;
+    //Content is Generated w/o GL, Only the Spawn Chunk's Mesh Upload Touches the Context
+    WorldGen::Chunk content;
+    worldGen.generate(position, content);
+    chunk.buildings = std::move(content.buildings);
+
+    if (!content.heightMap.empty()) {
+        buildOriginMesh(content.heightMap, content.normalMap, HEIGHTMAP_RESOLUTION, worldGen.getWorldSeed());
+    }
+
+    storeChunk(chunk, content.heightMap, content.normalMap);
+    insertChunk(std::move(chunk));
 
-        for (int x = -1; x <= 1; x++) {
-            for (int z = -1; z <= 1; z++) {
-                BuildingData building;
-                float baseX = x == 0 ? 0 : (x > 0 ? buildingOffset : -buildingOffset);
-                float baseZ = z == 0 ? 0 : (z > 0 ? buildingOffset : -buildingOffset);
-                building.position = glm::vec3(baseX, -50.0f, baseZ);
+}
 
-                uint32_t buildingSeed = generateChunkSeed(position + glm::ivec2(x, z));
+bool Generator::loadStoredChunk(ChunkData& chunk) {
 
-                building.modelIndex = selectBuildingWeighted(buildingSeed, buildingModels.size());
+    ChunkStore::ChunkView view;
+    if (!chunkStore->load(chunk.position, view) || view.seed != chunk.seed) return false;
 
-                chunk.buildings.push_back(building);
-            }
+    bool isOrigin = chunk.position == glm::ivec2(0, 0);
+    if (isOrigin && !view.heights) return false;
+
+    for (uint32_t i = 0; i < view.buildingCount; i++) {
+        if (view.buildings[i].modelIndex >= buildingModels.size()) return false;
+    }
+
+    //Building Records and Heights are Read in Place from the Mapped Region File
+    chunk.buildings.reserve(view.buildingCount);
+    for (uint32_t i = 0; i < view.buildingCount; i++) {
+        const ChunkStore::BuildingRecord& record = view.buildings[i];
+
+        BuildingData building;
+        building.position = glm::vec3(record.position[0], record.position[1], record.position[2]);
+        building.rotation = record.rotation;
+        building.modelIndex = record.modelIndex;
+        chunk.buildings.push_back(building);
+    }
+
+    //Copied Out of the Mapping, since a Later Save into this Region Invalidates the View Before the Upload Runs
+    //(Skipped when the Mesh from an Earlier Visit is Still Uploaded)
+    if (isOrigin) {
+        int resolution = static_cast<int>(view.heightResolution);
+        size_t samples = static_cast<size_t>(view.heightResolution) * view.heightResolution;
+        std::vector<float> heights, normals;
+        if (!hasOriginTerrain(worldGen.getWorldSeed(), resolution)) {
+            heights.assign(view.heights, view.heights + samples);
+            if (view.normals) normals.assign(view.normals, view.normals + samples * 3);
         }
+        buildOriginMesh(std::move(heights), std::move(normals), resolution, worldGen.getWorldSeed());
+    }
+
+    return true;
+
+}
+
+void Generator::storeChunk(const ChunkData& chunk, const std::vector<float>& heightMap, const std::vector<float>& normalMap) {
+
+    std::vector<ChunkStore::BuildingRecord> records(chunk.buildings.size());
+    for (size_t i = 0; i < chunk.buildings.size(); i++) {
+        const BuildingData& building = chunk.buildings[i];
+        records[i].position[0] = building.position.x;
+        records[i].position[1] = building.position.y;
+        records[i].position[2] = building.position.z;
+        records[i].rotation = building.rotation;
+        records[i].modelIndex = static_cast<uint32_t>(building.modelIndex);
+    }
+
+    chunkStore->save(chunk.position, chunk.seed, records.data(), static_cast<uint32_t>(records.size()),
+        heightMap.empty() ? nullptr : heightMap.data(), heightMap.empty() ? 0 : static_cast<uint32_t>(HEIGHTMAP_RESOLUTION),
+        normalMap.empty() ? nullptr : normalMap.data());
+
+}
+
+uint32_t Generator::contentSignature(const std::vector<std::string>& modelKeys, const std::vector<float>& buildingWeights) const {
+
+    uint64_t hash = splitmix64(GENERATOR_VERSION);
+    for (const auto& path : modelKeys) {
+        std::string name = path.substr(path.find_last_of('/') + 1);
+        hash = hashBytes(name.data(), name.size(), hash);
     }
+    hash = hashBytes(buildingWeights.data(), buildingWeights.size() * sizeof(float), hash);
+
+    uint32_t worldSeed = worldGen.getWorldSeed();
+    hash = hashBytes(&worldSeed, sizeof(worldSeed), hash);
+
+    float layout[] = { CHUNK_SIZE, ROAD_WIDTH, static_cast<float>(BUILDINGS_PER_CHUNK), static_cast<float>(HEIGHTMAP_RESOLUTION) };
+    hash = hashBytes(layout, sizeof(layout), hash);
+
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+
+}
+
+bool Generator::isWithinDistance(const glm::ivec2& position, const glm::ivec2& center, int distance) const {
 
-    chunks[position] = chunk;
+    //Chebyshev Distance, Matching the Square View Region
+    return std::abs(position.x - center.x) <= distance && std::abs(position.y - center.y) <= distance;
 
 }
 
-size_t Generator::selectBuildingWeighted(uint32_t seed, size_t numBuildingTypes) {
+size_t Generator::chunkFootprint(const ChunkData& chunk) const {
 
-    std::mt19937 rng(seed); //Pseudo Random Number Generator w/ Mersenne Twisters, based on Chunk Seed
+    //Approximate Heap Cost of a Cached Chunk, Including List and Index Nodes
+    return sizeof(ChunkData) + chunk.buildings.capacity() * sizeof(BuildingData) + 4 * sizeof(void*) + sizeof(glm::ivec2);
 
-    std::vector<int> weights = { 20, 25, 20, 15, 10, 10};
+}
+
+void Generator::cacheChunk(ChunkData&& chunk) {
+
+    glm::ivec2 position = chunk.position;
+    size_t footprint = chunkFootprint(chunk);
+    if (footprint > CHUNK_CACHE_BUDGET) return;
+
+    chunkCache.push_front(std::move(chunk));
+    chunkCacheIndex[position] = chunkCache.begin();
+    chunkCacheBytes += footprint;
+
+    //Evict Least Recently Used Chunks Until Back Under Budget
+    while (chunkCacheBytes > CHUNK_CACHE_BUDGET) {
+        const ChunkData& oldest = chunkCache.back();
+        chunkCacheBytes -= chunkFootprint(oldest);
+
+        //The Spawn Chunk is Gone for Good, so its Heightmap Buffers Go w/ it
+        if (oldest.position == glm::ivec2(0, 0)) {
+            terrainTemplate->releaseHeightmapMesh(heightmapSeed, heightmapResolution);
+            terrainLOD->removeTile(oldest.position);
+            heightField.removeChunk(oldest.position);
+        }
 
-    std::discrete_distribution<int> dist(weights.begin(), weights.end());
-    return static_cast<size_t>(dist(rng));
+        chunkCacheIndex.erase(oldest.position);
+        chunkCache.pop_back();
+    }
 
 }
 
-uint32_t Generator::generateChunkSeed(const glm::ivec2& position) const {
+bool Generator::restoreCachedChunk(const glm::ivec2& position) {
+
+    auto* cached = chunkCacheIndex.find(position);
+    if (!cached) return false;
 
-    //Seed Generation is Deterministic, Based on World Space Coords, so that Chunks can be Reconstructed Faithfully
-    return static_cast<uint32_t>(
-        static_cast<uint32_t>(position.x) * static_cast<uint32_t>(12345) +
-        static_cast<uint32_t>(position.y) * static_cast<uint32_t>(67890)
-        );
+    std::list<ChunkData>::iterator entry = *cached;
+    chunkCacheBytes -= chunkFootprint(*entry);
+    insertChunk(std::move(*entry));
+    chunkCache.erase(entry);
+    chunkCacheIndex.erase(position);
+
+    return true;
 
 }
 
@@ -150,38 +315,61 @@ std::vector<glm::ivec2> Generator::getVisibleChunks(const glm::ivec2& centerChun
 }
 
 void Generator::update(const Camera& camera) {
-    glm::ivec2 currentChunk = worldToChunkCoords(camera.Position);
-    std::vector<glm::ivec2> visibleChunks = getVisibleChunks(currentChunk, camera.Front);
+    glm::ivec2 previousCenter = centerChunk;
+    centerChunk = worldToChunkCoords(camera.Position);
+    std::vector<glm::ivec2> visibleChunks = getVisibleChunks(centerChunk, camera.Front);
+
+    uploadFinishedTiles();
 
-    //Generate Chunks
+    //Generate Chunks, Reusing Recently Evicted Ones Where Possible
+    //The Camera's Own Neighbourhood Must Exist this Frame, the Rest of the View Square can Stream in Over Several
     for (const auto& chunkPos : visibleChunks) {
-        if (chunks.find(chunkPos) == chunks.end()) {
-            generateChunk(chunkPos);
+        if (!chunks.contains(chunkPos)) {
+            if (!restoreCachedChunk(chunkPos)) {
+                requestChunk(chunkPos, isWithinDistance(chunkPos, centerChunk, 1) ? FrameScheduler::CRITICAL : FrameScheduler::HIGH);
+            }
         }
     }
 
-    //Cull Far Away Chunks
-    for (auto i = chunks.begin(); i != chunks.end();) {
-        if (std::find(visibleChunks.begin(), visibleChunks.end(), i->first) == visibleChunks.end()) {
-            i = chunks.erase(i);
-        }
-        else {
-            ++i;
-        }
+    //Move Chunks Beyond the Unload Distance into the Residency Cache (Only Needed After Crossing a Chunk Boundary)
+    if (centerChunk != previousCenter) {
+        chunks.eraseIf([this](const glm::ivec2& pos, ChunkData& chunk) {
+            if (isWithinDistance(pos, centerChunk, UNLOAD_DISTANCE)) return false;
+            hlod.releaseChunk(pos);
+            sceneBVH.removeChunk(pos);
+            cacheChunk(std::move(chunk));
+            return true;
+        });
+    }
+
+    prefetchChunks(camera);
+
+    //CDLOD Nodes for Resident Chunks w/ Height Tiles in the View Square
+    if (terrainMode == TERRAIN_LOD) {
+        terrainLOD->select(camera.Position, camera.projectionMatrix() * camera.viewMatrix(), [this](const glm::ivec2& chunk) {
+            return chunks.contains(chunk) && isWithinDistance(chunk, centerChunk, VIEW_DISTANCE);
+        });
     }
 
     //Clear Model Matrices
-    for (auto& matrices : modelMatrices) {
-        matrices.clear();
+    for (size_t i = 0; i < modelMatrices.size(); i++) {
+        modelMatrices[i].clear();
+        shadowMatrices[i].clear();
     }
 
     terrainMatrices.clear();
+    candidates.clear();
+    proxyDraws.clear();
+    impostorShadowDraws.clear();
 
     //Update Visible Chunks
     for (const auto& pair : chunks) {
         const glm::ivec2& pos = pair.first;
         const ChunkData& chunk = pair.second;
 
+        //Resident Chunks Between the View and Unload Distances are Kept but not Drawn
+        if (!isWithinDistance(pos, centerChunk, VIEW_DISTANCE)) continue;
+
         glm::mat4 chunkMatrix = glm::translate(glm::mat4(1.0f),
             glm::vec3(pos.x * CHUNK_SIZE, 0.0f, pos.y * CHUNK_SIZE));
 
@@ -190,18 +378,406 @@ void Generator::update(const Camera& camera) {
             terrainMatrices.push_back(chunkMatrix);
         }
 
+        //Distant Chunks Draw a Merged Proxy Instead of their Buildings
+        if (selectProxy(pos)) continue;
+
+        //Mid Distance Chunks Draw Billboards, and Cast Shadows w/ their Proxy
+        bool useImpostors = impostors->isReady() && !isWithinDistance(pos, centerChunk, impostorDistance);
+        if (useImpostors && hlod.has(0, pos)) {
+            HLOD::Draw draw;
+            draw.level = 0;
+            draw.cell = pos;
+            impostorShadowDraws.push_back(draw);
+        }
+
         //Sort Buildings by Model and Create Transformations
         for (const auto& building : chunk.buildings) {
             glm::mat4 model = chunkMatrix;
             model = glm::translate(model, building.position);
             model = glm::scale(model, glm::vec3(BUILDING_SCALE));
-            modelMatrices[building.modelIndex].push_back(model);
+
+            //World Space Bounds (Translation and Uniform Scale Only)
+            const Model& buildingModel = *buildingModels[building.modelIndex];
+            glm::vec3 origin = glm::vec3(pos.x * CHUNK_SIZE, 0.0f, pos.y * CHUNK_SIZE) + building.position;
+
+            BuildingCandidate candidate;
+            candidate.model = model;
+            candidate.boundsMin = origin + buildingModel.boundsMin * BUILDING_SCALE;
+            candidate.boundsMax = origin + buildingModel.boundsMax * BUILDING_SCALE;
+            glm::vec3 toCamera = (candidate.boundsMin + candidate.boundsMax) * 0.5f - camera.Position;
+            candidate.distance = glm::dot(toCamera, toCamera);
+            candidate.modelIndex = building.modelIndex;
+            candidate.impostor = useImpostors && building.modelIndex < impostors->layerCount(); //Models Past the Atlas Draw as Meshes
+
+            //Detail Level from Projected Size, Shared by Both Passes
+            glm::vec3 centre = (candidate.boundsMin + candidate.boundsMax) * 0.5f;
+            float radius = glm::length(candidate.boundsMax - candidate.boundsMin) * 0.5f;
+            candidate.lod = Mesh::selectLod(camera.screenCoverage(centre, radius));
+            candidates.push_back(candidate);
+
+            if (!useImpostors) shadowMatrices[building.modelIndex * Mesh::LOD_COUNT + candidate.lod].push_back(model);
+        }
+    }
+
+    cullBuildings(camera);
+}
+
+void Generator::prefetchChunks(const Camera& camera) {
+
+    prefetcher.observe(camera.Position);
+    prefetcher.plan(centerChunk);
+
+    //Queue the Soonest Arrivals First, Skipping Chunks that are Already Resident or Queued
+    int queued = 0;
+    ChunkPrefetcher::Request request;
+    while (queued < PREFETCH_PER_FRAME && prefetcher.next(request)) {
+        if (chunks.contains(request.position)) continue;
+
+        //Restoring from the Cache is Cheap, so it Doesn't Count Against the Budget
+        if (restoreCachedChunk(request.position)) continue;
+
+        if (requestChunk(request.position, FrameScheduler::LOW)) queued++;
+    }
+
+}
+
+void Generator::schedule(std::function<void()> job, FrameScheduler::Priority priority) {
+
+    if (scheduler) {
+        scheduler->submit(std::move(job), priority);
+    }
+    else {
+        job();
+    }
+
+}
+
+bool Generator::requestChunk(const glm::ivec2& position, FrameScheduler::Priority priority) {
+
+    if (pendingChunks.contains(position)) return false;
+    pendingChunks[position] = 1;
+
+    schedule([this, position]() {
+        pendingChunks.erase(position);
+
+        //Skip Requests the Camera has Moved Away from Since they were Queued
+        if (chunks.contains(position) || !isWithinDistance(position, centerChunk, UNLOAD_DISTANCE)) return;
+
+        if (!restoreCachedChunk(position)) {
+            generateChunk(position);
+        }
+    }, priority);
+
+    return true;
+
+}
+
+//Normals are the Noise's Analytic Ones, Saved in the Chunk Store Alongside the Heights. Only Region Files Written
+//w/o Them Fall Back to Central Differences
+void Generator::buildOriginMesh(std::vector<float> heightMap, std::vector<float> normalMap, int resolution, uint32_t seed) {
+
+    heightmapSeed = seed;
+    heightmapResolution = resolution;
+
+    //Ground Queries Keep a Compact Copy for as Long as the Chunk is Cached
+    if (!heightMap.empty() && !heightField.hasChunk(glm::ivec2(0, 0))) {
+        heightField.setChunk(glm::ivec2(0, 0), heightMap.data(), resolution);
+    }
+
+    //Re-Entering the Spawn Area Reuses the Cached Mesh (or Height Tile)
+    if (hasOriginTerrain(seed, resolution)) return;
+
+    std::shared_ptr<std::vector<float>> heights = std::make_shared<std::vector<float>>(std::move(heightMap));
+    std::shared_ptr<std::vector<float>> normals = std::make_shared<std::vector<float>>(std::move(normalMap));
+
+    switch (terrainMode) {
+
+        //CDLOD Terrain Keeps the Heights and Slopes in its Tile Textures
+        case TERRAIN_LOD:
+            schedule([this, heights, normals, resolution]() {
+                terrainLOD->setTile(glm::ivec2(0, 0), heights->data(), resolution, normals->empty() ? nullptr : normals->data());
+            }, FrameScheduler::HIGH);
+            break;
+
+        //Packed Vertices: Quantised on the Workers, Uploaded in One Job
+        case PACKED_MESH:
+            schedule([this, heights, normals, resolution, seed]() {
+                HeightmapMesher::PackedMeshData mesh;
+                HeightmapMesher::buildPacked(heights->data(), resolution, mesh, &workers, normals->empty() ? nullptr : normals->data());
+                terrainTemplate->buildPackedHeightmapMesh(mesh, seed);
+            }, FrameScheduler::HIGH);
+            break;
+
+        //Streaming: Tiles are Meshed in the Background and Each Uploads in its Own Job as Soon as it's Done
+        case STREAMED_MESH: {
+            terrainTemplate->beginHeightmapMesh(seed, resolution);
+
+            std::shared_ptr<HeightmapStream> stream = std::make_shared<HeightmapStream>();
+            stream->seed = seed;
+            stream->tiles = HeightmapMesher::tileCount(resolution);
+            HeightmapMesher::allocate(stream->mesh, resolution);
+            heightmapStream = stream;
+
+            for (int tile = 0; tile < stream->tiles; tile++) {
+                workers.submit([stream, heights, normals, tile]() {
+                    HeightmapMesher::buildTile(heights->data(), tile, stream->mesh, normals->empty() ? nullptr : normals->data());
+
+                    std::lock_guard<std::mutex> lock(stream->mutex);
+                    stream->finished.push_back(tile);
+                });
+            }
+            break;
+        }
+
+    }
+
+}
+
+void Generator::uploadFinishedTiles() {
+
+    if (!heightmapStream) return;
+
+    std::shared_ptr<HeightmapStream> stream = heightmapStream;
+    std::vector<int> finished;
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        finished.swap(stream->finished);
+    }
+
+    for (int tile : finished) {
+        schedule([this, stream, tile]() {
+            terrainTemplate->uploadHeightmapTile(stream->seed, stream->mesh, tile);
+        }, FrameScheduler::HIGH);
+    }
+
+    //Every Tile Handed to the Scheduler, whose Jobs Keep the Mesh Data Alive Until they Run
+    stream->handedOut += static_cast<int>(finished.size());
+    if (stream->handedOut == stream->tiles) heightmapStream.reset();
+
+}
+
+void Generator::setHLODDistances(int chunkProxy, int cluster2x2, int cluster4x4) {
+
+    hlodDistances[0] = chunkProxy;
+    hlodDistances[1] = cluster2x2;
+    hlodDistances[2] = cluster4x4;
+
+}
+
+void Generator::insertChunk(ChunkData&& chunk) {
+
+    //Every Path into Residency Builds the Chunk's Proxy, so it's Ready Before the Chunk is Far Enough to Need it
+    glm::ivec2 position = chunk.position;
+    ChunkData& resident = chunks[position];
+    resident = std::move(chunk);
+    buildChunkProxy(resident);
+
+    //Buildings Become Queryable as Soon as they're Resident
+    std::vector<SceneBVH::Instance> instances;
+    instances.reserve(resident.buildings.size());
+    glm::vec3 origin = glm::vec3(position.x * CHUNK_SIZE, 0.0f, position.y * CHUNK_SIZE);
+    for (const auto& building : resident.buildings) {
+        SceneBVH::Instance instance;
+        instance.position = origin + building.position;
+        instance.scale = BUILDING_SCALE;
+        instance.model = static_cast<uint32_t>(building.modelIndex);
+        instances.push_back(instance);
+    }
+    sceneBVH.insertChunk(position, instances);
+
+}
+
+bool Generator::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, SceneBVH::RayHit& hit) const {
+
+    return sceneBVH.raycast(origin, direction, maxDistance, hit);
+
+}
+
+size_t Generator::overlap(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<SceneBVH::BuildingRef>& results) const {
+
+    return sceneBVH.overlap(boxMin, boxMax, results);
+
+}
+
+bool Generator::nearest(const glm::vec3& point, float maxDistance, SceneBVH::NearestHit& hit) const {
+
+    return sceneBVH.nearest(point, maxDistance, hit);
+
+}
+
+void Generator::appendProxyBoxes(const ChunkData& chunk, const glm::vec3& offset, std::vector<HLOD::Box>& boxes) const {
+
+    for (const auto& building : chunk.buildings) {
+        const Model& model = *buildingModels[building.modelIndex];
+
+        HLOD::Box box;
+        box.boundsMin = offset + building.position + model.boundsMin * BUILDING_SCALE;
+        box.boundsMax = offset + building.position + model.boundsMax * BUILDING_SCALE;
+        box.colour = modelColours[building.modelIndex];
+        boxes.push_back(box);
+    }
+
+}
+
+void Generator::buildChunkProxy(const ChunkData& chunk) {
+
+    std::vector<HLOD::Box> boxes;
+    boxes.reserve(chunk.buildings.size());
+    appendProxyBoxes(chunk, glm::vec3(0.0f), boxes);
+
+    hlod.build(0, chunk.position, glm::vec3(chunk.position.x * CHUNK_SIZE, 0.0f, chunk.position.y * CHUNK_SIZE), boxes);
+
+}
+
+bool Generator::isClusterResident(int level, const glm::ivec2& cell) const {
+
+    int span = 1 << level;
+    for (int x = 0; x < span; x++) {
+        for (int z = 0; z < span; z++) {
+            if (!chunks.contains(cell * span + glm::ivec2(x, z))) return false;
+        }
+    }
+
+    return true;
+
+}
+
+void Generator::requestCluster(int level, const glm::ivec2& cell) {
+
+    //Clusters are Only Merged Once Every Member Chunk is Resident
+    if (pendingClusters[level].contains(cell) || !isClusterResident(level, cell)) return;
+    pendingClusters[level][cell] = 1;
+
+    schedule([this, level, cell]() {
+        pendingClusters[level].erase(cell);
+        buildClusterProxy(level, cell);
+    }, FrameScheduler::NORMAL);
+
+}
+
+void Generator::buildClusterProxy(int level, const glm::ivec2& cell) {
+
+    //Members may have Been Unloaded While the Job was Queued
+    if (!isClusterResident(level, cell)) return;
+
+    int span = 1 << level;
+    glm::ivec2 base = cell * span;
+
+    std::vector<HLOD::Box> boxes;
+    boxes.reserve(BUILDINGS_PER_CHUNK * span * span);
+
+    for (int x = 0; x < span; x++) {
+        for (int z = 0; z < span; z++) {
+            const ChunkData* chunk = chunks.find(base + glm::ivec2(x, z));
+            appendProxyBoxes(*chunk, glm::vec3(x * CHUNK_SIZE, 0.0f, z * CHUNK_SIZE), boxes);
         }
     }
+
+    hlod.build(level, cell, glm::vec3(base.x * CHUNK_SIZE, 0.0f, base.y * CHUNK_SIZE), boxes);
+
+}
+
+int Generator::clusterDistance(int level, const glm::ivec2& cell) const {
+
+    //Chebyshev Distance from the Center Chunk to the Nearest Chunk in the Cluster
+    int span = 1 << level;
+    glm::ivec2 low = cell * span;
+    glm::ivec2 high = low + glm::ivec2(span - 1);
+
+    int dx = centerChunk.x < low.x ? low.x - centerChunk.x : (centerChunk.x > high.x ? centerChunk.x - high.x : 0);
+    int dz = centerChunk.y < low.y ? low.y - centerChunk.y : (centerChunk.y > high.y ? centerChunk.y - high.y : 0);
+    return std::max(dx, dz);
+
+}
+
+bool Generator::selectProxy(const glm::ivec2& position) {
+
+    //Coarsest Level First. A Cluster is Only Used Once its Nearest Chunk is Past the Threshold, so Every Member Agrees
+    for (int level = HLOD::LEVELS - 1; level >= 0; level--) {
+        glm::ivec2 cell = HLOD::clusterOf(position, level);
+        if (clusterDistance(level, cell) <= hlodDistances[level]) continue;
+
+        if (!hlod.has(level, cell)) {
+            if (level > 0) requestCluster(level, cell);
+            continue;
+        }
+
+        //Members of a Cluster Share One Draw
+        bool listed = false;
+        for (const auto& draw : proxyDraws) {
+            if (draw.level == level && draw.cell == cell) {
+                listed = true;
+                break;
+            }
+        }
+
+        if (!listed) {
+            HLOD::Draw draw;
+            draw.level = level;
+            draw.cell = cell;
+            proxyDraws.push_back(draw);
+        }
+
+        return true;
+    }
+
+    return false;
+
+}
+
+void Generator::cullBuildings(const Camera& camera) {
+
+    occlusionCuller.beginFrame(camera.projectionMatrix() * camera.viewMatrix());
+
+    //Nearest Buildings Hide the Most, so Rasterise Those as Occluders
+    occluderOrder.resize(candidates.size());
+    for (size_t i = 0; i < occluderOrder.size(); i++) occluderOrder[i] = i;
+
+    size_t occluderCount = std::min(OCCLUDER_COUNT, candidates.size());
+    std::partial_sort(occluderOrder.begin(), occluderOrder.begin() + occluderCount, occluderOrder.end(),
+        [this](size_t a, size_t b) { return candidates[a].distance < candidates[b].distance; });
+
+    for (size_t i = 0; i < occluderCount; i++) {
+        const BuildingCandidate& occluder = candidates[occluderOrder[i]];
+        glm::vec3 center = (occluder.boundsMin + occluder.boundsMax) * 0.5f;
+        glm::vec3 halfExtent = (occluder.boundsMax - occluder.boundsMin) * 0.5f * glm::vec3(OCCLUDER_SHRINK, 1.0f, OCCLUDER_SHRINK);
+        float top = occluder.boundsMin.y + (occluder.boundsMax.y - occluder.boundsMin.y) * OCCLUDER_SHRINK;
+
+        occlusionCuller.addOccluder(
+            glm::vec3(center.x - halfExtent.x, occluder.boundsMin.y, center.z - halfExtent.z),
+            glm::vec3(center.x + halfExtent.x, top, center.z + halfExtent.z));
+    }
+    occlusionCuller.finishOccluders();
+
+    //Proxies are Tested Against the Same Depth Buffer, Whole Clusters Hidden Behind Near Buildings are Skipped
+    visibleProxyDraws.clear();
+    for (const auto& draw : proxyDraws) {
+        glm::vec3 boundsMin, boundsMax;
+        if (hlod.bounds(draw.level, draw.cell, boundsMin, boundsMax) && occlusionCuller.isVisible(boundsMin, boundsMax)) {
+            visibleProxyDraws.push_back(draw);
+        }
+    }
+
+    //Only Instances that Pass the Test Reach the Main Pass
+    impostorInstances.clear();
+    for (const auto& candidate : candidates) {
+        if (!occlusionCuller.isVisible(candidate.boundsMin, candidate.boundsMax)) continue;
+
+        if (candidate.impostor) {
+            ImpostorAtlas::Instance instance;
+            instance.positionScale = glm::vec4(glm::vec3(candidate.model[3]), BUILDING_SCALE);
+            instance.layer = static_cast<float>(candidate.modelIndex);
+            impostorInstances.push_back(instance);
+        }
+        else {
+            modelMatrices[candidate.modelIndex * Mesh::LOD_COUNT + candidate.lod].push_back(candidate.model);
+        }
+    }
+
 }
 
 
-void Generator::render(Shader& shader, Shader& spawnShader, Shader& roadShader) {
+void Generator::render(Shader& shader, Shader& spawnShader, Shader& roadShader, bool shadowPass) {
 
     //Flat Terrain (Instanced)
     roadShader.use();
@@ -214,34 +790,51 @@ void Generator::render(Shader& shader, Shader& spawnShader, Shader& roadShader)
         terrainTemplate->renderInstanced(roadShader, terrainMatrices);
     }
 
-    //Perlin Noise Spawn/Origin Chunk (Not Instanced)
-    auto originChunk = chunks.find(glm::ivec2(0, 0));
-    if (originChunk != chunks.end()) {
+    //Perlin Noise Spawn/Origin Chunk (Not Instanced, Drawn by renderTerrain(...) Instead When CDLOD is On)
+    bool originReady = terrainMode == TERRAIN_LOD ? terrainLOD->hasTile(glm::ivec2(0, 0)) : terrainTemplate->isHeightmapMeshReady(heightmapSeed, heightmapResolution);
+    if (originReady && chunks.contains(glm::ivec2(0, 0)) && isWithinDistance(glm::ivec2(0, 0), centerChunk, VIEW_DISTANCE)) {
         spawnShader.use();
-        terrainTemplate->renderHeightmap(spawnShader);
-        spawnShader.setMat4("model", spireMatrix);
-        spireModel->render(spawnShader);
+        if (terrainMode != TERRAIN_LOD) terrainTemplate->renderHeightmap(spawnShader, heightmapSeed, heightmapResolution);
+
+        if (spireModel) {
+            spawnShader.setMat4("model", spireMatrix);
+            spireModel->render(spawnShader);
+        }
     }
 
-    //Buildings (Instanced)
-    shader.use();
-    for (size_t i = 0; i < buildingModels.size(); i++) {
-        if (modelMatrices[i].empty()) continue;
+    //Buildings (All Models in One Indirect Draw, or One BaseVertex Loop on GL 3.3)
+    //Occlusion is Camera Relative, so the Shadow Pass Keeps Hidden Buildings that may Still Cast Visible Shadows
+    buildingBatch->render(shader, shadowPass ? shadowMatrices : modelMatrices);
 
-        glBindBuffer(GL_ARRAY_BUFFER, instanceVBOs[i]);
-        glBufferSubData(GL_ARRAY_BUFFER, 0,
-            modelMatrices[i].size() * sizeof(glm::mat4),
-            modelMatrices[i].data());
+    //Distant Chunks and Clusters (One Draw Each)
+    hlod.render(shader, shadowPass ? proxyDraws : visibleProxyDraws);
+    if (shadowPass) hlod.render(shader, impostorShadowDraws);
+}
+
+void Generator::renderImpostors(Shader& impostorShader) {
+
+    impostors->render(impostorShader, impostorInstances);
+
+}
+
+void Generator::renderTerrain(Shader& terrainShader, bool shadowPass) {
+
+    if (terrainMode == TERRAIN_LOD) terrainLOD->render(terrainShader, shadowPass);
+
+}
+
+bool Generator::hasOriginTerrain(uint32_t seed, int resolution) const {
+
+    return terrainMode == TERRAIN_LOD ? terrainLOD->hasTile(glm::ivec2(0, 0)) : terrainTemplate->hasHeightmapMesh(seed, resolution);
 
-        buildingModels[i]->render(shader, true, modelMatrices[i].size());
-    }
 }
 
 Generator::~Generator() {
-    for (GLuint vbo : instanceVBOs) {
-        if (glIsBuffer(vbo)) {
-            glDeleteBuffers(1, &vbo);
-        }
-    }
     glDeleteBuffers(1, &terrainInstanceVBO);
+    terrainTemplate->deleteBuffers();
+
+    for (auto& model : buildingModels) {
+        model->releaseTextures();
+    }
+    if (spireModel) spireModel->releaseTextures();
 }
\ No newline at end of file
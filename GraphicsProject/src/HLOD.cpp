@@ -0,0 +1,189 @@
+#include "HLOD.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+//Outward Normal and Corner Selection (Bit 0 = x, Bit 1 = y, Bit 2 = z) for the 5 Visible Faces of a Box
+//Corners are Listed Counter Clockwise when Viewed from Outside
+struct ProxyFace {
+    glm::vec3 normal;
+    int corners[4];
+};
+
+static const ProxyFace PROXY_FACES[5] = {
+    { glm::vec3(-1.0f, 0.0f, 0.0f), { 0, 4, 6, 2 } },
+    { glm::vec3( 1.0f, 0.0f, 0.0f), { 5, 1, 3, 7 } },
+    { glm::vec3( 0.0f, 1.0f, 0.0f), { 6, 7, 3, 2 } },
+    { glm::vec3( 0.0f, 0.0f,-1.0f), { 1, 0, 2, 3 } },
+    { glm::vec3( 0.0f, 0.0f, 1.0f), { 4, 5, 7, 6 } }
+};
+
+HLOD::HLOD() {
+}
+
+glm::ivec2 HLOD::clusterOf(const glm::ivec2& chunk, int level) {
+
+    //Arithmetic Shift Floors Negative Coordinates, so Clusters Tile the Plane w/o a Seam at the Origin
+    return glm::ivec2(chunk.x >> level, chunk.y >> level);
+
+}
+
+glm::vec3 HLOD::averageColour(const Model& model) {
+
+    glm::vec3 total(0.0f);
+    float weight = 0.0f;
+
+    for (const auto& mesh : model.meshes) {
+        float count = static_cast<float>(mesh.indices.size());
+        total += mesh.diffuseColor * count;
+        weight += count;
+    }
+
+    return weight > 0.0f ? total / weight : glm::vec3(1.0f);
+
+}
+
+void HLOD::build(int level, const glm::ivec2& cell, const glm::vec3& origin, const std::vector<Box>& boxes) {
+
+    release(level, cell);
+    if (boxes.empty()) return;
+
+    std::vector<ProxyVertex> vertices;
+    std::vector<GLuint> indices;
+    vertices.reserve(boxes.size() * 20);
+    indices.reserve(boxes.size() * 30);
+
+    Proxy proxy;
+    proxy.boundsMin = boxes[0].boundsMin;
+    proxy.boundsMax = boxes[0].boundsMax;
+
+    //Merge Every Box into One Mesh
+    for (const auto& box : boxes) {
+        proxy.boundsMin = glm::min(proxy.boundsMin, box.boundsMin);
+        proxy.boundsMax = glm::max(proxy.boundsMax, box.boundsMax);
+
+        for (const auto& face : PROXY_FACES) {
+            GLuint base = static_cast<GLuint>(vertices.size());
+
+            for (int corner : face.corners) {
+                ProxyVertex vertex;
+                vertex.Position = glm::vec3(
+                    (corner & 1) ? box.boundsMax.x : box.boundsMin.x,
+                    (corner & 2) ? box.boundsMax.y : box.boundsMin.y,
+                    (corner & 4) ? box.boundsMax.z : box.boundsMin.z);
+                vertex.Normal = face.normal;
+                vertex.Colour = box.colour;
+                vertices.push_back(vertex);
+            }
+
+            GLuint quad[6] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+
+    proxy.transform = glm::translate(glm::mat4(1.0f), origin);
+    proxy.boundsMin += origin;
+    proxy.boundsMax += origin;
+    proxy.indexCount = static_cast<GLsizei>(indices.size());
+
+    //Buffer Setup
+    glGenVertexArrays(1, &proxy.VAO);
+    glGenBuffers(1, &proxy.VBO);
+    glGenBuffers(1, &proxy.EBO);
+
+    glBindVertexArray(proxy.VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, proxy.VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(ProxyVertex), vertices.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, proxy.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(ProxyVertex), (void*)offsetof(ProxyVertex, Position));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ProxyVertex), (void*)offsetof(ProxyVertex, Normal));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(ProxyVertex), (void*)offsetof(ProxyVertex, Colour));
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    //Buffer Setup
+
+    proxies[level][cell] = proxy;
+
+}
+
+void HLOD::deleteProxy(Proxy& proxy) {
+
+    glDeleteVertexArrays(1, &proxy.VAO);
+    glDeleteBuffers(1, &proxy.VBO);
+    glDeleteBuffers(1, &proxy.EBO);
+
+}
+
+void HLOD::release(int level, const glm::ivec2& cell) {
+
+    Proxy* proxy = proxies[level].find(cell);
+    if (!proxy) return;
+
+    deleteProxy(*proxy);
+    proxies[level].erase(cell);
+
+}
+
+void HLOD::releaseChunk(const glm::ivec2& chunk) {
+
+    for (int level = 0; level < LEVELS; level++) {
+        release(level, clusterOf(chunk, level));
+    }
+
+}
+
+bool HLOD::bounds(int level, const glm::ivec2& cell, glm::vec3& boundsMin, glm::vec3& boundsMax) const {
+
+    const Proxy* proxy = proxies[level].find(cell);
+    if (!proxy) return false;
+
+    boundsMin = proxy->boundsMin;
+    boundsMax = proxy->boundsMax;
+    return true;
+
+}
+
+void HLOD::render(Shader& shader, const std::vector<Draw>& draws) {
+
+    if (draws.empty()) return;
+
+    shader.use();
+    shader.setInt("useTexture", 3);
+
+    for (const auto& draw : draws) {
+        const Proxy* proxy = proxies[draw.level].find(draw.cell);
+        if (!proxy) continue;
+
+        //Instance Attributes are Left Disabled in Proxy VAOs, so the Shader Reads this Constant Matrix Instead
+        for (int j = 0; j < 4; j++) {
+            glVertexAttrib4fv(7 + j, &proxy->transform[j][0]);
+        }
+
+        glBindVertexArray(proxy->VAO);
+        glDrawElements(GL_TRIANGLES, proxy->indexCount, GL_UNSIGNED_INT, 0);
+    }
+
+    glBindVertexArray(0);
+    shader.setInt("useTexture", 0);
+
+}
+
+HLOD::~HLOD() {
+
+    for (int level = 0; level < LEVELS; level++) {
+        for (auto entry : proxies[level]) {
+            deleteProxy(entry.second);
+        }
+    }
+
+}
@@ -0,0 +1,138 @@
+#include "HeightField.h"
+#include "HeightmapMesher.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+HeightField::HeightField(float chunkSize, float baseHeight) : chunkSize(chunkSize), baseHeight(baseHeight) {
+
+}
+
+void HeightField::setChunk(const glm::ivec2& chunk, const float* heights, int resolution) {
+
+    if (resolution < 2) return;
+    removeChunk(chunk);
+
+    size_t sampleCount = static_cast<size_t>(resolution) * resolution;
+
+    //Range Includes the Flattened Edges (Height 0)
+    float lowest = 0.0f, highest = 0.0f;
+    for (size_t i = 0; i < sampleCount; i++) {
+        lowest = std::min(lowest, heights[i]);
+        highest = std::max(highest, heights[i]);
+    }
+
+    Field& field = fields[chunk];
+    field.resolution = resolution;
+    field.heightMin = lowest;
+    field.heightStep = (highest - lowest) / 65535.0f;
+    field.heights.resize(sampleCount);
+
+    for (int z = 0; z < resolution; z++) {
+        for (int x = 0; x < resolution; x++) {
+            bool isEdge = (x == 0 || x == resolution - 1 || z == 0 || z == resolution - 1);
+            size_t sample = static_cast<size_t>(z) * resolution + x;
+            field.heights[sample] = HeightmapMesher::quantiseHeight(isEdge ? 0.0f : heights[sample], lowest, highest - lowest);
+        }
+    }
+
+    storedBytes += sampleCount * sizeof(uint16_t);
+
+}
+
+void HeightField::removeChunk(const glm::ivec2& chunk) {
+
+    Field* field = fields.find(chunk);
+    if (!field) return;
+
+    storedBytes -= field->heights.size() * sizeof(uint16_t);
+    fields.erase(chunk);
+
+}
+
+glm::ivec2 HeightField::chunkAt(float x, float z) const {
+
+    //Chunks are Centred on chunk * chunkSize
+    return glm::ivec2(static_cast<int>(std::floor(x / chunkSize + 0.5f)), static_cast<int>(std::floor(z / chunkSize + 0.5f)));
+
+}
+
+void HeightField::sampleField(const Field& field, const glm::ivec2& chunk, float x, float z, float& height, glm::vec3* normal) const {
+
+    int last = field.resolution - 1;
+    float gridSize = chunkSize / last;
+
+    //Grid Coordinates in the Chunk, Clamped so Points on the Far Border Use the Last Cell
+    float gx = std::min(std::max((x - (chunk.x - 0.5f) * chunkSize) / gridSize, 0.0f), static_cast<float>(last));
+    float gz = std::min(std::max((z - (chunk.y - 0.5f) * chunkSize) / gridSize, 0.0f), static_cast<float>(last));
+    int cellX = std::min(static_cast<int>(gx), last - 1);
+    int cellZ = std::min(static_cast<int>(gz), last - 1);
+    float fx = gx - cellX, fz = gz - cellZ;
+
+    const uint16_t* row = &field.heights[static_cast<size_t>(cellZ) * field.resolution + cellX];
+    float h00 = field.heightMin + row[0] * field.heightStep;
+    float h10 = field.heightMin + row[1] * field.heightStep;
+    float h01 = field.heightMin + row[field.resolution] * field.heightStep;
+    float h11 = field.heightMin + row[field.resolution + 1] * field.heightStep;
+
+    float bottom = h00 + (h10 - h00) * fx;
+    float top = h01 + (h11 - h01) * fx;
+    height = baseHeight + bottom + (top - bottom) * fz;
+
+    //Slopes of the Bilinear Patch
+    if (normal) {
+        float slopeX = ((h10 - h00) + ((h11 - h01) - (h10 - h00)) * fz) / gridSize;
+        float slopeZ = (top - bottom) / gridSize;
+        *normal = glm::normalize(glm::vec3(-slopeX, 1.0f, -slopeZ));
+    }
+
+}
+
+float HeightField::sampleHeight(float x, float z) const {
+
+    glm::ivec2 chunk = chunkAt(x, z);
+    const Field* field = fields.find(chunk);
+    if (!field) return baseHeight;
+
+    float height;
+    sampleField(*field, chunk, x, z, height, nullptr);
+    return height;
+
+}
+
+glm::vec3 HeightField::sampleNormal(float x, float z) const {
+
+    glm::ivec2 chunk = chunkAt(x, z);
+    const Field* field = fields.find(chunk);
+    if (!field) return glm::vec3(0.0f, 1.0f, 0.0f);
+
+    float height;
+    glm::vec3 normal;
+    sampleField(*field, chunk, x, z, height, &normal);
+    return normal;
+
+}
+
+void HeightField::sampleHeights(const glm::vec2* points, size_t count, float* heights, glm::vec3* normals) const {
+
+    glm::ivec2 lastChunk(INT_MIN);
+    const Field* field = nullptr;
+
+    for (size_t i = 0; i < count; i++) {
+        glm::ivec2 chunk = chunkAt(points[i].x, points[i].y);
+        if (chunk != lastChunk) {
+            lastChunk = chunk;
+            field = fields.find(chunk);
+        }
+
+        if (!field) {
+            heights[i] = baseHeight;
+            if (normals) normals[i] = glm::vec3(0.0f, 1.0f, 0.0f);
+            continue;
+        }
+
+        sampleField(*field, chunk, points[i].x, points[i].y, heights[i], normals ? &normals[i] : nullptr);
+    }
+
+}
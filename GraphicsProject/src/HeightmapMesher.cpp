@@ -0,0 +1,269 @@
+#include "HeightmapMesher.h"
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+    //Central Difference Normal, Pointing Down for Interior Vertices and Straight Up on the Edges
+    //(Meshes Store it Negated, so Interior Normals End Up Pointing Up)
+    glm::vec3 gridNormal(const float* heightMap, int resolution, int x, int z, float gridSize) {
+
+        if (x == 0 || x == resolution - 1 || z == 0 || z == resolution - 1) return glm::vec3(0.0f, 1.0f, 0.0f);
+
+        float hL = heightMap[z * resolution + (x - 1)];
+        float hR = heightMap[z * resolution + (x + 1)];
+        float hD = heightMap[(z - 1) * resolution + x];
+        float hU = heightMap[(z + 1) * resolution + x];
+
+        float scale = 0.5f * gridSize;
+        glm::vec3 tangent(2.0f * scale, hR - hL, 0.0f);
+        glm::vec3 bitangent(0.0f, hU - hD, 2.0f * scale);
+        return glm::normalize(glm::cross(tangent, bitangent));
+
+    }
+
+    template <typename Index>
+    void buildStrips(int resolution, Index restart, std::vector<Index>& indices) {
+
+        indices.clear();
+        indices.reserve(static_cast<size_t>(resolution - 1) * (resolution * 2 + 1));
+
+        //Alternating Top/Bottom Row Vertices Make (topLeft, bottomLeft, topRight), then (topRight, bottomLeft, bottomRight)
+        for (int z = 0; z < resolution - 1; z++) {
+            for (int x = 0; x < resolution; x++) {
+                indices.push_back(static_cast<Index>(z * resolution + x));
+                indices.push_back(static_cast<Index>((z + 1) * resolution + x));
+            }
+            if (z < resolution - 2) indices.push_back(restart);
+        }
+
+    }
+
+}
+
+int HeightmapMesher::tileCount(int resolution) {
+
+    return (resolution + TILE_ROWS - 1) / TILE_ROWS;
+
+}
+
+HeightmapMesher::Tile HeightmapMesher::tile(int resolution, int index) {
+
+    //Vertex Rows [rowStart, rowEnd), Quad Rows [rowStart, min(rowEnd, resolution - 1))
+    int rowStart = index * TILE_ROWS;
+    int rowEnd = std::min(rowStart + TILE_ROWS, resolution);
+    int quadEnd = std::min(rowEnd, resolution - 1);
+    size_t indicesPerRow = static_cast<size_t>(resolution - 1) * 6;
+
+    Tile range;
+    range.firstVertex = static_cast<size_t>(rowStart) * resolution;
+    range.vertexCount = static_cast<size_t>(rowEnd - rowStart) * resolution;
+    range.firstIndex = static_cast<size_t>(rowStart) * indicesPerRow;
+    range.indexCount = quadEnd > rowStart ? static_cast<size_t>(quadEnd - rowStart) * indicesPerRow : 0;
+    return range;
+
+}
+
+void HeightmapMesher::allocate(MeshData& mesh, int resolution) {
+
+    size_t vertexCount = static_cast<size_t>(resolution) * resolution;
+
+    mesh.resolution = resolution;
+    mesh.vertices.resize(vertexCount * 3);
+    mesh.normals.resize(vertexCount * 3);
+    mesh.uvs.resize(vertexCount * 2);
+    mesh.indices.resize(static_cast<size_t>(resolution - 1) * (resolution - 1) * 6);
+
+}
+
+void HeightmapMesher::buildTile(const float* heightMap, int index, MeshData& mesh, const float* normals) {
+
+    int resolution = mesh.resolution;
+    int rowStart = index * TILE_ROWS;
+    int rowEnd = std::min(rowStart + TILE_ROWS, resolution);
+
+    float gridSize = 1000.0f / (resolution - 1);
+
+    for (int z = rowStart; z < rowEnd; z++) {
+        for (int x = 0; x < resolution; x++) {
+            size_t vertex = static_cast<size_t>(z) * resolution + x;
+
+            //Vertices
+            bool isEdge = (x == 0 || x == resolution - 1 || z == 0 || z == resolution - 1);
+
+            float xPos = x * gridSize - 500.0f;
+
+            //Clamp Edges to Flat Plane Height
+            float yPos = isEdge ? -50.0f : heightMap[vertex] - 50.0f;
+
+            float zPos = z * gridSize - 500.0f;
+
+            mesh.vertices[vertex * 3] = xPos;
+            mesh.vertices[vertex * 3 + 1] = yPos;
+            mesh.vertices[vertex * 3 + 2] = zPos;
+            //Vertices
+
+
+            //Normals (Analytic When Given, Central Differences Otherwise)
+            glm::vec3 normal = normals && !isEdge ? glm::vec3(normals[vertex * 3], normals[vertex * 3 + 1], normals[vertex * 3 + 2])
+                : -gridNormal(heightMap, resolution, x, z, gridSize);
+
+            mesh.normals[vertex * 3] = normal.x;
+            mesh.normals[vertex * 3 + 1] = normal.y;
+            mesh.normals[vertex * 3 + 2] = normal.z;
+            //Normals
+
+
+            //UV Coordinates
+            mesh.uvs[vertex * 2] = float(x) / (resolution - 1) * 10.0f;
+            mesh.uvs[vertex * 2 + 1] = float(z) / (resolution - 1) * 10.0f;
+            //UV Coordinates
+        }
+    }
+
+    tileIndices(resolution, index, &mesh.indices[0]);
+
+}
+
+void HeightmapMesher::tileIndices(int resolution, int index, unsigned int* indices) {
+
+    int rowStart = index * TILE_ROWS;
+    int rowEnd = std::min(rowStart + TILE_ROWS, resolution);
+
+    //Quads Below the Tile's Last Row Belong to this Tile, the Grid's Last Row has None
+    size_t next = tile(resolution, index).firstIndex;
+    for (int z = rowStart; z < std::min(rowEnd, resolution - 1); z++) {
+        for (int x = 0; x < resolution - 1; x++) {
+            unsigned int topLeft = z * resolution + x;
+            unsigned int bottomLeft = (z + 1) * resolution + x;
+            unsigned int topRight = topLeft + 1;
+            unsigned int bottomRight = bottomLeft + 1;
+
+            indices[next++] = topLeft;
+            indices[next++] = bottomLeft;
+            indices[next++] = topRight;
+
+            indices[next++] = topRight;
+            indices[next++] = bottomLeft;
+            indices[next++] = bottomRight;
+        }
+    }
+
+}
+
+void HeightmapMesher::gridIndices(int resolution, std::vector<unsigned int>& indices) {
+
+    indices.resize(static_cast<size_t>(resolution - 1) * (resolution - 1) * 6);
+    for (int i = 0; i < tileCount(resolution); i++) tileIndices(resolution, i, indices.data());
+
+}
+
+bool HeightmapMesher::shortStripIndices(int resolution) {
+
+    return static_cast<size_t>(resolution) * resolution <= 0xFFFF;
+
+}
+
+void HeightmapMesher::stripIndices(int resolution, std::vector<uint16_t>& indices) {
+
+    buildStrips<uint16_t>(resolution, 0xFFFF, indices);
+
+}
+
+void HeightmapMesher::stripIndices(int resolution, std::vector<uint32_t>& indices) {
+
+    buildStrips<uint32_t>(resolution, 0xFFFFFFFFu, indices);
+
+}
+
+uint16_t HeightmapMesher::quantiseHeight(float height, float heightMin, float heightRange) {
+
+    if (heightRange <= 0.0f) return 0;
+    float normalised = std::min(std::max((height - heightMin) / heightRange, 0.0f), 1.0f);
+    return static_cast<uint16_t>(std::lround(normalised * 65535.0f));
+
+}
+
+//Attrib: Cigolle et al., A Survey of Efficient Representations for Independent Unit Vectors (Octahedral Mapping)
+void HeightmapMesher::encodeNormal(const float* normal, uint8_t* encoded) {
+
+    float sum = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+    float u = normal[0] / sum, v = normal[2] / sum;
+
+    //Lower Hemisphere Folds Over the Diagonals
+    if (normal[1] < 0.0f) {
+        float foldedU = (1.0f - std::fabs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+        float foldedV = (1.0f - std::fabs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+        u = foldedU;
+        v = foldedV;
+    }
+
+    encoded[0] = static_cast<uint8_t>(std::lround((u * 0.5f + 0.5f) * 255.0f));
+    encoded[1] = static_cast<uint8_t>(std::lround((v * 0.5f + 0.5f) * 255.0f));
+
+}
+
+void HeightmapMesher::buildPacked(const float* heightMap, int resolution, PackedMeshData& mesh, ThreadPool* pool, const float* normals) {
+
+    size_t vertexCount = static_cast<size_t>(resolution) * resolution;
+
+    //Range Covers the Flattened Edges Too, so Height 0 Stays in Range
+    float lowest = 0.0f, highest = 0.0f;
+    for (size_t i = 0; i < vertexCount; i++) {
+        lowest = std::min(lowest, heightMap[i]);
+        highest = std::max(highest, heightMap[i]);
+    }
+
+    mesh.resolution = resolution;
+    mesh.heightMin = lowest;
+    mesh.heightRange = highest - lowest;
+    mesh.vertices.resize(vertexCount);
+
+    float gridSize = 1000.0f / (resolution - 1);
+    auto packRows = [heightMap, resolution, gridSize, normals, &mesh](size_t index) {
+        int rowStart = static_cast<int>(index) * TILE_ROWS;
+        int rowEnd = std::min(rowStart + TILE_ROWS, resolution);
+
+        for (int z = rowStart; z < rowEnd; z++) {
+            for (int x = 0; x < resolution; x++) {
+                PackedVertex& vertex = mesh.vertices[static_cast<size_t>(z) * resolution + x];
+                bool isEdge = (x == 0 || x == resolution - 1 || z == 0 || z == resolution - 1);
+
+                vertex.height = quantiseHeight(isEdge ? 0.0f : heightMap[z * resolution + x], mesh.heightMin, mesh.heightRange);
+
+                //Same Normals and Sign Convention as buildTile
+                size_t offset = (static_cast<size_t>(z) * resolution + x) * 3;
+                glm::vec3 normal = normals && !isEdge ? glm::vec3(normals[offset], normals[offset + 1], normals[offset + 2])
+                    : -gridNormal(heightMap, resolution, x, z, gridSize);
+                encodeNormal(&normal.x, vertex.normal);
+            }
+        }
+    };
+
+    size_t tiles = static_cast<size_t>(tileCount(resolution));
+    if (!pool) {
+        for (size_t i = 0; i < tiles; i++) packRows(i);
+        return;
+    }
+
+    pool->parallelFor(tiles, packRows);
+
+}
+
+void HeightmapMesher::build(const float* heightMap, int resolution, MeshData& mesh, ThreadPool* pool, const float* normals) {
+
+    allocate(mesh, resolution);
+    int tiles = tileCount(resolution);
+
+    if (!pool) {
+        for (int i = 0; i < tiles; i++) buildTile(heightMap, i, mesh, normals);
+        return;
+    }
+
+    pool->parallelFor(static_cast<size_t>(tiles), [heightMap, normals, &mesh](size_t i) {
+        buildTile(heightMap, static_cast<int>(i), mesh, normals);
+    });
+
+}
@@ -0,0 +1,283 @@
+#include "ImpostorAtlas.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "Hash.h"
+#include "MappedFile.h"
+
+static const char CACHE_MAGIC[4] = { 'G', 'P', 'I', 'M' };
+
+ImpostorAtlas::ImpostorAtlas(const std::vector<std::shared_ptr<Model>>& models, const std::vector<std::string>& modelPaths,
+    BuildingBatch& batch, const std::string& cacheDirectory, size_t maxInstances)
+    : layers(std::min(models.size(), static_cast<size_t>(MAX_MODELS))), maxInstances(maxInstances) {
+
+    if (models.size() > MAX_MODELS) {
+        std::cout << "ERROR::IMPOSTOR_ATLAS:: Only the first " << MAX_MODELS << " models get impostors" << std::endl;
+    }
+
+    //Bounding Spheres Frame Each Bake and Size Each Billboard
+    for (size_t i = 0; i < layers; i++) {
+        glm::vec3 centre = (models[i]->boundsMin + models[i]->boundsMax) * 0.5f;
+        float radius = glm::length(models[i]->boundsMax - models[i]->boundsMin) * 0.5f;
+        spheres.push_back(glm::vec4(centre, radius));
+    }
+
+    //Signature Covers the Model Files and Bake Layout, so Editing Either Triggers a Rebake
+    uint64_t hash = splitmix64(FORMAT_VERSION);
+    for (size_t i = 0; i < layers; i++) {
+        std::string name = modelPaths[i].substr(modelPaths[i].find_last_of('/') + 1);
+        hash = hashBytes(name.data(), name.size(), hash);
+    }
+    hash = hashBytes(spheres.data(), spheres.size() * sizeof(glm::vec4), hash);
+    uint32_t signature = static_cast<uint32_t>(hash ^ (hash >> 32));
+
+    createDirectories(cacheDirectory);
+    std::string cachePath = cacheDirectory + "/atlas.gpi";
+
+    setupQuad();
+
+    if (loadCache(cachePath, signature)) {
+        ready = true;
+        return;
+    }
+
+    if (bake(batch)) {
+        saveCache(cachePath, signature);
+        ready = true;
+    }
+
+}
+
+void ImpostorAtlas::createTextures(const unsigned char* colour, const unsigned char* normal) {
+
+    //No Mipmaps, Lower Levels would Bleed Neighbouring Frames Together
+    GLuint* textures[2] = { &colourAtlas, &normalAtlas };
+    const unsigned char* data[2] = { colour, normal };
+
+    for (int i = 0; i < 2; i++) {
+        glGenTextures(1, textures[i]);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, *textures[i]);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, ATLAS_SIZE, ATLAS_SIZE, static_cast<GLsizei>(layers), 0,
+            GL_RGBA, GL_UNSIGNED_BYTE, data[i]);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+}
+
+bool ImpostorAtlas::bake(BuildingBatch& batch) {
+
+    if (layers == 0) return false;
+
+    std::string vert = std::string(PROJECT_ROOT) + "/src/shaders/impostorBake.vert";
+    std::string frag = std::string(PROJECT_ROOT) + "/src/shaders/impostorBake.frag";
+    Shader bakeShader(vert.c_str(), frag.c_str());
+
+    createTextures(nullptr, nullptr);
+
+    //Restore the Caller's Viewport Afterwards
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    GLuint fbo, depthRBO;
+    glGenFramebuffers(1, &fbo);
+    glGenRenderbuffers(1, &depthRBO);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, depthRBO);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, ATLAS_SIZE, ATLAS_SIZE);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthRBO);
+    GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+
+    bakeShader.use();
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+    bool complete = true;
+    for (size_t layer = 0; layer < layers && complete; layer++) {
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, colourAtlas, 0, static_cast<GLint>(layer));
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, normalAtlas, 0, static_cast<GLint>(layer));
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cout << "ERROR::IMPOSTOR_ATLAS:: Bake framebuffer is incomplete" << std::endl;
+            complete = false;
+            break;
+        }
+
+        glViewport(0, 0, ATLAS_SIZE, ATLAS_SIZE);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        glm::vec3 centre(spheres[layer]);
+        float radius = spheres[layer].w;
+        bakeShader.setMat4("projection", octahedralBakeProjection(radius));
+
+        //One Orthographic View per Frame, Looking Back at the Model Along the Frame's Direction
+        for (int y = 0; y < FRAMES; y++) {
+            for (int x = 0; x < FRAMES; x++) {
+                glViewport(x * FRAME_SIZE, y * FRAME_SIZE, FRAME_SIZE, FRAME_SIZE);
+                bakeShader.setMat4("view", octahedralBakeView(glm::ivec2(x, y), FRAMES, centre, radius));
+                batch.renderModel(layer, glm::mat4(1.0f));
+            }
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteRenderbuffers(1, &depthRBO);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    return complete;
+
+}
+
+bool ImpostorAtlas::loadCache(const std::string& path, uint32_t signature) {
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    CacheHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, CACHE_MAGIC, 4) != 0 || header.version != FORMAT_VERSION ||
+        header.signature != signature || header.layers != layers ||
+        header.frames != FRAMES || header.frameSize != FRAME_SIZE) {
+        return false;
+    }
+
+    size_t layerBytes = static_cast<size_t>(ATLAS_SIZE) * ATLAS_SIZE * 4;
+    std::vector<unsigned char> colour(layerBytes * layers), normal(layerBytes * layers);
+    file.read(reinterpret_cast<char*>(colour.data()), colour.size());
+    file.read(reinterpret_cast<char*>(normal.data()), normal.size());
+    if (!file) return false;
+
+    createTextures(colour.data(), normal.data());
+    return true;
+
+}
+
+void ImpostorAtlas::saveCache(const std::string& path, uint32_t signature) {
+
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = FORMAT_VERSION;
+    header.signature = signature;
+    header.layers = static_cast<uint32_t>(layers);
+    header.frames = FRAMES;
+    header.frameSize = FRAME_SIZE;
+
+    //Read the Baked Layers Back so Later Runs Skip the Bake
+    size_t layerBytes = static_cast<size_t>(ATLAS_SIZE) * ATLAS_SIZE * 4;
+    std::vector<unsigned char> colour(layerBytes * layers), normal(layerBytes * layers);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, colourAtlas);
+    glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, GL_UNSIGNED_BYTE, colour.data());
+    glBindTexture(GL_TEXTURE_2D_ARRAY, normalAtlas);
+    glGetTexImage(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, GL_UNSIGNED_BYTE, normal.data());
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(colour.data()), colour.size());
+    file.write(reinterpret_cast<const char*>(normal.data()), normal.size());
+
+    if (!file) {
+        std::cout << "ERROR::IMPOSTOR_ATLAS:: Could not write cache " << path << std::endl;
+    }
+
+}
+
+void ImpostorAtlas::setupQuad() {
+
+    //Unit Quad Corners, Expanded to the Model's Bounding Sphere in the Vertex Shader
+    float corners[8] = {
+        -1.0f, -1.0f,
+         1.0f, -1.0f,
+         1.0f,  1.0f,
+        -1.0f,  1.0f
+    };
+    GLuint indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+    //Buffer Setup
+    glGenVertexArrays(1, &quadVAO);
+    glGenBuffers(1, &quadVBO);
+    glGenBuffers(1, &quadEBO);
+    glGenBuffers(1, &instanceVBO);
+
+    glBindVertexArray(quadVAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, maxInstances * sizeof(Instance), nullptr, GL_DYNAMIC_DRAW);
+
+    glEnableVertexAttribArray(7);
+    glVertexAttribPointer(7, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, positionScale));
+    glVertexAttribDivisor(7, 1);
+
+    glEnableVertexAttribArray(8);
+    glVertexAttribPointer(8, 1, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, layer));
+    glVertexAttribDivisor(8, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    //Buffer Setup
+
+}
+
+void ImpostorAtlas::render(Shader& shader, const std::vector<Instance>& instances) {
+
+    if (!ready || instances.empty()) return;
+
+    size_t count = std::min(instances.size(), maxInstances);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(Instance), instances.data());
+
+    shader.use();
+    shader.setInt("frames", FRAMES);
+    for (size_t i = 0; i < spheres.size(); i++) {
+        shader.setVec4("modelSpheres[" + std::to_string(i) + "]", spheres[i]);
+    }
+
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, colourAtlas);
+    shader.setInt("colourAtlas", 2);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, normalAtlas);
+    shader.setInt("normalAtlas", 3);
+
+    glBindVertexArray(quadVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, static_cast<GLsizei>(count));
+    glBindVertexArray(0);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+}
+
+ImpostorAtlas::~ImpostorAtlas() {
+
+    glDeleteTextures(1, &colourAtlas);
+    glDeleteTextures(1, &normalAtlas);
+    glDeleteVertexArrays(1, &quadVAO);
+    glDeleteBuffers(1, &quadVBO);
+    glDeleteBuffers(1, &quadEBO);
+    glDeleteBuffers(1, &instanceVBO);
+
+}
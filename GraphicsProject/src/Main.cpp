@@ -4,7 +4,7 @@
 const unsigned int SCREEN_WIDTH = 1920;
 const unsigned int SCREEN_HEIGHT = 1080;
 
-Camera camera(glm::vec3(0.0f, 0.0f, 0.0f), 0.5f, 4000.0f, SCREEN_HEIGHT, SCREEN_WIDTH);
+Camera camera(glm::vec3(0.0f, 0.0f, 0.0f), 0.5f, 9000.0f, SCREEN_HEIGHT, SCREEN_WIDTH);
 
 //Mouse Control Vars
 float lastX = SCREEN_WIDTH / 2.0f;
@@ -88,6 +88,29 @@ int main() {
     //Default Instancing Shader
 
 
+    //Batched Building Shader (Shared Arena w/ Per Vertex Colour)
+    vert = std::string(PROJECT_ROOT) + "/src/shaders/batched.vert";
+    frag = std::string(PROJECT_ROOT) + "/src/shaders/default.frag";
+
+    Shader batchShader(vert.c_str(), frag.c_str());
+
+    batchShader.use();
+    batchShader.setVec3("lightDir", lightDir);
+    batchShader.setInt("depthMap", 1);
+    //Batched Building Shader (Shared Arena w/ Per Vertex Colour)
+
+
+    //Impostor Shader (Octahedral Billboards for Mid Distance Buildings)
+    vert = std::string(PROJECT_ROOT) + "/src/shaders/impostor.vert";
+    frag = std::string(PROJECT_ROOT) + "/src/shaders/impostor.frag";
+
+    Shader impostorShader(vert.c_str(), frag.c_str());
+
+    impostorShader.use();
+    impostorShader.setVec3("lightDir", lightDir);
+    //Impostor Shader (Octahedral Billboards for Mid Distance Buildings)
+
+
     //Spawn Chunk Shader (No Instancing)
     vert = std::string(PROJECT_ROOT) + "/src/shaders/spawn.vert";
     frag = std::string(PROJECT_ROOT) + "/src/shaders/spawn.frag";
@@ -99,6 +122,17 @@ int main() {
     //Spawn Chunk Shader (No Instancing)
 
 
+    //CDLOD Terrain Shader (Height Tiles Displaced in the Vertex Shader, Lit Like the Spawn Chunk)
+    vert = std::string(PROJECT_ROOT) + "/src/shaders/terrainLOD.vert";
+    frag = std::string(PROJECT_ROOT) + "/src/shaders/spawn.frag";
+    Shader terrainShader(vert.c_str(), frag.c_str());
+
+    terrainShader.use();
+    terrainShader.setVec3("lightDir", lightDir);
+    terrainShader.setInt("depthMap", 1);
+    //CDLOD Terrain Shader (Height Tiles Displaced in the Vertex Shader, Lit Like the Spawn Chunk)
+
+
     //Road & Footpath Shader
     vert = std::string(PROJECT_ROOT) + "/src/shaders/roads.vert";
     frag = std::string(PROJECT_ROOT) + "/src/shaders/roads.frag";
@@ -121,6 +155,10 @@ int main() {
     vert = std::string(PROJECT_ROOT) + "/src/shaders/spawnDepth.vert";
     frag = std::string(PROJECT_ROOT) + "/src/shaders/spawnDepth.frag";
     Shader spawnDepth(vert.c_str(), frag.c_str());
+
+    vert = std::string(PROJECT_ROOT) + "/src/shaders/terrainLODDepth.vert";
+    frag = std::string(PROJECT_ROOT) + "/src/shaders/spawnDepth.frag";
+    Shader terrainDepth(vert.c_str(), frag.c_str());
     //Shadow Mapping
 
 
@@ -136,7 +174,13 @@ int main() {
 
     };
 
-    Generator generator(shader, spawnShader, buildingPaths);
+    //Relative Likelihood of Each Building Model Being Placed
+    std::vector<float> buildingWeights = { 20.0f, 25.0f, 20.0f, 15.0f, 10.0f, 10.0f };
+
+    //GL Side Streaming Work is Drained Each Frame Up to this Many Milliseconds
+    FrameScheduler frameScheduler(4.0f);
+
+    Generator generator(shader, spawnShader, buildingPaths, buildingWeights, &frameScheduler);
     //Procedural Chunk Generation
     
     
@@ -175,7 +219,8 @@ int main() {
         //Updates
         processInput(window);
         generator.update(camera);
-        boidManager.update(0.08f);
+        frameScheduler.runFrame();
+        boidManager.update(0.08f, camera, &generator.terrainHeights());
 
 
         glm::vec3 lightPosition = camera.Position - lightDir * 1000.0f;
@@ -193,13 +238,17 @@ int main() {
         spawnDepth.setMat4("lightSpaceMatrix", lightSpaceMatrix);
         spawnDepth.setMat4("model", glm::mat4(1.0f));
 
+        terrainDepth.use();
+        terrainDepth.setMat4("lightSpaceMatrix", lightSpaceMatrix);
+
 
         glBindFramebuffer(GL_FRAMEBUFFER, depthFBO);
         glViewport(0, 0, depthMapResolution, depthMapResolution);
         glClear(GL_DEPTH_BUFFER_BIT);
         glCullFace(GL_FRONT);
 
-        generator.render(depthShader, spawnDepth, depthShader);
+        generator.render(depthShader, spawnDepth, depthShader, true);
+        generator.renderTerrain(terrainDepth, true);
         boidManager.render(depthShader);
   
         glCullFace(GL_BACK);
@@ -229,6 +278,17 @@ int main() {
         shader.setInt("useTexture", 0);
         //Default Instancing Shader
 
+        //Batched Building Shader
+        batchShader.use();
+
+        batchShader.setMat4("view", camera.viewMatrix());
+        batchShader.setMat4("projection", camera.projectionMatrix());
+        batchShader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
+
+        batchShader.setVec3("viewPosition", camera.Position);
+        batchShader.setVec3("lightPosition", lightPosition);
+        //Batched Building Shader
+
         //Roads & Footpaths
         roadShader.use();
 
@@ -255,8 +315,26 @@ int main() {
         //Spawn Chunk Shader (No Instancing)
 
 
+        //CDLOD Terrain
+        terrainShader.use();
+
+        terrainShader.setMat4("view", camera.viewMatrix());
+        terrainShader.setMat4("projection", camera.projectionMatrix());
+        terrainShader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
+
+        terrainShader.setVec3("viewPosition", camera.Position);
+        //CDLOD Terrain
+
+
         //Render
-        generator.render(shader, spawnShader, roadShader);
+        generator.render(batchShader, spawnShader, roadShader);
+        generator.renderTerrain(terrainShader);
+
+        impostorShader.use();
+        impostorShader.setMat4("view", camera.viewMatrix());
+        impostorShader.setMat4("projection", camera.projectionMatrix());
+        impostorShader.setVec3("viewPosition", camera.Position);
+        generator.renderImpostors(impostorShader);
         boidManager.render(shader);
         skybox.render(skyboxShader, camera);
         //Render
@@ -1,4 +1,16 @@
 #include "Mesh.h"
+#include "MeshSimplifier.h"
+
+const float Mesh::LOD_RATIOS[Mesh::LOD_COUNT] = { 1.0f, 0.5f, 0.25f, 0.1f };
+const float Mesh::LOD_COVERAGE[Mesh::LOD_COUNT - 1] = { 0.2f, 0.08f, 0.03f };
+
+int Mesh::selectLod(float screenCoverage) {
+
+    int lod = 0;
+    while (lod < LOD_COUNT - 1 && screenCoverage < LOD_COVERAGE[lod]) lod++;
+    return lod;
+
+}
 
 Mesh::Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures, glm::vec3 diffuseColor) {
 
@@ -7,6 +19,7 @@ Mesh::Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture
     this->textures = textures;
     this->diffuseColor = diffuseColor;
 
+    buildLods();
     setupMesh();
 
 }
@@ -48,6 +61,29 @@ void Mesh::render(Shader& shader) {
     glActiveTexture(GL_TEXTURE0);
 }
 
+void Mesh::buildLods() {
+
+    vector<glm::vec3> positions(vertices.size()), normals(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        positions[i] = vertices[i].Position;
+        normals[i] = vertices[i].Normal;
+    }
+
+    lodFirstIndex[0] = 0;
+    lodIndexCount[0] = static_cast<unsigned int>(indices.size());
+
+    //Each LOD is Simplified from the Full Mesh so Errors Don't Compound
+    for (int lod = 1; lod < LOD_COUNT; lod++) {
+        size_t target = static_cast<size_t>(indices.size() / 3 * LOD_RATIOS[lod]) * 3;
+        vector<unsigned int> simplified = simplifyMesh(positions, normals, indices, target);
+
+        lodFirstIndex[lod] = static_cast<unsigned int>(indices.size() + lodIndices.size());
+        lodIndexCount[lod] = static_cast<unsigned int>(simplified.size());
+        lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.end());
+    }
+
+}
+
 void Mesh::setupMesh() {
 
     glGenVertexArrays(1, &VAO);
@@ -58,8 +94,11 @@ void Mesh::setupMesh() {
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
 
+    //Every LOD Shares the Vertex Buffer, Only their Index Ranges Differ
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (indices.size() + lodIndices.size()) * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices.size() * sizeof(unsigned int), indices.data());
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), lodIndices.size() * sizeof(unsigned int), lodIndices.data());
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
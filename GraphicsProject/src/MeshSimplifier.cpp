@@ -0,0 +1,283 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <queue>
+
+//Symmetric 4x4 Error Quadric, Stored as its Upper Triangle
+struct Quadric {
+
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+
+    void addPlane(const glm::dvec3& normal, double d, double weight) {
+
+        a2 += weight * normal.x * normal.x; ab += weight * normal.x * normal.y; ac += weight * normal.x * normal.z; ad += weight * normal.x * d;
+        b2 += weight * normal.y * normal.y; bc += weight * normal.y * normal.z; bd += weight * normal.y * d;
+        c2 += weight * normal.z * normal.z; cd += weight * normal.z * d;
+        d2 += weight * d * d;
+
+    }
+
+    void add(const Quadric& q) {
+
+        a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+        b2 += q.b2; bc += q.bc; bd += q.bd;
+        c2 += q.c2; cd += q.cd;
+        d2 += q.d2;
+
+    }
+
+    //Sum of Squared Distances from p to Every Accumulated Plane
+    double error(const glm::dvec3& p) const {
+
+        return a2 * p.x * p.x + 2 * ab * p.x * p.y + 2 * ac * p.x * p.z + 2 * ad * p.x
+            + b2 * p.y * p.y + 2 * bc * p.y * p.z + 2 * bd * p.y
+            + c2 * p.z * p.z + 2 * cd * p.z
+            + d2;
+
+    }
+
+};
+
+struct Collapse {
+
+    double cost;
+    uint32_t from;
+    uint32_t to;
+    uint32_t fromStamp; //Vertex Stamps When Queued, a Mismatch Means the Collapse is Stale
+    uint32_t toStamp;
+
+};
+
+struct CheaperFirst {
+    bool operator()(const Collapse& a, const Collapse& b) const { return a.cost > b.cost; }
+};
+
+static const double BORDER_WEIGHT = 10.0;    //Keeps Open Edges (Silhouettes of Thin Panels) from Eroding
+static const double MIN_FLIP_COSINE = 0.2;   //Reject Collapses that Turn a Triangle More than ~78 Degrees
+
+std::vector<unsigned int> simplifyMesh(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals,
+    const std::vector<unsigned int>& indices, size_t targetIndexCount) {
+
+    size_t vertexCount = positions.size();
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount * 3 <= targetIndexCount || vertexCount == 0) return indices;
+
+    //Weld Vertices that Share a Position, so Split Normals and UV Seams Collapse Together
+    std::vector<uint32_t> order(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++) order[i] = static_cast<uint32_t>(i);
+    std::sort(order.begin(), order.end(), [&positions](uint32_t a, uint32_t b) {
+        const glm::vec3& p = positions[a];
+        const glm::vec3& q = positions[b];
+        return p.x != q.x ? p.x < q.x : (p.y != q.y ? p.y < q.y : p.z < q.z);
+    });
+
+    std::vector<uint32_t> canonical(vertexCount);
+    std::vector<glm::dvec3> points;
+    std::vector<std::vector<uint32_t>> welded; //Original Vertices per Welded Vertex
+    for (size_t i = 0; i < vertexCount; i++) {
+        if (i == 0 || positions[order[i]] != positions[order[i - 1]]) {
+            points.push_back(glm::dvec3(positions[order[i]]));
+            welded.push_back(std::vector<uint32_t>());
+        }
+        canonical[order[i]] = static_cast<uint32_t>(points.size() - 1);
+        welded.back().push_back(order[i]);
+    }
+
+    size_t pointCount = points.size();
+
+    //Triangles in Welded Indices (Degenerate Ones Dropped Up Front)
+    std::vector<uint32_t> triangles;
+    std::vector<uint32_t> sourceTriangles; //Original Index Triples, Used to Pick Output Vertices
+    triangles.reserve(triangleCount * 3);
+    for (size_t t = 0; t < triangleCount; t++) {
+        uint32_t a = canonical[indices[t * 3]], b = canonical[indices[t * 3 + 1]], c = canonical[indices[t * 3 + 2]];
+        if (a == b || b == c || a == c) continue;
+        triangles.push_back(a); triangles.push_back(b); triangles.push_back(c);
+        sourceTriangles.push_back(indices[t * 3]); sourceTriangles.push_back(indices[t * 3 + 1]); sourceTriangles.push_back(indices[t * 3 + 2]);
+    }
+    triangleCount = triangles.size() / 3;
+
+    //Plane Quadrics Weighted by Area, and Triangle Adjacency per Vertex
+    std::vector<Quadric> quadrics(pointCount);
+    std::vector<std::vector<uint32_t>> vertexTriangles(pointCount);
+    for (size_t t = 0; t < triangleCount; t++) {
+        const glm::dvec3& p0 = points[triangles[t * 3]];
+        glm::dvec3 cross = glm::cross(points[triangles[t * 3 + 1]] - p0, points[triangles[t * 3 + 2]] - p0);
+        double length = glm::length(cross);
+        if (length > 0.0) {
+            glm::dvec3 normal = cross / length;
+            for (int k = 0; k < 3; k++) quadrics[triangles[t * 3 + k]].addPlane(normal, -glm::dot(normal, p0), length * 0.5);
+        }
+        for (int k = 0; k < 3; k++) vertexTriangles[triangles[t * 3 + k]].push_back(static_cast<uint32_t>(t));
+    }
+
+    //Border Edges Belong to One Triangle, so Only their Unordered Pair Count is Needed
+    std::vector<std::pair<uint64_t, uint32_t>> edges;
+    edges.reserve(triangleCount * 3);
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++) {
+            uint32_t a = triangles[t * 3 + k], b = triangles[t * 3 + (k + 1) % 3];
+            uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+            edges.push_back(std::make_pair(key, static_cast<uint32_t>(t)));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    for (size_t i = 0; i < edges.size(); i++) {
+        bool shared = (i > 0 && edges[i - 1].first == edges[i].first) || (i + 1 < edges.size() && edges[i + 1].first == edges[i].first);
+        if (shared) continue;
+
+        uint32_t a = static_cast<uint32_t>(edges[i].first >> 32), b = static_cast<uint32_t>(edges[i].first & 0xFFFFFFFFu);
+        uint32_t t = edges[i].second;
+        const glm::dvec3& p0 = points[triangles[t * 3]];
+        glm::dvec3 faceNormal = glm::cross(points[triangles[t * 3 + 1]] - p0, points[triangles[t * 3 + 2]] - p0);
+        glm::dvec3 edge = points[b] - points[a];
+        glm::dvec3 normal = glm::cross(edge, faceNormal);
+        double length = glm::length(normal);
+        if (length <= 0.0) continue;
+
+        normal /= length;
+        double weight = glm::dot(edge, edge) * BORDER_WEIGHT;
+        quadrics[a].addPlane(normal, -glm::dot(normal, points[a]), weight);
+        quadrics[b].addPlane(normal, -glm::dot(normal, points[a]), weight);
+    }
+
+    std::vector<uint32_t> stamps(pointCount, 0);
+    std::vector<uint32_t> collapsedInto(pointCount);
+    for (size_t i = 0; i < pointCount; i++) collapsedInto[i] = static_cast<uint32_t>(i);
+    std::vector<bool> removed(pointCount, false);
+    std::vector<bool> deadTriangle(triangleCount, false);
+    std::priority_queue<Collapse, std::vector<Collapse>, CheaperFirst> heap;
+
+    //Queue the Cheaper Direction of an Edge
+    auto pushEdge = [&](uint32_t a, uint32_t b) {
+        Quadric combined = quadrics[a];
+        combined.add(quadrics[b]);
+        double toB = combined.error(points[b]);
+        double toA = combined.error(points[a]);
+
+        Collapse collapse;
+        collapse.cost = std::min(toA, toB);
+        collapse.from = toB <= toA ? a : b;
+        collapse.to = toB <= toA ? b : a;
+        collapse.fromStamp = stamps[collapse.from];
+        collapse.toStamp = stamps[collapse.to];
+        heap.push(collapse);
+    };
+
+    for (size_t i = 0; i < edges.size(); i++) {
+        if (i > 0 && edges[i - 1].first == edges[i].first) continue;
+        pushEdge(static_cast<uint32_t>(edges[i].first >> 32), static_cast<uint32_t>(edges[i].first & 0xFFFFFFFFu));
+    }
+
+    size_t liveTriangles = triangleCount;
+    while (liveTriangles * 3 > targetIndexCount && !heap.empty()) {
+        Collapse collapse = heap.top();
+        heap.pop();
+
+        uint32_t from = collapse.from, to = collapse.to;
+        if (removed[from] || removed[to] || stamps[from] != collapse.fromStamp || stamps[to] != collapse.toStamp) continue;
+
+        //Moving 'from' onto 'to' Must not Flip or Flatten any Surviving Triangle
+        bool valid = true;
+        for (uint32_t t : vertexTriangles[from]) {
+            if (deadTriangle[t]) continue;
+            const uint32_t* corner = &triangles[t * 3];
+            if (corner[0] == to || corner[1] == to || corner[2] == to) continue;
+
+            glm::dvec3 before[3], after[3];
+            for (int k = 0; k < 3; k++) {
+                before[k] = points[corner[k]];
+                after[k] = corner[k] == from ? points[to] : points[corner[k]];
+            }
+
+            glm::dvec3 oldNormal = glm::cross(before[1] - before[0], before[2] - before[0]);
+            glm::dvec3 newNormal = glm::cross(after[1] - after[0], after[2] - after[0]);
+            double oldLength = glm::length(oldNormal), newLength = glm::length(newNormal);
+            if (newLength <= 0.0 || (oldLength > 0.0 && glm::dot(oldNormal, newNormal) < MIN_FLIP_COSINE * oldLength * newLength)) {
+                valid = false;
+                break;
+            }
+        }
+        if (!valid) continue;
+
+        //Collapse, Dropping Triangles that Contained the Edge
+        removed[from] = true;
+        collapsedInto[from] = to;
+        quadrics[to].add(quadrics[from]);
+        stamps[to]++;
+
+        for (uint32_t t : vertexTriangles[from]) {
+            if (deadTriangle[t]) continue;
+            uint32_t* corner = &triangles[t * 3];
+            for (int k = 0; k < 3; k++) {
+                if (corner[k] == from) corner[k] = to;
+            }
+
+            if (corner[0] == corner[1] || corner[1] == corner[2] || corner[0] == corner[2]) {
+                deadTriangle[t] = true;
+                liveTriangles--;
+            }
+            else {
+                vertexTriangles[to].push_back(t);
+            }
+        }
+        std::vector<uint32_t>().swap(vertexTriangles[from]);
+
+        //Compact the Survivor's Adjacency and Requeue its Edges w/ the Merged Quadric
+        std::vector<uint32_t>& adjacent = vertexTriangles[to];
+        adjacent.erase(std::remove_if(adjacent.begin(), adjacent.end(), [&deadTriangle](uint32_t t) { return deadTriangle[t]; }), adjacent.end());
+        std::sort(adjacent.begin(), adjacent.end());
+        adjacent.erase(std::unique(adjacent.begin(), adjacent.end()), adjacent.end());
+
+        for (uint32_t t : adjacent) {
+            for (int k = 0; k < 3; k++) {
+                uint32_t neighbour = triangles[t * 3 + k];
+                if (neighbour != to) pushEdge(to, neighbour);
+            }
+        }
+    }
+
+    //Map Surviving Corners Back to Original Vertices, Preferring the Welded Twin w/ the Closest Normal
+    auto resolve = [&collapsedInto](uint32_t v) {
+        while (collapsedInto[v] != v) {
+            collapsedInto[v] = collapsedInto[collapsedInto[v]];
+            v = collapsedInto[v];
+        }
+        return v;
+    };
+
+    std::vector<unsigned int> result;
+    result.reserve(liveTriangles * 3);
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (deadTriangle[t]) continue;
+
+        for (int k = 0; k < 3; k++) {
+            uint32_t source = sourceTriangles[t * 3 + k];
+            uint32_t target = resolve(canonical[source]);
+            if (target == canonical[source]) {
+                result.push_back(source);
+                continue;
+            }
+
+            const std::vector<uint32_t>& twins = welded[target];
+            uint32_t best = twins[0];
+            float bestDot = -2.0f;
+            for (uint32_t twin : twins) {
+                float d = normals.empty() ? 0.0f : glm::dot(normals[twin], normals[source]);
+                if (d > bestDot) {
+                    bestDot = d;
+                    best = twin;
+                }
+            }
+            result.push_back(best);
+        }
+    }
+
+    return result;
+
+}
@@ -1,4 +1,5 @@
 #include "Model.h"
+#include "Hash.h"
 
 //Attrib: Adapted from LearnOpenGL Model Loading Template, with some Alterations to Work for Embedded Textures and Instancing
 Model::Model(string const& path, bool gamma) : gammaCorrection(gamma) {
@@ -7,7 +8,33 @@ Model::Model(string const& path, bool gamma) : gammaCorrection(gamma) {
 
 }
 
-void Model::render(Shader& shader, bool instanced, size_t instanceCount) {
+Model::Model(vector<Mesh> meshes) : meshes(std::move(meshes)), gammaCorrection(false) {
+
+    computeBounds();
+
+    //Meshes Built from Other Models' Parts Share their Textures, so Hold a Reference of Our Own
+    for (const auto& mesh : this->meshes) {
+        for (const auto& texture : mesh.textures) {
+            bool held = false;
+            for (const auto& loaded : textures_loaded) {
+                held |= loaded.id == texture.id;
+            }
+            if (!held && TextureCache::retain(texture.id)) textures_loaded.push_back(texture);
+        }
+    }
+
+}
+
+void Model::releaseTextures() {
+
+    for (const auto& texture : textures_loaded) {
+        TextureCache::release(texture.id);
+    }
+    textures_loaded.clear();
+
+}
+
+void Model::render(Shader& shader, bool instanced, size_t instanceCount, int lod) {
     
     for (GLuint i = 0; i < meshes.size(); i++) {
         
@@ -31,12 +58,14 @@ void Model::render(Shader& shader, bool instanced, size_t instanceCount) {
 
         shader.setInt("useTexture", meshes[i].textures.empty() ? 0 : 2);
 
+        const void* firstIndex = (void*)(meshes[i].lodFirstIndex[lod] * sizeof(GLuint));
+
         glBindVertexArray(meshes[i].VAO);
         if (instanced) {
-            glDrawElementsInstanced(GL_TRIANGLES, meshes[i].indices.size(), GL_UNSIGNED_INT, 0, instanceCount);
+            glDrawElementsInstanced(GL_TRIANGLES, meshes[i].lodIndexCount[lod], GL_UNSIGNED_INT, firstIndex, instanceCount);
         }
         else {
-            glDrawElements(GL_TRIANGLES, meshes[i].indices.size(), GL_UNSIGNED_INT, 0);
+            glDrawElements(GL_TRIANGLES, meshes[i].lodIndexCount[lod], GL_UNSIGNED_INT, firstIndex);
         }
         glBindVertexArray(0);
     }
@@ -61,6 +90,22 @@ void Model::loadModel(string const& path) {
 
     processNode(scene->mRootNode, scene);
 
+    computeBounds();
+
+}
+
+void Model::computeBounds() {
+
+    //Bounds for Culling and Spatial Queries
+    bool first = true;
+    for (const auto& mesh : meshes) {
+        for (const auto& vertex : mesh.vertices) {
+            boundsMin = first ? vertex.Position : glm::min(boundsMin, vertex.Position);
+            boundsMax = first ? vertex.Position : glm::max(boundsMax, vertex.Position);
+            first = false;
+        }
+    }
+
 }
 
 void Model::processNode(aiNode* node, const aiScene* scene) {
@@ -174,9 +219,33 @@ vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type,
 
         cout << i << endl;
 
+        //Already Used by Another of this Model's Meshes
+        bool loaded = false;
+        for (const auto& texture : textures_loaded) {
+            if (texture.path == str.C_Str()) {
+                Texture shared = texture;
+                shared.type = typeName;
+                textures.push_back(shared);
+                loaded = true;
+                break;
+            }
+        }
+        if (loaded) continue;
+
         const aiTexture* embeddedTexture = scene->GetEmbeddedTexture(str.C_Str());
-        
+
+        Texture texture;
+        texture.type = typeName;
+        texture.path = str.C_Str();
+
         if (embeddedTexture) {
+
+            //Embedded Images have no Path Shared Between Files, so Key on the Image Bytes (Compressed Ones have mHeight 0)
+            size_t bytes = embeddedTexture->mHeight > 0 ? embeddedTexture->mWidth * embeddedTexture->mHeight * sizeof(aiTexel) : embeddedTexture->mWidth;
+            uint64_t hash = hashBytes(embeddedTexture->pcData, bytes);
+            string key = "embedded:" + std::to_string(hash) + ":" + std::to_string(embeddedTexture->mWidth) + "x" + std::to_string(embeddedTexture->mHeight);
+
+            texture.id = TextureCache::acquire(key, [embeddedTexture]() {
                 GLuint textureID;
                 glGenTextures(1, &textureID);
 
@@ -192,24 +261,20 @@ vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type,
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
                 glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-                Texture texture;
-                texture.id = textureID;
-                texture.type = typeName;
-                texture.path = str.C_Str();
-                textures.push_back(texture);
+                return textureID;
+            });
+
         }
         else { 
 
-            Texture texture;
-            texture.id = TextureFromFile(str.C_Str(), this->directory);
-            texture.type = typeName;
-            texture.path = str.C_Str();
+            texture.id = TextureCache::acquireFile(str.C_Str(), this->directory);
 
             cout << texture.path << endl;
 
-            textures.push_back(texture);
-
         }
+
+        textures.push_back(texture);
+        textures_loaded.push_back(texture);
     }
     return textures;
 
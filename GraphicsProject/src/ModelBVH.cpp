@@ -0,0 +1,179 @@
+#include "ModelBVH.h"
+
+#include <cmath>
+
+namespace {
+
+    //Attrib: Moller & Trumbore, Fast Minimum Storage Ray/Triangle Intersection. Two Sided, so Inward Rays Hit Too
+    bool rayTriangle(const BVHRay& ray, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, float& t) {
+
+        glm::vec3 edge1 = b - a, edge2 = c - a;
+        glm::vec3 p = glm::cross(ray.direction, edge2);
+        float determinant = glm::dot(edge1, p);
+        if (std::fabs(determinant) < 1e-12f) return false;
+
+        float inverse = 1.0f / determinant;
+        glm::vec3 s = ray.origin - a;
+        float u = glm::dot(s, p) * inverse;
+        if (u < 0.0f || u > 1.0f) return false;
+
+        glm::vec3 q = glm::cross(s, edge1);
+        float v = glm::dot(ray.direction, q) * inverse;
+        if (v < 0.0f || u + v > 1.0f) return false;
+
+        t = glm::dot(edge2, q) * inverse;
+        return t >= 0.0f;
+
+    }
+
+    //Projections of the Triangle and Box onto an Axis Don't Overlap
+    bool separated(const glm::vec3& axis, const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2, const glm::vec3& halfSize) {
+
+        float p0 = glm::dot(v0, axis), p1 = glm::dot(v1, axis), p2 = glm::dot(v2, axis);
+        float radius = halfSize.x * std::fabs(axis.x) + halfSize.y * std::fabs(axis.y) + halfSize.z * std::fabs(axis.z);
+        return std::fmin(p0, std::fmin(p1, p2)) > radius || std::fmax(p0, std::fmax(p1, p2)) < -radius;
+
+    }
+
+    //Attrib: Akenine-Moller, Fast 3D Triangle-Box Overlap Testing (13 Separating Axes)
+    bool triangleBox(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& boxMin, const glm::vec3& boxMax) {
+
+        glm::vec3 centre = (boxMin + boxMax) * 0.5f, halfSize = (boxMax - boxMin) * 0.5f;
+        glm::vec3 v0 = a - centre, v1 = b - centre, v2 = c - centre;
+        glm::vec3 edges[3] = { v1 - v0, v2 - v1, v0 - v2 };
+
+        //Box Face Normals
+        for (int i = 0; i < 3; i++) {
+            glm::vec3 axis(0.0f);
+            axis[i] = 1.0f;
+            if (separated(axis, v0, v1, v2, halfSize)) return false;
+        }
+
+        //Triangle Normal
+        if (separated(glm::cross(edges[0], edges[1]), v0, v1, v2, halfSize)) return false;
+
+        //Edge Cross Products
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) {
+                glm::vec3 axis(0.0f);
+                axis[j] = 1.0f;
+                axis = glm::cross(edges[i], axis);
+                if (glm::dot(axis, axis) < 1e-12f) continue;
+                if (separated(axis, v0, v1, v2, halfSize)) return false;
+            }
+        }
+
+        return true;
+
+    }
+
+    //Attrib: Ericson, Real-Time Collision Detection 5.1.5 (Closest Point on Triangle to Point)
+    glm::vec3 closestOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+
+        glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+        float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+        if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+        glm::vec3 bp = p - b;
+        float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+        if (d3 >= 0.0f && d4 <= d3) return b;
+
+        float vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+
+        glm::vec3 cp = p - c;
+        float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+        if (d6 >= 0.0f && d5 <= d6) return c;
+
+        float vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+
+        float va = d3 * d6 - d5 * d4;
+        if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+        float denominator = 1.0f / (va + vb + vc);
+        return a + ab * (vb * denominator) + ac * (vc * denominator);
+
+    }
+
+}
+
+ModelBVH::ModelBVH(const std::vector<glm::vec3>& positions, const std::vector<unsigned int>& indices) {
+
+    size_t triangles = indices.size() / 3;
+    corners.reserve(triangles * 3);
+
+    std::vector<BVH4::Box> boxes;
+    boxes.reserve(triangles);
+    for (size_t i = 0; i < triangles; i++) {
+        const glm::vec3& a = positions[indices[i * 3]];
+        const glm::vec3& b = positions[indices[i * 3 + 1]];
+        const glm::vec3& c = positions[indices[i * 3 + 2]];
+        corners.push_back(a);
+        corners.push_back(b);
+        corners.push_back(c);
+
+        BVH4::Box box;
+        box.min = glm::min(a, glm::min(b, c));
+        box.max = glm::max(a, glm::max(b, c));
+        boxes.push_back(box);
+    }
+
+    tree.build(boxes);
+
+}
+
+bool ModelBVH::raycast(const BVHRay& ray, float& tMax, glm::vec3& normal) const {
+
+    bool hit = false;
+    tree.traverseRay(ray, tMax, [&](uint32_t triangle, float& limit) {
+        const glm::vec3* corner = &corners[triangle * 3];
+        float t;
+        if (rayTriangle(ray, corner[0], corner[1], corner[2], t) && t < limit) {
+            limit = t;
+            normal = glm::cross(corner[1] - corner[0], corner[2] - corner[0]);
+            hit = true;
+        }
+    });
+
+    //Face Towards the Ray so Back Face Hits Still Give a Usable Surface Normal
+    if (hit) {
+        normal = glm::normalize(normal);
+        if (glm::dot(normal, ray.direction) > 0.0f) normal = -normal;
+    }
+
+    return hit;
+
+}
+
+bool ModelBVH::overlaps(const glm::vec3& boxMin, const glm::vec3& boxMax) const {
+
+    bool found = false;
+    tree.traverseBox(boxMin, boxMax, [&](uint32_t triangle) {
+        if (found) return;
+        const glm::vec3* corner = &corners[triangle * 3];
+        found = triangleBox(corner[0], corner[1], corner[2], boxMin, boxMax);
+    });
+
+    return found;
+
+}
+
+bool ModelBVH::nearest(const glm::vec3& point, float& maxDistanceSq, glm::vec3& closest) const {
+
+    bool found = false;
+    tree.traversePoint(point, maxDistanceSq, [&](uint32_t triangle, float& limit) {
+        const glm::vec3* corner = &corners[triangle * 3];
+        glm::vec3 candidate = closestOnTriangle(point, corner[0], corner[1], corner[2]);
+        glm::vec3 offset = candidate - point;
+        float distanceSq = glm::dot(offset, offset);
+        if (distanceSq < limit) {
+            limit = distanceSq;
+            closest = candidate;
+            found = true;
+        }
+    });
+
+    return found;
+
+}
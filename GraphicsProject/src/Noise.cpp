@@ -0,0 +1,514 @@
+#include "Noise.h"
+
+#include <cmath>
+
+#ifdef NOISE_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+//Permutation Table from Ken Perlin's Paper, Repeated so Index + 1 Wraps Past 255. Without the Repeat, Lattice Lines
+//Every 256 Cells Hashed Differently from Either Side, Leaving Seams Once Terrain Spans the World Rather than One Chunk
+static const int p[512] = {
+    151, 160, 137,  91,  90,  15, 131,  13, 201,  95,  96,  53, 194, 233,   7, 225,
+    140,  36, 103,  30,  69, 142,   8,  99,  37, 240,  21,  10,  23, 190,   6, 148,
+    247, 120, 234,  75,   0,  26, 197,  62,  94, 252, 219, 203, 117,  35,  11,  32,
+     57, 177,  33,  88, 237, 149,  56,  87, 174,  20, 125, 136, 171, 168,  68, 175,
+     74, 165,  71, 134, 139,  48,  27, 166,  77, 146, 158, 231,  83, 111, 229, 122,
+     60, 211, 133, 230, 220, 105,  92,  41,  55,  46, 245,  40, 244, 102, 143,  54,
+     65,  25,  63, 161,   1, 216,  80,  73, 209,  76, 132, 187, 208,  89,  18, 169,
+    200, 196, 135, 130, 116, 188, 159,  86, 164, 100, 109, 198, 173, 186,   3,  64,
+     52, 217, 226, 250, 124, 123,   5, 202,  38, 147, 118, 126, 255,  82,  85, 212,
+    207, 206,  59, 227,  47,  16,  58,  17, 182, 189,  28,  42, 223, 183, 170, 213,
+    119, 248, 152,   2,  44, 154, 163,  70, 221, 153, 101, 155, 167,  43, 172,   9,
+    129,  22,  39, 253,  19,  98, 108, 110,  79, 113, 224, 232, 178, 185, 112, 104,
+    218, 246,  97, 228, 251,  34, 242, 193, 238, 210, 144,  12, 191, 179, 162, 241,
+     81,  51, 145, 235, 249,  14, 239, 107,  49, 192, 214,  31, 181, 199, 106, 157,
+    184,  84, 204, 176, 115, 121,  50,  45, 127,   4, 150, 254, 138, 236, 205,  93,
+    222, 114,  67,  29,  24,  72, 243, 141, 128, 195,  78,  66, 215,  61, 156, 180,
+    151, 160, 137,  91,  90,  15, 131,  13, 201,  95,  96,  53, 194, 233,   7, 225,
+    140,  36, 103,  30,  69, 142,   8,  99,  37, 240,  21,  10,  23, 190,   6, 148,
+    247, 120, 234,  75,   0,  26, 197,  62,  94, 252, 219, 203, 117,  35,  11,  32,
+     57, 177,  33,  88, 237, 149,  56,  87, 174,  20, 125, 136, 171, 168,  68, 175,
+     74, 165,  71, 134, 139,  48,  27, 166,  77, 146, 158, 231,  83, 111, 229, 122,
+     60, 211, 133, 230, 220, 105,  92,  41,  55,  46, 245,  40, 244, 102, 143,  54,
+     65,  25,  63, 161,   1, 216,  80,  73, 209,  76, 132, 187, 208,  89,  18, 169,
+    200, 196, 135, 130, 116, 188, 159,  86, 164, 100, 109, 198, 173, 186,   3,  64,
+     52, 217, 226, 250, 124, 123,   5, 202,  38, 147, 118, 126, 255,  82,  85, 212,
+    207, 206,  59, 227,  47,  16,  58,  17, 182, 189,  28,  42, 223, 183, 170, 213,
+    119, 248, 152,   2,  44, 154, 163,  70, 221, 153, 101, 155, 167,  43, 172,   9,
+    129,  22,  39, 253,  19,  98, 108, 110,  79, 113, 224, 232, 178, 185, 112, 104,
+    218, 246,  97, 228, 251,  34, 242, 193, 238, 210, 144,  12, 191, 179, 162, 241,
+     81,  51, 145, 235, 249,  14, 239, 107,  49, 192, 214,  31, 181, 199, 106, 157,
+    184,  84, 204, 176, 115, 121,  50,  45, 127,   4, 150, 254, 138, 236, 205,  93,
+    222, 114,  67,  29,  24,  72, 243, 141, 128, 195,  78,  66, 215,  61, 156, 180
+};
+
+//Attrib: Ken Perlin, Improving Noise (2002) for 6t^5 - 15t^4 + 10t^3
+static float fade(float t) {
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+//Linear Interpolation between a and b, with fade(...) output, t, as Interpolation Parameter
+static float lerp(float a, float b, float t) {
+
+    return a + t * (b - a);
+
+}
+
+//Gradient Calculations using Bit Manipulation
+static float grad(int hash, float x, float y) {
+
+    int h = hash & 15; //Get Last 4 bits for 16 Gradient Vector Combinations
+
+    float u = h < 8 ? x : y; //Use 3rd Bit to Determine if u Component of Gradient Vector will be x or y
+
+    float v = h < 4 ? y : x; //Use 2nd Bit to Determine if v Component of Gradient Vector will be x or y
+
+    return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v); //Use 1st and 2nd Bits to Detemine the Signs of u and v
+
+}
+
+float perlinNoise(float x, float y) {
+
+    //Integer Hashing
+
+    //Determining Grid Cells
+    int X = (int)floor(x) & 255;
+    int Y = (int)floor(y) & 255;
+
+    //Position Relative to Grid Cell
+    x -= floor(x);
+    y -= floor(y);
+
+    float u = fade(x);
+    float v = fade(y);
+
+    //Hashes for Grid Cell Corners
+    int A = p[X] + Y;
+    int AA = p[A];
+    int AB = p[A + 1];
+    int B = p[X + 1] + Y;
+    int BA = p[B];
+    int BB = p[B + 1];
+
+    return lerp(lerp(grad(p[AA], x, y), grad(p[BA], x - 1, y), u), lerp(grad(p[AB], x, y - 1), grad(p[BB], x - 1, y - 1), u), v);
+
+}
+
+
+//Attrib: F. Kenton Musgrave, 2 Procedural Fractal Terrains for Fractional Brownian Motion
+//More Octaves = More Detail, Persistance Acts Like a Decay Factor for Amplitude
+float octaveNoise(float x, float y, int octaves, float persistence) {
+
+    float total = 0.0f;
+    float frequency = 1.0f;
+    float amplitude = 1.0f;
+    float maxValue = 0.0f;
+
+    for (int i = 0; i < octaves; i++) {
+        total += perlinNoise(x * frequency, y * frequency) * amplitude;
+        maxValue += amplitude;
+        amplitude *= persistence;
+        frequency *= 2.0f;
+    }
+
+    return total / maxValue;
+
+}
+
+//Derivative of fade(...): 30t^4 - 60t^3 + 30t^2
+static float fadeDerivative(float t) {
+
+    return 30.0f * t * t * (t * (t - 2.0f) + 1.0f);
+
+}
+
+//The Gradient Vector grad(...) Dots w/ (x, y)
+static void gradVector(int hash, float& gx, float& gy) {
+
+    int h = hash & 15;
+    float su = (h & 1) == 0 ? 1.0f : -1.0f;
+    float sv = (h & 2) == 0 ? 1.0f : -1.0f;
+
+    gx = (h < 8 ? su : 0.0f) + (h < 4 ? 0.0f : sv);
+    gy = (h < 8 ? 0.0f : su) + (h < 4 ? sv : 0.0f);
+
+}
+
+//Attrib: Inigo Quilez, Value Noise Derivatives (the Same Expansion, w/ Gradient Corners in Place of Values)
+float perlinNoiseGradient(float x, float y, float* gradient) {
+
+    int X = (int)floor(x) & 255;
+    int Y = (int)floor(y) & 255;
+
+    x -= floor(x);
+    y -= floor(y);
+
+    float u = fade(x);
+    float v = fade(y);
+
+    int A = p[X] + Y;
+    int AA = p[A];
+    int AB = p[A + 1];
+    int B = p[X + 1] + Y;
+    int BA = p[B];
+    int BB = p[B + 1];
+
+    //Corner Contributions, Evaluated Exactly as in perlinNoise(...) so the Value is Bit Identical
+    float a = grad(p[AA], x, y);
+    float b = grad(p[BA], x - 1, y);
+    float c = grad(p[AB], x, y - 1);
+    float d = grad(p[BB], x - 1, y - 1);
+    float value = lerp(lerp(a, b, u), lerp(c, d, u), v);
+
+    //Corner Gradient Vectors, Blended Like the Values, Plus the Fade Curves' Slopes Across the Cell
+    float ga[2], gb[2], gc[2], gd[2];
+    gradVector(p[AA], ga[0], ga[1]);
+    gradVector(p[BA], gb[0], gb[1]);
+    gradVector(p[AB], gc[0], gc[1]);
+    gradVector(p[BB], gd[0], gd[1]);
+
+    float k1 = b - a, k2 = c - a, k3 = a - b - c + d;
+    gradient[0] = lerp(lerp(ga[0], gb[0], u), lerp(gc[0], gd[0], u), v) + fadeDerivative(x) * (k1 + k3 * v);
+    gradient[1] = lerp(lerp(ga[1], gb[1], u), lerp(gc[1], gd[1], u), v) + fadeDerivative(y) * (k2 + k3 * u);
+
+    return value;
+
+}
+
+float octaveNoiseGradient(float x, float y, int octaves, float persistence, float* gradient) {
+
+    float total = 0.0f;
+    float frequency = 1.0f;
+    float amplitude = 1.0f;
+    float maxValue = 0.0f;
+    float dx = 0.0f, dy = 0.0f;
+
+    //Each Octave's Slope Scales w/ its Frequency (Chain Rule Through x * frequency)
+    for (int i = 0; i < octaves; i++) {
+        float octave[2];
+        total += perlinNoiseGradient(x * frequency, y * frequency, octave) * amplitude;
+        dx += octave[0] * amplitude * frequency;
+        dy += octave[1] * amplitude * frequency;
+        maxValue += amplitude;
+        amplitude *= persistence;
+        frequency *= 2.0f;
+    }
+
+    gradient[0] = dx / maxValue;
+    gradient[1] = dy / maxValue;
+    return total / maxValue;
+
+}
+
+void octaveNoiseBatchScalar(const float* x, const float* y, size_t count, int octaves, float persistence, float* out) {
+
+    for (size_t i = 0; i < count; i++) {
+        out[i] = octaveNoise(x[i], y[i], octaves, persistence);
+    }
+
+}
+
+void octaveNoiseGradientBatchScalar(const float* x, const float* y, size_t count, int octaves, float persistence, float* out,
+    float* gradientX, float* gradientY) {
+
+    for (size_t i = 0; i < count; i++) {
+        float gradient[2];
+        out[i] = octaveNoiseGradient(x[i], y[i], octaves, persistence, gradient);
+        gradientX[i] = gradient[0];
+        gradientY[i] = gradient[1];
+    }
+
+}
+
+#ifdef NOISE_AVX2
+
+//Intrinsics are Compiled for AVX2 Per Function, so the Rest of the Program Still Runs on CPUs w/o it
+//(Only avx2 is Enabled, not fma, since a Fused Multiply Add Would Round Differently from the Scalar Path)
+#if defined(__GNUC__) || defined(__clang__)
+#define NOISE_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define NOISE_AVX2_TARGET
+#endif
+
+NOISE_AVX2_TARGET static inline __m256 fade8(__m256 t) {
+
+    __m256 inner = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(_mm256_mul_ps(t, _mm256_set1_ps(6.0f)), _mm256_set1_ps(15.0f))), _mm256_set1_ps(10.0f));
+    return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, t), t), inner);
+
+}
+
+NOISE_AVX2_TARGET static inline __m256 lerp8(__m256 a, __m256 b, __m256 t) {
+
+    return _mm256_add_ps(a, _mm256_mul_ps(t, _mm256_sub_ps(b, a)));
+
+}
+
+//Same Bit Tricks as grad(...), w/ the Selects as Blends and the Sign Flips as XORs of the Float Sign Bit
+NOISE_AVX2_TARGET static inline __m256 grad8(__m256i hash, __m256 x, __m256 y) {
+
+    __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+
+    __m256 useY = _mm256_castsi256_ps(_mm256_cmpgt_epi32(h, _mm256_set1_epi32(7)));
+    __m256 useX = _mm256_castsi256_ps(_mm256_cmpgt_epi32(h, _mm256_set1_epi32(3)));
+    __m256 u = _mm256_blendv_ps(x, y, useY);
+    __m256 v = _mm256_blendv_ps(y, x, useX);
+
+    __m256 signU = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31));
+    __m256 signV = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30));
+
+    return _mm256_add_ps(_mm256_xor_ps(u, signU), _mm256_xor_ps(v, signV));
+
+}
+
+NOISE_AVX2_TARGET static inline __m256 perlinNoise8(__m256 x, __m256 y) {
+
+    __m256 floorX = _mm256_floor_ps(x);
+    __m256 floorY = _mm256_floor_ps(y);
+
+    //Grid Cells
+    __m256i mask = _mm256_set1_epi32(255);
+    __m256i X = _mm256_and_si256(_mm256_cvttps_epi32(floorX), mask);
+    __m256i Y = _mm256_and_si256(_mm256_cvttps_epi32(floorY), mask);
+
+    //Position Relative to Grid Cell
+    x = _mm256_sub_ps(x, floorX);
+    y = _mm256_sub_ps(y, floorY);
+
+    __m256 u = fade8(x);
+    __m256 v = fade8(y);
+
+    //Hashes for Grid Cell Corners, Gathered from the Permutation Table
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i A = _mm256_add_epi32(_mm256_i32gather_epi32(p, X, 4), Y);
+    __m256i AA = _mm256_i32gather_epi32(p, A, 4);
+    __m256i AB = _mm256_i32gather_epi32(p, _mm256_add_epi32(A, one), 4);
+    __m256i B = _mm256_add_epi32(_mm256_i32gather_epi32(p, _mm256_add_epi32(X, one), 4), Y);
+    __m256i BA = _mm256_i32gather_epi32(p, B, 4);
+    __m256i BB = _mm256_i32gather_epi32(p, _mm256_add_epi32(B, one), 4);
+
+    __m256 xMinusOne = _mm256_sub_ps(x, _mm256_set1_ps(1.0f));
+    __m256 yMinusOne = _mm256_sub_ps(y, _mm256_set1_ps(1.0f));
+
+    __m256 bottom = lerp8(grad8(_mm256_i32gather_epi32(p, AA, 4), x, y), grad8(_mm256_i32gather_epi32(p, BA, 4), xMinusOne, y), u);
+    __m256 top = lerp8(grad8(_mm256_i32gather_epi32(p, AB, 4), x, yMinusOne), grad8(_mm256_i32gather_epi32(p, BB, 4), xMinusOne, yMinusOne), u);
+    return lerp8(bottom, top, v);
+
+}
+
+NOISE_AVX2_TARGET static inline __m256 fadeDerivative8(__m256 t) {
+
+    __m256 inner = _mm256_add_ps(_mm256_mul_ps(t, _mm256_sub_ps(t, _mm256_set1_ps(2.0f))), _mm256_set1_ps(1.0f));
+    return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(30.0f), t), t), inner);
+
+}
+
+//gradVector(...) for Eight Hashes: Each Component is a Signed One or Zero, Picked by the Same Bit Tests
+NOISE_AVX2_TARGET static inline void gradVector8(__m256i hash, __m256& gx, __m256& gy) {
+
+    __m256i h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 zero = _mm256_setzero_ps();
+    __m256 su = _mm256_xor_ps(one, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(1)), 31)));
+    __m256 sv = _mm256_xor_ps(one, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(2)), 30)));
+
+    __m256 atLeast8 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(h, _mm256_set1_epi32(7)));
+    __m256 atLeast4 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(h, _mm256_set1_epi32(3)));
+
+    gx = _mm256_add_ps(_mm256_blendv_ps(su, zero, atLeast8), _mm256_blendv_ps(zero, sv, atLeast4));
+    gy = _mm256_add_ps(_mm256_blendv_ps(zero, su, atLeast8), _mm256_blendv_ps(sv, zero, atLeast4));
+
+}
+
+//perlinNoiseGradient(...) for Eight Points, Term for Term, so Each Lane Rounds Exactly Like the Scalar Path
+NOISE_AVX2_TARGET static inline __m256 perlinNoiseGradient8(__m256 x, __m256 y, __m256& gradientX, __m256& gradientY) {
+
+    __m256 floorX = _mm256_floor_ps(x);
+    __m256 floorY = _mm256_floor_ps(y);
+
+    __m256i mask = _mm256_set1_epi32(255);
+    __m256i X = _mm256_and_si256(_mm256_cvttps_epi32(floorX), mask);
+    __m256i Y = _mm256_and_si256(_mm256_cvttps_epi32(floorY), mask);
+
+    x = _mm256_sub_ps(x, floorX);
+    y = _mm256_sub_ps(y, floorY);
+
+    __m256 u = fade8(x);
+    __m256 v = fade8(y);
+
+    __m256i one = _mm256_set1_epi32(1);
+    __m256i A = _mm256_add_epi32(_mm256_i32gather_epi32(p, X, 4), Y);
+    __m256i AA = _mm256_i32gather_epi32(p, _mm256_i32gather_epi32(p, A, 4), 4);
+    __m256i AB = _mm256_i32gather_epi32(p, _mm256_i32gather_epi32(p, _mm256_add_epi32(A, one), 4), 4);
+    __m256i B = _mm256_add_epi32(_mm256_i32gather_epi32(p, _mm256_add_epi32(X, one), 4), Y);
+    __m256i BA = _mm256_i32gather_epi32(p, _mm256_i32gather_epi32(p, B, 4), 4);
+    __m256i BB = _mm256_i32gather_epi32(p, _mm256_i32gather_epi32(p, _mm256_add_epi32(B, one), 4), 4);
+
+    __m256 xMinusOne = _mm256_sub_ps(x, _mm256_set1_ps(1.0f));
+    __m256 yMinusOne = _mm256_sub_ps(y, _mm256_set1_ps(1.0f));
+
+    __m256 a = grad8(AA, x, y);
+    __m256 b = grad8(BA, xMinusOne, y);
+    __m256 c = grad8(AB, x, yMinusOne);
+    __m256 d = grad8(BB, xMinusOne, yMinusOne);
+    __m256 value = lerp8(lerp8(a, b, u), lerp8(c, d, u), v);
+
+    __m256 gax, gay, gbx, gby, gcx, gcy, gdx, gdy;
+    gradVector8(AA, gax, gay);
+    gradVector8(BA, gbx, gby);
+    gradVector8(AB, gcx, gcy);
+    gradVector8(BB, gdx, gdy);
+
+    __m256 k1 = _mm256_sub_ps(b, a);
+    __m256 k2 = _mm256_sub_ps(c, a);
+    __m256 k3 = _mm256_add_ps(_mm256_sub_ps(_mm256_sub_ps(a, b), c), d);
+    gradientX = _mm256_add_ps(lerp8(lerp8(gax, gbx, u), lerp8(gcx, gdx, u), v), _mm256_mul_ps(fadeDerivative8(x), _mm256_add_ps(k1, _mm256_mul_ps(k3, v))));
+    gradientY = _mm256_add_ps(lerp8(lerp8(gay, gby, u), lerp8(gcy, gdy, u), v), _mm256_mul_ps(fadeDerivative8(y), _mm256_add_ps(k2, _mm256_mul_ps(k3, u))));
+
+    return value;
+
+}
+
+NOISE_AVX2_TARGET static void octaveNoiseGradientBatchAVX2(const float* x, const float* y, size_t count, int octaves, float persistence, float* out,
+    float* gradientX, float* gradientY) {
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 sampleX = _mm256_loadu_ps(x + i);
+        __m256 sampleY = _mm256_loadu_ps(y + i);
+
+        //Same Accumulation Order as octaveNoiseGradient(...)
+        __m256 total = _mm256_setzero_ps();
+        __m256 dx = _mm256_setzero_ps();
+        __m256 dy = _mm256_setzero_ps();
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+        float maxValue = 0.0f;
+
+        for (int octave = 0; octave < octaves; octave++) {
+            __m256 f = _mm256_set1_ps(frequency);
+            __m256 a = _mm256_set1_ps(amplitude);
+            __m256 octaveX, octaveY;
+            __m256 noise = perlinNoiseGradient8(_mm256_mul_ps(sampleX, f), _mm256_mul_ps(sampleY, f), octaveX, octaveY);
+            total = _mm256_add_ps(total, _mm256_mul_ps(noise, a));
+            dx = _mm256_add_ps(dx, _mm256_mul_ps(_mm256_mul_ps(octaveX, a), f));
+            dy = _mm256_add_ps(dy, _mm256_mul_ps(_mm256_mul_ps(octaveY, a), f));
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0f;
+        }
+
+        __m256 m = _mm256_set1_ps(maxValue);
+        _mm256_storeu_ps(out + i, _mm256_div_ps(total, m));
+        _mm256_storeu_ps(gradientX + i, _mm256_div_ps(dx, m));
+        _mm256_storeu_ps(gradientY + i, _mm256_div_ps(dy, m));
+    }
+
+    //Tail
+    octaveNoiseGradientBatchScalar(x + i, y + i, count - i, octaves, persistence, out + i, gradientX + i, gradientY + i);
+
+}
+
+NOISE_AVX2_TARGET static void octaveNoiseBatchAVX2(const float* x, const float* y, size_t count, int octaves, float persistence, float* out) {
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 sampleX = _mm256_loadu_ps(x + i);
+        __m256 sampleY = _mm256_loadu_ps(y + i);
+
+        //Same Accumulation Order as octaveNoise(...), so Every Lane Rounds Exactly Like the Scalar Path
+        __m256 total = _mm256_setzero_ps();
+        float frequency = 1.0f;
+        float amplitude = 1.0f;
+        float maxValue = 0.0f;
+
+        for (int octave = 0; octave < octaves; octave++) {
+            __m256 f = _mm256_set1_ps(frequency);
+            __m256 noise = perlinNoise8(_mm256_mul_ps(sampleX, f), _mm256_mul_ps(sampleY, f));
+            total = _mm256_add_ps(total, _mm256_mul_ps(noise, _mm256_set1_ps(amplitude)));
+            maxValue += amplitude;
+            amplitude *= persistence;
+            frequency *= 2.0f;
+        }
+
+        _mm256_storeu_ps(out + i, _mm256_div_ps(total, _mm256_set1_ps(maxValue)));
+    }
+
+    //Tail
+    octaveNoiseBatchScalar(x + i, y + i, count - i, octaves, persistence, out + i);
+
+}
+
+//Checked Once: the CPU has to Report AVX2, and the OS has to Save the YMM Registers on Context Switches
+static bool detectAVX2() {
+
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+
+}
+
+#endif
+
+static bool simdEnabled = true;
+
+bool noiseUsesAVX2() {
+
+#ifdef NOISE_AVX2
+    static const bool supported = detectAVX2();
+    return supported && simdEnabled;
+#else
+    return false;
+#endif
+
+}
+
+void setNoiseSIMD(bool enabled) {
+
+    simdEnabled = enabled;
+
+}
+
+void octaveNoiseBatch(const float* x, const float* y, size_t count, int octaves, float persistence, float* out) {
+
+#ifdef NOISE_AVX2
+    if (noiseUsesAVX2()) {
+        octaveNoiseBatchAVX2(x, y, count, octaves, persistence, out);
+        return;
+    }
+#endif
+
+    octaveNoiseBatchScalar(x, y, count, octaves, persistence, out);
+
+}
+
+void octaveNoiseGradientBatch(const float* x, const float* y, size_t count, int octaves, float persistence, float* out,
+    float* gradientX, float* gradientY) {
+
+#ifdef NOISE_AVX2
+    if (noiseUsesAVX2()) {
+        octaveNoiseGradientBatchAVX2(x, y, count, octaves, persistence, out, gradientX, gradientY);
+        return;
+    }
+#endif
+
+    octaveNoiseGradientBatchScalar(x, y, count, octaves, persistence, out, gradientX, gradientY);
+
+}
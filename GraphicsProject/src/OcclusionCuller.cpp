@@ -0,0 +1,244 @@
+#include "OcclusionCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OCCLUSION_USE_SSE2 1
+#endif
+
+//Corner Indices (Bit 0 = x, Bit 1 = y, Bit 2 = z) for the 12 Triangles of a Box
+static const int BOX_TRIANGLES[36] = {
+    0, 2, 6,  0, 6, 4,  //-x
+    1, 3, 7,  1, 7, 5,  //+x
+    0, 1, 5,  0, 5, 4,  //-y
+    2, 3, 7,  2, 7, 6,  //+y
+    0, 1, 3,  0, 3, 2,  //-z
+    4, 5, 7,  4, 7, 6   //+z
+};
+
+OcclusionCuller::OcclusionCuller()
+    : viewProjection(1.0f), depth(WIDTH * HEIGHT, 1.0f), tileMaxDepth(TILES_X * TILES_Y, 1.0f) {
+}
+
+void OcclusionCuller::beginFrame(const glm::mat4& viewProjection) {
+
+    this->viewProjection = viewProjection;
+    std::fill(depth.begin(), depth.end(), 1.0f);
+    std::fill(tileMaxDepth.begin(), tileMaxDepth.end(), 1.0f);
+
+    triangles.clear();
+    for (auto& bin : bins) {
+        bin.clear();
+    }
+
+}
+
+int OcclusionCuller::projectCorners(const glm::vec3& boxMin, const glm::vec3& boxMax, glm::vec3 corners[8]) const {
+
+    int behind = 0;
+    for (int i = 0; i < 8; i++) {
+        glm::vec4 world(
+            (i & 1) ? boxMax.x : boxMin.x,
+            (i & 2) ? boxMax.y : boxMin.y,
+            (i & 4) ? boxMax.z : boxMin.z,
+            1.0f);
+
+        glm::vec4 clip = viewProjection * world;
+        if (clip.w < 1e-3f) {
+            behind++;
+            continue;
+        }
+
+        //NDC to Pixel Coordinates, Depth Remapped to [0, 1]
+        float invW = 1.0f / clip.w;
+        corners[i] = glm::vec3(
+            (clip.x * invW * 0.5f + 0.5f) * WIDTH,
+            (clip.y * invW * 0.5f + 0.5f) * HEIGHT,
+            clip.z * invW * 0.5f + 0.5f);
+    }
+
+    return behind;
+
+}
+
+void OcclusionCuller::addOccluder(const glm::vec3& boxMin, const glm::vec3& boxMax) {
+
+    glm::vec3 corners[8];
+    if (projectCorners(boxMin, boxMax, corners) > 0) return;
+
+    for (int i = 0; i < 36; i += 3) {
+        setupTriangle(corners[BOX_TRIANGLES[i]], corners[BOX_TRIANGLES[i + 1]], corners[BOX_TRIANGLES[i + 2]]);
+    }
+
+}
+
+void OcclusionCuller::setupTriangle(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2) {
+
+    //Orient Counter Clockwise so Inside Pixels Have Non Negative Edge Functions
+    glm::vec3 a = v0, b = v1, c = v2;
+    float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (std::fabs(area) < 1e-6f) return;
+    if (area < 0.0f) {
+        std::swap(b, c);
+        area = -area;
+    }
+
+    Triangle triangle;
+    triangle.minX = std::max(0, static_cast<int>(std::floor(std::min(a.x, std::min(b.x, c.x)))));
+    triangle.maxX = std::min(WIDTH - 1, static_cast<int>(std::ceil(std::max(a.x, std::max(b.x, c.x)))));
+    triangle.minY = std::max(0, static_cast<int>(std::floor(std::min(a.y, std::min(b.y, c.y)))));
+    triangle.maxY = std::min(HEIGHT - 1, static_cast<int>(std::ceil(std::max(a.y, std::max(b.y, c.y)))));
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) return;
+
+    //Each Edge Function Weights the Opposite Vertex
+    triangle.A[0] = -(c.y - b.y); triangle.B[0] = c.x - b.x; triangle.C[0] = -(triangle.A[0] * b.x + triangle.B[0] * b.y);
+    triangle.A[1] = -(a.y - c.y); triangle.B[1] = a.x - c.x; triangle.C[1] = -(triangle.A[1] * c.x + triangle.B[1] * c.y);
+    triangle.A[2] = -(b.y - a.y); triangle.B[2] = b.x - a.x; triangle.C[2] = -(triangle.A[2] * a.x + triangle.B[2] * a.y);
+
+    //Depth is Affine in Screen Space
+    float invArea = 1.0f / area;
+    triangle.zA = (triangle.A[0] * a.z + triangle.A[1] * b.z + triangle.A[2] * c.z) * invArea;
+    triangle.zB = (triangle.B[0] * a.z + triangle.B[1] * b.z + triangle.B[2] * c.z) * invArea;
+    triangle.zC = (triangle.C[0] * a.z + triangle.C[1] * b.z + triangle.C[2] * c.z) * invArea;
+
+    //Bin by Bounding Box
+    uint32_t index = static_cast<uint32_t>(triangles.size());
+    triangles.push_back(triangle);
+    for (int by = triangle.minY / BIN_SIZE; by <= triangle.maxY / BIN_SIZE; by++) {
+        for (int bx = triangle.minX / BIN_SIZE; bx <= triangle.maxX / BIN_SIZE; bx++) {
+            bins[by * BINS_X + bx].push_back(index);
+        }
+    }
+
+}
+
+void OcclusionCuller::rasteriseTriangle(const Triangle& triangle, int binX, int binY) {
+
+    //Triangle Bounds Clipped to the Bin. Starting on a 4 Pixel Boundary Keeps Groups Inside the Bin (BIN_SIZE is a Multiple of 4)
+    int minX = std::max(triangle.minX, binX * BIN_SIZE) & ~3;
+    int maxX = std::min(triangle.maxX, (binX + 1) * BIN_SIZE - 1);
+    int minY = std::max(triangle.minY, binY * BIN_SIZE);
+    int maxY = std::min(triangle.maxY, (binY + 1) * BIN_SIZE - 1);
+
+    const float* A = triangle.A;
+    const float* B = triangle.B;
+    const float* C = triangle.C;
+
+    for (int y = minY; y <= maxY; y++) {
+        float py = y + 0.5f;
+        float* row = &depth[y * WIDTH];
+
+#ifdef OCCLUSION_USE_SSE2
+        const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 stepW0 = _mm_set1_ps(A[0] * 4.0f), stepW1 = _mm_set1_ps(A[1] * 4.0f), stepW2 = _mm_set1_ps(A[2] * 4.0f);
+        const __m128 stepZ = _mm_set1_ps(triangle.zA * 4.0f);
+
+        __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(minX)), offsets);
+        __m128 w0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[0]), px), _mm_set1_ps(B[0] * py + C[0]));
+        __m128 w1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[1]), px), _mm_set1_ps(B[1] * py + C[1]));
+        __m128 w2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[2]), px), _mm_set1_ps(B[2] * py + C[2]));
+        __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(triangle.zA), px), _mm_set1_ps(triangle.zB * py + triangle.zC));
+
+        for (int x = minX; x <= maxX; x += 4) {
+            __m128 inside = _mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_and_ps(_mm_cmpge_ps(w1, zero), _mm_cmpge_ps(w2, zero)));
+
+            //Keep the Nearer Depth Only Where the Pixel is Inside the Triangle
+            __m128 current = _mm_loadu_ps(row + x);
+            __m128 nearer = _mm_min_ps(current, z);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+
+            w0 = _mm_add_ps(w0, stepW0);
+            w1 = _mm_add_ps(w1, stepW1);
+            w2 = _mm_add_ps(w2, stepW2);
+            z = _mm_add_ps(z, stepZ);
+        }
+#else
+        for (int x = minX; x <= maxX; x++) {
+            float px = x + 0.5f;
+            float w0 = A[0] * px + B[0] * py + C[0];
+            float w1 = A[1] * px + B[1] * py + C[1];
+            float w2 = A[2] * px + B[2] * py + C[2];
+            if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
+
+            float z = triangle.zA * px + triangle.zB * py + triangle.zC;
+            if (z < row[x]) row[x] = z;
+        }
+#endif
+    }
+
+}
+
+void OcclusionCuller::finishOccluders() {
+
+    for (int by = 0; by < BINS_Y; by++) {
+        for (int bx = 0; bx < BINS_X; bx++) {
+            const std::vector<uint32_t>& bin = bins[by * BINS_X + bx];
+            for (uint32_t index : bin) {
+                rasteriseTriangle(triangles[index], bx, by);
+            }
+
+            //Farthest Depth in Each of the Bin's Tiles, so Tests can Reject Whole Tiles at Once (Untouched Bins Stay Clear)
+            if (bin.empty()) continue;
+            for (int ty = by * BIN_SIZE / TILE_SIZE; ty < (by + 1) * BIN_SIZE / TILE_SIZE; ty++) {
+                for (int tx = bx * BIN_SIZE / TILE_SIZE; tx < (bx + 1) * BIN_SIZE / TILE_SIZE; tx++) {
+                    float maxDepth = 0.0f;
+                    for (int y = ty * TILE_SIZE; y < (ty + 1) * TILE_SIZE; y++) {
+                        const float* row = &depth[y * WIDTH + tx * TILE_SIZE];
+                        for (int x = 0; x < TILE_SIZE; x++) {
+                            maxDepth = std::max(maxDepth, row[x]);
+                        }
+                    }
+                    tileMaxDepth[ty * TILES_X + tx] = maxDepth;
+                }
+            }
+        }
+    }
+
+}
+
+bool OcclusionCuller::isVisible(const glm::vec3& boxMin, const glm::vec3& boxMax) const {
+
+    //Boxes Entirely Behind the Camera are Culled, Boxes Crossing the Near Plane are Always Visible
+    glm::vec3 corners[8];
+    int behind = projectCorners(boxMin, boxMax, corners);
+    if (behind == 8) return false;
+    if (behind > 0) return true;
+
+    glm::vec3 lo = corners[0], hi = corners[0];
+    for (int i = 1; i < 8; i++) {
+        lo = glm::min(lo, corners[i]);
+        hi = glm::max(hi, corners[i]);
+    }
+
+    //Outside the View Frustum
+    if (hi.x < 0.0f || lo.x >= WIDTH || hi.y < 0.0f || lo.y >= HEIGHT || lo.z > 1.0f) return false;
+
+    int minX = std::max(0, static_cast<int>(std::floor(lo.x)));
+    int maxX = std::min(WIDTH - 1, static_cast<int>(std::floor(hi.x)));
+    int minY = std::max(0, static_cast<int>(std::floor(lo.y)));
+    int maxY = std::min(HEIGHT - 1, static_cast<int>(std::floor(hi.y)));
+    float nearest = lo.z;
+
+    //Visible as Soon as Any Covered Pixel's Occluder Depth is Farther than the Box's Nearest Point
+    for (int ty = minY / TILE_SIZE; ty <= maxY / TILE_SIZE; ty++) {
+        for (int tx = minX / TILE_SIZE; tx <= maxX / TILE_SIZE; tx++) {
+            if (tileMaxDepth[ty * TILES_X + tx] < nearest) continue;
+
+            int x0 = std::max(minX, tx * TILE_SIZE), x1 = std::min(maxX, (tx + 1) * TILE_SIZE - 1);
+            int y0 = std::max(minY, ty * TILE_SIZE), y1 = std::min(maxY, (ty + 1) * TILE_SIZE - 1);
+
+            for (int y = y0; y <= y1; y++) {
+                const float* row = &depth[y * WIDTH];
+                for (int x = x0; x <= x1; x++) {
+                    if (row[x] >= nearest) return true;
+                }
+            }
+        }
+    }
+
+    return false;
+
+}
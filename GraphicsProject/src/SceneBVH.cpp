@@ -0,0 +1,209 @@
+#include "SceneBVH.h"
+
+#include <algorithm>
+#include <cfloat>
+
+SceneBVH::SceneBVH(std::vector<std::shared_ptr<const ModelBVH>> models) : models(std::move(models)) {
+
+}
+
+void SceneBVH::setModels(std::vector<std::shared_ptr<const ModelBVH>> newModels) {
+
+    models = std::move(newModels);
+
+}
+
+void SceneBVH::insertChunk(const glm::ivec2& chunk, const std::vector<Instance>& instances) {
+
+    uint32_t* existing = chunkIndex.find(chunk);
+    uint32_t slot = existing ? *existing : static_cast<uint32_t>(chunks.size());
+    if (!existing) {
+        chunks.emplace_back();
+        chunkIndex[chunk] = slot;
+    }
+
+    ChunkEntry& entry = chunks[slot];
+    entry.position = chunk;
+    entry.instances.clear();
+    entry.buildingSlots.clear();
+    entry.instanceBounds.assign((instances.size() + 3) / 4, Box4());
+    entry.bounds.min = glm::vec3(FLT_MAX);
+    entry.bounds.max = glm::vec3(-FLT_MAX);
+
+    //World Space Instance Bounds, Packed Four to a SIMD Group
+    for (size_t i = 0; i < instances.size(); i++) {
+        const Instance& instance = instances[i];
+        if (instance.model >= models.size() || !models[instance.model] || models[instance.model]->triangleCount() == 0) continue;
+
+        const BVH4::Box& local = models[instance.model]->bounds();
+        glm::vec3 boundsMin = instance.position + local.min * instance.scale;
+        glm::vec3 boundsMax = instance.position + local.max * instance.scale;
+
+        size_t lane = entry.instances.size();
+        Box4& group = entry.instanceBounds[lane / 4];
+        group.minX[lane % 4] = boundsMin.x; group.minY[lane % 4] = boundsMin.y; group.minZ[lane % 4] = boundsMin.z;
+        group.maxX[lane % 4] = boundsMax.x; group.maxY[lane % 4] = boundsMax.y; group.maxZ[lane % 4] = boundsMax.z;
+
+        entry.bounds.min = glm::min(entry.bounds.min, boundsMin);
+        entry.bounds.max = glm::max(entry.bounds.max, boundsMax);
+        entry.instances.push_back(instance);
+        entry.buildingSlots.push_back(static_cast<uint32_t>(i));
+    }
+    entry.instanceBounds.resize((entry.instances.size() + 3) / 4);
+
+    topLevelDirty = true;
+
+}
+
+void SceneBVH::removeChunk(const glm::ivec2& chunk) {
+
+    uint32_t* found = chunkIndex.find(chunk);
+    if (!found) return;
+
+    //Swap the Last Chunk into the Hole
+    uint32_t slot = *found;
+    chunkIndex.erase(chunk);
+    if (slot + 1 != chunks.size()) {
+        chunks[slot] = std::move(chunks.back());
+        chunkIndex[chunks[slot].position] = slot;
+    }
+    chunks.pop_back();
+
+    topLevelDirty = true;
+
+}
+
+void SceneBVH::refreshTopLevel() const {
+
+    if (!topLevelDirty) return;
+
+    std::vector<BVH4::Box> boxes;
+    boxes.reserve(chunks.size());
+    for (const auto& chunk : chunks) boxes.push_back(chunk.bounds);
+
+    topLevel.build(boxes);
+    topLevelDirty = false;
+
+}
+
+int SceneBVH::laneMask(size_t group, size_t instanceCount) {
+
+    size_t lanes = std::min<size_t>(instanceCount - group * 4, 4);
+    return (1 << lanes) - 1;
+
+}
+
+bool SceneBVH::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RayHit& hit) const {
+
+    refreshTopLevel();
+
+    float length = glm::length(direction);
+    if (length <= 0.0f) return false;
+
+    BVHRay ray(origin, direction / length);
+    float tMax = maxDistance;
+    bool found = false;
+
+    topLevel.traverseRay(ray, tMax, [&](uint32_t chunkSlot, float& limit) {
+        const ChunkEntry& chunk = chunks[chunkSlot];
+
+        for (size_t group = 0; group < chunk.instanceBounds.size(); group++) {
+            float tEntry[4];
+            int mask = rayBox4(chunk.instanceBounds[group], ray, limit, tEntry) & laneMask(group, chunk.instances.size());
+
+            for (int lane = 0; lane < 4; lane++) {
+                if (!(mask & (1 << lane)) || tEntry[lane] > limit) continue;
+
+                //Into Model Space. Keeping the Direction Unscaled Makes Model Space t = World t / scale
+                const Instance& instance = chunk.instances[group * 4 + lane];
+                BVHRay local((ray.origin - instance.position) / instance.scale, ray.direction);
+                float localMax = limit / instance.scale;
+                glm::vec3 normal;
+
+                if (models[instance.model]->raycast(local, localMax, normal)) {
+                    limit = localMax * instance.scale;
+                    hit.building.chunk = chunk.position;
+                    hit.building.building = chunk.buildingSlots[group * 4 + lane];
+                    hit.distance = limit;
+                    hit.position = ray.origin + ray.direction * limit;
+                    hit.normal = normal;
+                    found = true;
+                }
+            }
+        }
+    });
+
+    return found;
+
+}
+
+size_t SceneBVH::overlap(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<BuildingRef>& results) const {
+
+    refreshTopLevel();
+
+    size_t before = results.size();
+    topLevel.traverseBox(boxMin, boxMax, [&](uint32_t chunkSlot) {
+        const ChunkEntry& chunk = chunks[chunkSlot];
+
+        for (size_t group = 0; group < chunk.instanceBounds.size(); group++) {
+            int mask = overlapBox4(chunk.instanceBounds[group], boxMin, boxMax) & laneMask(group, chunk.instances.size());
+
+            for (int lane = 0; lane < 4; lane++) {
+                if (!(mask & (1 << lane))) continue;
+
+                const Instance& instance = chunk.instances[group * 4 + lane];
+                glm::vec3 localMin = (boxMin - instance.position) / instance.scale;
+                glm::vec3 localMax = (boxMax - instance.position) / instance.scale;
+
+                if (models[instance.model]->overlaps(localMin, localMax)) {
+                    BuildingRef ref;
+                    ref.chunk = chunk.position;
+                    ref.building = chunk.buildingSlots[group * 4 + lane];
+                    results.push_back(ref);
+                }
+            }
+        }
+    });
+
+    return results.size() - before;
+
+}
+
+bool SceneBVH::nearest(const glm::vec3& point, float maxDistance, NearestHit& hit) const {
+
+    refreshTopLevel();
+
+    float maxDistanceSq = maxDistance * maxDistance;
+    bool found = false;
+
+    topLevel.traversePoint(point, maxDistanceSq, [&](uint32_t chunkSlot, float& limit) {
+        const ChunkEntry& chunk = chunks[chunkSlot];
+
+        for (size_t group = 0; group < chunk.instanceBounds.size(); group++) {
+            float distanceSq[4];
+            int mask = pointBox4(chunk.instanceBounds[group], point, limit, distanceSq) & laneMask(group, chunk.instances.size());
+
+            for (int lane = 0; lane < 4; lane++) {
+                if (!(mask & (1 << lane)) || distanceSq[lane] > limit) continue;
+
+                //Squared Distances Scale by scale^2 Between the Two Spaces
+                const Instance& instance = chunk.instances[group * 4 + lane];
+                glm::vec3 local = (point - instance.position) / instance.scale;
+                float localLimit = limit / (instance.scale * instance.scale);
+                glm::vec3 closest;
+
+                if (models[instance.model]->nearest(local, localLimit, closest)) {
+                    limit = localLimit * instance.scale * instance.scale;
+                    hit.building.chunk = chunk.position;
+                    hit.building.building = chunk.buildingSlots[group * 4 + lane];
+                    hit.position = instance.position + closest * instance.scale;
+                    found = true;
+                }
+            }
+        }
+    });
+
+    if (found) hit.distance = glm::length(hit.position - point);
+    return found;
+
+}
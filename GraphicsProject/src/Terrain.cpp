@@ -57,12 +57,12 @@ void Terrain::setupInstancedRendering(size_t maxInstances) {
     //Load Road Texture
     string textureDirectory = string(PROJECT_ROOT) + "/assets/textures/";
     char* texturePath = "road.jpg";
-    roadID = TextureFromFile(texturePath, textureDirectory);
+    roadID = TextureCache::acquireFile(texturePath, textureDirectory);
 
     //Load Sidewalk Texture
     textureDirectory = string(PROJECT_ROOT) + "/assets/textures/";
     texturePath = "sidewalk.jpg";
-    pathID = TextureFromFile(texturePath, textureDirectory);
+    pathID = TextureCache::acquireFile(texturePath, textureDirectory);
 
     std::size_t vec4Size = sizeof(glm::vec4); //Pre Calculate Size for Effiency
     for (int i = 0; i < 4; i++) {
@@ -117,268 +117,275 @@ void Terrain::deleteBuffers() {
     glDeleteBuffers(1, &terrainEBO);
     glDeleteBuffers(1, &instanceVBO);
 
-    glDeleteVertexArrays(1, &heightmapVAO);
-    glDeleteBuffers(1, &heightmapVBO);
-    glDeleteBuffers(1, &heightmapEBO);
-    glDeleteBuffers(1, &heightmapNormal);
-    glDeleteBuffers(1, &heightmapUV);
-
-}
-
+    for (auto& entry : heightmapMeshes) {
+        deleteHeightmapMesh(entry.second);
+    }
+    heightmapMeshes.clear();
 
-//Perlin
+    for (auto& entry : heightmapStrips) {
+        glDeleteBuffers(1, &entry.second);
+    }
+    heightmapStrips.clear();
 
-std::vector<float> Terrain::generateHeightMap(int resolution) {
+    if (grassID) {
+        TextureCache::release(grassID);
+        grassID = 0;
+    }
 
-    std::vector<float> heightMap(resolution * resolution);
+    if (roadID) {
+        TextureCache::release(roadID);
+        TextureCache::release(pathID);
+        roadID = pathID = 0;
+    }
 
-    //Random Offsets for Variety
-    float offsetX = static_cast<float>(rand()) / RAND_MAX * 1000.0f;
-    float offsetY = static_cast<float>(rand()) / RAND_MAX * 1000.0f;
+}
 
+uint64_t Terrain::heightmapKey(uint32_t seed, int resolution) {
 
-    //Height Values at Grid Points
-    for (int y = 0; y < resolution; y++) {
-        for (int x = 0; x < resolution; x++) {
+    return (static_cast<uint64_t>(seed) << 32) | static_cast<uint32_t>(resolution);
 
-            //Scale Points to get Noise Frequency in octaveNoise(...)
-            float sampleX = (x + offsetX) * 0.03f;
-            float sampleY = (y + offsetY) * 0.03f;
+}
 
-            float value = octaveNoise(sampleX, sampleY, 6, 0.5f);
-            value = value * value;
-            heightMap[y * resolution + x] = value * 100.0f;
-        }
-    }
+void Terrain::deleteHeightmapMesh(HeightmapMesh& mesh) {
 
-    return heightMap;
+    glDeleteVertexArrays(1, &mesh.VAO);
+    glDeleteBuffers(1, &mesh.VBO);
+    glDeleteBuffers(1, &mesh.EBO);
+    glDeleteBuffers(1, &mesh.normal);
+    glDeleteBuffers(1, &mesh.uv);
 
 }
 
-void Terrain::generateHeightmapMesh(int resolution) {
+bool Terrain::hasHeightmapMesh(uint32_t seed, int resolution) const {
 
-    string textureDirectory = string(PROJECT_ROOT) + "/assets/textures/";
-    char* texturePath = "grass.jpg";
-    grassID = TextureFromFile(texturePath, textureDirectory);
+    return heightmapMeshes.count(heightmapKey(seed, resolution)) != 0;
 
-    std::vector<float> heightMap = generateHeightMap(resolution);
-    std::vector<float> vertices;
-    std::vector<float> normals;
-    std::vector<float> uvs;
-    std::vector<unsigned int> indices;
-
-    float gridSize = 1000.0f / (resolution - 1);
-
-    for (int z = 0; z < resolution; z++) {
-        for (int x = 0; x < resolution; x++) {
+}
 
-            //Vertices
-            bool isEdge = (x == 0 || x == resolution - 1 || z == 0 || z == resolution - 1);
+void Terrain::releaseHeightmapMesh(uint32_t seed, int resolution) {
 
-            float xPos = x * gridSize - 500.0f;
+    auto found = heightmapMeshes.find(heightmapKey(seed, resolution));
+    if (found == heightmapMeshes.end()) return;
 
-            //Clamp Edges to Flat Plane Height
-            float yPos = isEdge ? -50.0f : heightMap[z * resolution + x] - 50.0f;
+    deleteHeightmapMesh(found->second);
+    heightmapMeshes.erase(found);
 
-            float zPos = z * gridSize - 500.0f;
+}
 
-            vertices.push_back(xPos);
-            vertices.push_back(yPos);
-            vertices.push_back(zPos);
-            //Vertices
+//New Cache Entry w/ No GL Objects Yet (the Least Recently Drawn Entry is Freed if the Cache is Full)
+Terrain::HeightmapMesh& Terrain::addHeightmapMesh(uint32_t seed, int resolution) {
 
+    if (!grassID) {
+        string textureDirectory = string(PROJECT_ROOT) + "/assets/textures/";
+        char* texturePath = "grass.jpg";
+        grassID = TextureCache::acquireFile(texturePath, textureDirectory);
+    }
 
-            //Normals
-            glm::vec3 normal(0.0f, 1.0f, 0.0f);
-            if (x > 0 && x < resolution - 1 && z > 0 && z < resolution - 1) {
-                float hL = heightMap[z * resolution + (x - 1)];
-                float hR = heightMap[z * resolution + (x + 1)];
-                float hD = heightMap[(z - 1) * resolution + x];
-                float hU = heightMap[(z + 1) * resolution + x];
+    //Free the Least Recently Drawn Mesh so GPU Memory Stays Bounded
+    if (heightmapMeshes.size() >= HEIGHTMAP_CACHE_SIZE) {
+        auto oldest = heightmapMeshes.begin();
+        for (auto entry = heightmapMeshes.begin(); entry != heightmapMeshes.end(); ++entry) {
+            if (entry->second.lastUsed < oldest->second.lastUsed) oldest = entry;
+        }
+        deleteHeightmapMesh(oldest->second);
+        heightmapMeshes.erase(oldest);
+    }
 
-                float scale = 0.5f * gridSize;
-                glm::vec3 tangent(2.0f * scale, hR - hL, 0.0f);
-                glm::vec3 bitangent(0.0f, hU - hD, 2.0f * scale);
-                normal = glm::normalize(glm::cross(tangent, bitangent));
-            }
+    HeightmapMesh& mesh = heightmapMeshes[heightmapKey(seed, resolution)];
+    mesh = HeightmapMesh();
+    mesh.indexCount = static_cast<unsigned int>(static_cast<size_t>(resolution - 1) * (resolution - 1) * 6);
+    mesh.lastUsed = ++heightmapClock;
+    mesh.tilesRemaining = 0;
+    mesh.mode = GL_TRIANGLES;
+    mesh.indexType = GL_UNSIGNED_INT;
+    return mesh;
 
-            normals.push_back(-normal.x);
-            normals.push_back(-normal.y);
-            normals.push_back(-normal.z);
-            //Normals
+}
 
+//Allocates Empty Buffers for the Spawn Chunk Mesh, Filled Tile by Tile through uploadHeightmapTile(...)
+//Revisits w/ the Same Seed and Resolution Reuse the Cached Buffers, so only the First Visit Pays for the Upload
+void Terrain::beginHeightmapMesh(uint32_t seed, int resolution) {
 
-            //UV Coordinates
-            uvs.push_back(float(x) / (resolution - 1) * 10.0f);
-            uvs.push_back(float(z) / (resolution - 1) * 10.0f);
-            //UV Coordinates
+    uint64_t key = heightmapKey(seed, resolution);
+    if (heightmapMeshes.count(key)) return;
 
-        }
-    }
+    HeightmapMesh& mesh = addHeightmapMesh(seed, resolution);
 
-    //Indices
-    for (int z = 0; z < resolution - 1; z++) {
-        for (int x = 0; x < resolution - 1; x++) {
-            unsigned int topLeft = z * resolution + x;
-            unsigned int bottomLeft = (z + 1) * resolution + x;
-            unsigned int topRight = topLeft + 1;
-            unsigned int bottomRight = bottomLeft + 1;
-
-            indices.push_back(topLeft);
-            indices.push_back(bottomLeft);
-            indices.push_back(topRight);
-
-            indices.push_back(topRight);
-            indices.push_back(bottomLeft);
-            indices.push_back(bottomRight);
-        }
-    }
+    size_t vertexCount = static_cast<size_t>(resolution) * resolution;
+    size_t indexCount = static_cast<size_t>(mesh.indexCount);
 
-    heightmapIndexCount = indices.size();
+    mesh.uploadedTiles.assign(HeightmapMesher::tileCount(resolution), false);
+    mesh.tilesRemaining = static_cast<int>(mesh.uploadedTiles.size());
 
     //Buffer Setup
-    glGenVertexArrays(1, &heightmapVAO);
-    glGenBuffers(1, &heightmapVBO);
-    glGenBuffers(1, &heightmapEBO);
-    glGenBuffers(1, &heightmapNormal);
-    glGenBuffers(1, &heightmapUV);
+    glGenVertexArrays(1, &mesh.VAO);
+    glGenBuffers(1, &mesh.VBO);
+    glGenBuffers(1, &mesh.EBO);
+    glGenBuffers(1, &mesh.normal);
+    glGenBuffers(1, &mesh.uv);
 
-    glBindVertexArray(heightmapVAO);
+    glBindVertexArray(mesh.VAO);
 
     //Vertices
-    glBindBuffer(GL_ARRAY_BUFFER, heightmapVBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * 3 * sizeof(float), nullptr, GL_STATIC_DRAW);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, 0);
     glEnableVertexAttribArray(0);
 
     //Indices
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, heightmapEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(unsigned int), nullptr, GL_STATIC_DRAW);
 
     //Normals
-    glBindBuffer(GL_ARRAY_BUFFER, heightmapNormal);
-    glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(float), normals.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.normal);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * 3 * sizeof(float), nullptr, GL_STATIC_DRAW);
 
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 0, 0);
     glEnableVertexAttribArray(1);
 
     //UV Coordinates
-    glBindBuffer(GL_ARRAY_BUFFER, heightmapUV);
-    glBufferData(GL_ARRAY_BUFFER, uvs.size() * sizeof(float), uvs.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.uv);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * 2 * sizeof(float), nullptr, GL_STATIC_DRAW);
 
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 0, 0);
     glEnableVertexAttribArray(2);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
     //Buffer Setup
 
 }
 
-void Terrain::renderHeightmap(Shader& shader) {
+//Copies One Finished Tile into its Slice of Each Buffer. Tiles for a Mesh that's Been Released, or Already Uploaded, are Ignored
+void Terrain::uploadHeightmapTile(uint32_t seed, const HeightmapMesher::MeshData& data, int tile) {
 
-    shader.use();
-    shader.setInt("useTexture", 1);
+    auto found = heightmapMeshes.find(heightmapKey(seed, data.resolution));
+    if (found == heightmapMeshes.end()) return;
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, grassID);
+    HeightmapMesh& mesh = found->second;
+    if (tile < 0 || tile >= static_cast<int>(mesh.uploadedTiles.size()) || mesh.uploadedTiles[tile]) return;
 
-    glBindVertexArray(heightmapVAO);
-    glDrawElements(GL_TRIANGLES, heightmapIndexCount, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    HeightmapMesher::Tile range = HeightmapMesher::tile(data.resolution, tile);
 
-}
+    //Copy Write Target, so Uploading Indices Doesn't Need the VAO Bound
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.VBO);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, range.firstVertex * 3 * sizeof(float), range.vertexCount * 3 * sizeof(float), &data.vertices[range.firstVertex * 3]);
 
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.normal);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, range.firstVertex * 3 * sizeof(float), range.vertexCount * 3 * sizeof(float), &data.normals[range.firstVertex * 3]);
 
-//Noise Functions
+    glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.uv);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, range.firstVertex * 2 * sizeof(float), range.vertexCount * 2 * sizeof(float), &data.uvs[range.firstVertex * 2]);
 
-//Attrib: Ken Perlin, Improving Noise (2002) for 6t^5 - 15t^4 + 10t^3
-float Terrain::fade(float t) {
-    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
-}
+    if (range.indexCount > 0) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, mesh.EBO);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, range.firstIndex * sizeof(unsigned int), range.indexCount * sizeof(unsigned int), &data.indices[range.firstIndex]);
+    }
 
-//Linear Interpolation between a and b, with fade(...) output, t, as Interpolation Parameter
-float Terrain::lerp(float a, float b, float t) {
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
 
-    return a + t * (b - a);
+    mesh.uploadedTiles[tile] = true;
+    mesh.tilesRemaining--;
 
 }
 
-//Gradient Calculations using Bit Manipulation
-float Terrain::grad(int hash, float x, float y) {
+void Terrain::buildPackedHeightmapMesh(const HeightmapMesher::PackedMeshData& data, uint32_t seed) {
+
+    int resolution = data.resolution;
+    if (heightmapMeshes.count(heightmapKey(seed, resolution))) return;
+
+    HeightmapMesh& mesh = addHeightmapMesh(seed, resolution);
+    bool shortIndices = HeightmapMesher::shortStripIndices(resolution);
+
+    mesh.packed = true;
+    mesh.heightMin = data.heightMin;
+    mesh.heightRange = data.heightRange;
+    mesh.mode = GL_TRIANGLE_STRIP;
+    mesh.indexType = shortIndices ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    mesh.indexCount = static_cast<unsigned int>(static_cast<size_t>(resolution - 1) * (resolution * 2 + 1) - 1);
+
+    GLuint& strips = heightmapStrips[resolution];
+    if (!strips) {
+        std::vector<uint16_t> shortStrips;
+        std::vector<uint32_t> longStrips;
+        if (shortIndices) HeightmapMesher::stripIndices(resolution, shortStrips);
+        else HeightmapMesher::stripIndices(resolution, longStrips);
+
+        glGenBuffers(1, &strips);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, strips);
+        if (shortIndices) glBufferData(GL_COPY_WRITE_BUFFER, shortStrips.size() * sizeof(uint16_t), shortStrips.data(), GL_STATIC_DRAW);
+        else glBufferData(GL_COPY_WRITE_BUFFER, longStrips.size() * sizeof(uint32_t), longStrips.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    //Buffer Setup
+    glGenVertexArrays(1, &mesh.VAO);
+    glGenBuffers(1, &mesh.VBO);
+
+    glBindVertexArray(mesh.VAO);
 
-    int h = hash & 15; //Get Last 4 bits for 16 Gradient Vector Combinations
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+    glBufferData(GL_ARRAY_BUFFER, data.vertices.size() * sizeof(HeightmapMesher::PackedVertex), data.vertices.data(), GL_STATIC_DRAW);
 
-    float u = h < 8 ? x : y; //Use 3rd Bit to Determine if u Component of Gradient Vector will be x or y
+    //Quantised Height
+    glVertexAttribPointer(5, 1, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(HeightmapMesher::PackedVertex), (void*)offsetof(HeightmapMesher::PackedVertex, height));
+    glEnableVertexAttribArray(5);
 
-    float v = h < 4 ? y : x; //Use 2nd Bit to Determine if v Component of Gradient Vector will be x or y
+    //Octahedral Normal
+    glVertexAttribPointer(6, 2, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(HeightmapMesher::PackedVertex), (void*)offsetof(HeightmapMesher::PackedVertex, normal));
+    glEnableVertexAttribArray(6);
 
-    return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v); //Use 1st and 2nd Bits to Detemine the Signs of u and v
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, strips);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    //Buffer Setup
 
 }
 
-float Terrain::noise(float x, float y) {
-
-    // Permutation Table from Ken Perlin's Paper
-    static const int p[512] = {
-                      151, 160, 137,  91,  90,  15, 131,  13, 201,  95,  96,  53, 194, 233,   7, 225,
-                      140,  36, 103,  30,  69, 142,   8,  99,  37, 240,  21,  10,  23, 190,   6, 148,
-                      247, 120, 234,  75,   0,  26, 197,  62,  94, 252, 219, 203, 117,  35,  11,  32,
-                       57, 177,  33,  88, 237, 149,  56,  87, 174,  20, 125, 136, 171, 168,  68, 175,
-                       74, 165,  71, 134, 139,  48,  27, 166,  77, 146, 158, 231,  83, 111, 229, 122,
-                       60, 211, 133, 230, 220, 105,  92,  41,  55,  46, 245,  40, 244, 102, 143,  54,
-                       65,  25,  63, 161,   1, 216,  80,  73, 209,  76, 132, 187, 208,  89,  18, 169,
-                      200, 196, 135, 130, 116, 188, 159,  86, 164, 100, 109, 198, 173, 186,   3,  64,
-                       52, 217, 226, 250, 124, 123,   5, 202,  38, 147, 118, 126, 255,  82,  85, 212,
-                      207, 206,  59, 227,  47,  16,  58,  17, 182, 189,  28,  42, 223, 183, 170, 213,
-                      119, 248, 152,   2,  44, 154, 163,  70, 221, 153, 101, 155, 167,  43, 172,   9,
-                      129,  22,  39, 253,  19,  98, 108, 110,  79, 113, 224, 232, 178, 185, 112, 104,
-                      218, 246,  97, 228, 251,  34, 242, 193, 238, 210, 144,  12, 191, 179, 162, 241,
-                       81,  51, 145, 235, 249,  14, 239, 107,  49, 192, 214,  31, 181, 199, 106, 157,
-                      184,  84, 204, 176, 115, 121,  50,  45, 127,   4, 150, 254, 138, 236, 205,  93,
-                      222, 114,  67,  29,  24,  72, 243, 141, 128, 195,  78,  66, 215,  61, 156, 180
-    };
-
-    //Integer Hashing
-
-    //Determining Grid Cells
-    int X = (int)floor(x) & 255;
-    int Y = (int)floor(y) & 255;
-
-    //Position Relative to Grid Cell
-    x -= floor(x);
-    y -= floor(y);
-
-    float u = fade(x);
-    float v = fade(y);
-
-    //Hashes for Grid Cell Corners
-    int A = p[X] + Y;
-    int AA = p[A];
-    int AB = p[A + 1];
-    int B = p[X + 1] + Y;
-    int BA = p[B];
-    int BB = p[B + 1];
-
-    return lerp(lerp(grad(p[AA], x, y), grad(p[BA], x - 1, y), u), lerp(grad(p[AB], x, y - 1), grad(p[BB], x - 1, y - 1), u), v);
+bool Terrain::isHeightmapMeshReady(uint32_t seed, int resolution) const {
+
+    auto found = heightmapMeshes.find(heightmapKey(seed, resolution));
+    return found != heightmapMeshes.end() && found->second.tilesRemaining == 0;
 
 }
 
+void Terrain::renderHeightmap(Shader& shader, uint32_t seed, int resolution) {
+
+    //Meshes Still Streaming in are Skipped Until Every Tile has Landed
+    auto found = heightmapMeshes.find(heightmapKey(seed, resolution));
+    if (found == heightmapMeshes.end() || found->second.tilesRemaining > 0) return;
+
+    HeightmapMesh& mesh = found->second;
+    mesh.lastUsed = ++heightmapClock;
+
+    shader.use();
+    shader.setInt("useTexture", 1);
 
-//Attrib: F. Kenton Musgrave, 2 Procedural Fractal Terrains for Fractional Brownian Motion
-//More Octaves = More Detail, Persistance Acts Like a Decay Factor for Amplitude
-float Terrain::octaveNoise(float x, float y, int octaves, float persistence) {
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, grassID);
 
-    float total = 0.0f;
-    float frequency = 1.0f;
-    float amplitude = 1.0f;
-    float maxValue = 0.0f;
+    if (mesh.packed) {
+        shader.setInt("heightResolution", resolution);
+        shader.setFloat("heightMin", mesh.heightMin);
+        shader.setFloat("heightRange", mesh.heightRange);
+        shader.setInt("usePackedVertices", 1);
 
-    for (int i = 0; i < octaves; i++) {
-        total += noise(x * frequency, y * frequency) * amplitude;
-        maxValue += amplitude;
-        amplitude *= persistence;
-        frequency *= 2.0f;
+        glEnable(GL_PRIMITIVE_RESTART);
+        glPrimitiveRestartIndex(mesh.indexType == GL_UNSIGNED_SHORT ? 0xFFFF : 0xFFFFFFFFu);
     }
 
-    return total / maxValue;
+    glBindVertexArray(mesh.VAO);
+    glDrawElements(mesh.mode, mesh.indexCount, mesh.indexType, 0);
+    glBindVertexArray(0);
 
-}
\ No newline at end of file
+    //The Spire is Drawn w/ the Same Shader Straight After, from its Own Vertex Attributes
+    if (mesh.packed) {
+        glDisable(GL_PRIMITIVE_RESTART);
+        shader.setInt("usePackedVertices", 0);
+    }
+
+}
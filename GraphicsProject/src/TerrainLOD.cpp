@@ -0,0 +1,237 @@
+#include "TerrainLOD.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "Model.h"
+
+TerrainLOD::TerrainLOD(float chunkSize, int tileResolution, size_t maxTiles)
+    : lod(chunkSize, LEAF_RANGE), chunkSize(chunkSize), tileResolution(tileResolution), patchQuads(CDLOD::patchQuadsFor(tileResolution)), maxTiles(maxTiles) {
+
+    //Finest Level Splits a Chunk into 4^(LEVELS - 1) Nodes, so that Bounds the Nodes per Tile
+    maxNodes = maxTiles * (static_cast<size_t>(1) << (2 * (CDLOD::LEVELS - 1)));
+
+    //Patch Grid in [0, 1]^2 w/ 16 Bit Indices
+    std::vector<glm::vec2> grid;
+    std::vector<uint16_t> indices;
+    grid.reserve((patchQuads + 1) * (patchQuads + 1));
+    indices.reserve(patchQuads * patchQuads * 6);
+
+    for (int z = 0; z <= patchQuads; z++) {
+        for (int x = 0; x <= patchQuads; x++) {
+            grid.push_back(glm::vec2(x, z) / static_cast<float>(patchQuads));
+        }
+    }
+
+    //Same Winding as the Spawn Chunk Mesh
+    for (int z = 0; z < patchQuads; z++) {
+        for (int x = 0; x < patchQuads; x++) {
+            uint16_t topLeft = static_cast<uint16_t>(z * (patchQuads + 1) + x);
+            uint16_t bottomLeft = static_cast<uint16_t>((z + 1) * (patchQuads + 1) + x);
+            uint16_t topRight = topLeft + 1;
+            uint16_t bottomRight = bottomLeft + 1;
+
+            uint16_t quad[6] = { topLeft, bottomLeft, topRight, topRight, bottomLeft, bottomRight };
+            indices.insert(indices.end(), quad, quad + 6);
+        }
+    }
+    patchIndexCount = static_cast<GLsizei>(indices.size());
+
+    //Buffer Setup
+    glGenVertexArrays(1, &patchVAO);
+    glGenBuffers(1, &patchVBO);
+    glGenBuffers(1, &patchEBO);
+    glGenBuffers(1, &instanceVBO);
+
+    glBindVertexArray(patchVAO);
+
+    //Grid Positions
+    glBindBuffer(GL_ARRAY_BUFFER, patchVBO);
+    glBufferData(GL_ARRAY_BUFFER, grid.size() * sizeof(glm::vec2), grid.data(), GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    //Indices
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, patchEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+
+    //Node Instances
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, maxNodes * sizeof(NodeInstance), nullptr, GL_DYNAMIC_DRAW);
+
+    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(NodeInstance), (void*)offsetof(NodeInstance, node));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(NodeInstance), (void*)offsetof(NodeInstance, tile));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    //Buffer Setup
+
+    //Height Tiles
+    glGenTextures(1, &heightTiles);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, heightTiles);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R32F, tileResolution, tileResolution, static_cast<GLsizei>(maxTiles), 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    //Slope Tiles, Same Layers and Filtering
+    glGenTextures(1, &slopeTiles);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, slopeTiles);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RG16F, tileResolution, tileResolution, static_cast<GLsizei>(maxTiles), 0, GL_RG, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    for (size_t layer = maxTiles; layer > 0; layer--) {
+        freeLayers.push_back(static_cast<uint32_t>(layer - 1));
+    }
+
+    //Load Grass Texture
+    std::string textureDirectory = std::string(PROJECT_ROOT) + "/assets/textures/";
+    grassID = TextureCache::acquireFile("grass.jpg", textureDirectory);
+
+    nodes.reserve(maxNodes);
+    instances.reserve(maxNodes);
+
+}
+
+TerrainLOD::~TerrainLOD() {
+
+    glDeleteVertexArrays(1, &patchVAO);
+    glDeleteBuffers(1, &patchVBO);
+    glDeleteBuffers(1, &patchEBO);
+    glDeleteBuffers(1, &instanceVBO);
+    glDeleteTextures(1, &heightTiles);
+    glDeleteTextures(1, &slopeTiles);
+    TextureCache::release(grassID);
+
+}
+
+bool TerrainLOD::setTile(const glm::ivec2& chunk, const float* heights, int resolution, const float* normals) {
+
+    if (resolution != tileResolution) {
+        std::cout << "ERROR::TERRAIN_LOD:: Height tile is " << resolution << "^2, expected " << tileResolution << "^2" << std::endl;
+        return false;
+    }
+
+    uint32_t* existing = tileLayers.find(chunk);
+    if (!existing && freeLayers.empty()) {
+        std::cout << "ERROR::TERRAIN_LOD:: All " << maxTiles << " height tiles are in use" << std::endl;
+        return false;
+    }
+
+    uint32_t layer;
+    if (existing) {
+        layer = *existing;
+    }
+    else {
+        layer = freeLayers.back();
+        freeLayers.pop_back();
+        tileLayers[chunk] = layer;
+    }
+
+    //Edges Flattened (as the Spawn Chunk Mesh Always Did), so Bilinear Filtering Slopes Down to the Roads
+    std::vector<float> texels, slopes;
+    CDLOD::tileTexels(heights, normals, resolution, chunkSize, texels, slopes);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, heightTiles);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(layer), resolution, resolution, 1, GL_RED, GL_FLOAT, texels.data());
+    glBindTexture(GL_TEXTURE_2D_ARRAY, slopeTiles);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(layer), resolution, resolution, 1, GL_RG, GL_FLOAT, slopes.data());
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    lod.setTile(chunk, layer, texels.data(), resolution, BASE_HEIGHT);
+    return true;
+
+}
+
+void TerrainLOD::removeTile(const glm::ivec2& chunk) {
+
+    uint32_t* layer = tileLayers.find(chunk);
+    if (!layer) return;
+
+    freeLayers.push_back(*layer);
+    tileLayers.erase(chunk);
+    lod.removeTile(chunk);
+
+}
+
+void TerrainLOD::select(const glm::vec3& camera, const glm::mat4& viewProjection, const std::function<bool(const glm::ivec2&)>& include) {
+
+    selectedCamera = camera;
+    visibleNodes = lod.select(camera, viewProjection, include, nodes);
+
+    instances.clear();
+    for (const auto& node : nodes) {
+        NodeInstance instance;
+        glm::vec2 chunkMin = glm::vec2(node.chunk) * chunkSize - glm::vec2(chunkSize * 0.5f);
+        instance.node = glm::vec4(node.origin.x, node.origin.y, node.size, static_cast<float>(node.level));
+        instance.tile = glm::vec4(chunkMin.x, chunkMin.y, static_cast<float>(node.tile), 0.0f);
+        instances.push_back(instance);
+    }
+
+    if (instances.empty()) return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(NodeInstance), instances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+}
+
+void TerrainLOD::render(Shader& shader, bool shadowPass) {
+
+    size_t count = shadowPass ? instances.size() : visibleNodes;
+    if (count == 0) return;
+
+    shader.use();
+    shader.setVec3("cameraPosition", selectedCamera);
+    shader.setFloat("chunkSize", chunkSize);
+    shader.setFloat("tileResolution", static_cast<float>(tileResolution));
+    shader.setFloat("patchQuads", static_cast<float>(patchQuads));
+    shader.setFloat("baseHeight", BASE_HEIGHT);
+    for (int level = 0; level < CDLOD::LEVELS; level++) {
+        shader.setVec2("morphRanges[" + std::to_string(level) + "]", lod.morphRange(level));
+    }
+
+    //Height Tiles on GL_TEXTURE3, Slope Tiles on GL_TEXTURE4 (Depth Map is on GL_TEXTURE1)
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, heightTiles);
+    shader.setInt("heightTiles", 3);
+    if (!shadowPass) {
+        glActiveTexture(GL_TEXTURE4);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, slopeTiles);
+        shader.setInt("slopeTiles", 4);
+    }
+
+    if (!shadowPass) {
+        shader.setInt("useTexture", 1);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, grassID);
+        shader.setInt("textureSampler", 0);
+    }
+
+    glBindVertexArray(patchVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, patchIndexCount, GL_UNSIGNED_SHORT, 0, static_cast<GLsizei>(count));
+    glBindVertexArray(0);
+
+    glActiveTexture(GL_TEXTURE4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+}
@@ -0,0 +1,135 @@
+#include "TextureCache.h"
+#include "Model.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    struct Entry {
+        GLuint texture;
+        size_t references;
+    };
+
+    struct Cache {
+        std::unordered_map<std::string, Entry> entries;
+        std::unordered_map<GLuint, std::string> keys; //Texture to its Entry, for retain(...) and release(...)
+    };
+
+    //Built on First Use, so Static Initialisation Order Doesn't Matter
+    Cache& cache() {
+
+        static Cache instance;
+        return instance;
+
+    }
+
+}
+
+GLuint TextureCache::acquireFile(const std::string& path, const std::string& directory, bool gamma) {
+
+    //Same Path Join as TextureFromFile(...)
+    std::string key = canonicalPath(directory + '/' + path) + (gamma ? "|srgb" : "");
+    return acquire(key, [&]() { return TextureFromFile(path.c_str(), directory, gamma); });
+
+}
+
+GLuint TextureCache::acquire(const std::string& key, const std::function<GLuint()>& upload) {
+
+    Cache& state = cache();
+
+    auto found = state.entries.find(key);
+    if (found != state.entries.end()) {
+        found->second.references++;
+        return found->second.texture;
+    }
+
+    GLuint texture = upload();
+    if (!texture) return 0;
+
+    state.entries[key] = { texture, 1 };
+    state.keys[texture] = key;
+    return texture;
+
+}
+
+bool TextureCache::retain(GLuint texture) {
+
+    Cache& state = cache();
+
+    auto key = state.keys.find(texture);
+    if (key == state.keys.end()) return false;
+
+    state.entries[key->second].references++;
+    return true;
+
+}
+
+void TextureCache::release(GLuint texture) {
+
+    Cache& state = cache();
+
+    auto key = state.keys.find(texture);
+    if (key == state.keys.end()) {
+        std::cout << "ERROR::TEXTURE_CACHE:: Released texture " << texture << " is not cached" << std::endl;
+        return;
+    }
+
+    auto entry = state.entries.find(key->second);
+    if (--entry->second.references > 0) return;
+
+    glDeleteTextures(1, &texture);
+    state.entries.erase(entry);
+    state.keys.erase(key);
+
+}
+
+size_t TextureCache::textureCount() {
+
+    return cache().entries.size();
+
+}
+
+size_t TextureCache::referenceCount(GLuint texture) {
+
+    Cache& state = cache();
+
+    auto key = state.keys.find(texture);
+    return key == state.keys.end() ? 0 : state.entries[key->second].references;
+
+}
+
+std::string TextureCache::canonicalPath(const std::string& path) {
+
+    std::string unified = path;
+    for (auto& c : unified) {
+        if (c == '\\') c = '/';
+    }
+    bool absolute = !unified.empty() && unified[0] == '/';
+
+    //Walk the Segments, Dropping Empty and "." Ones and Folding ".." into its Parent (Leading ".." on Relative Paths are Kept)
+    std::vector<std::string> segments;
+    size_t start = 0;
+    while (start <= unified.size()) {
+        size_t end = unified.find('/', start);
+        if (end == std::string::npos) end = unified.size();
+        std::string segment = unified.substr(start, end - start);
+        start = end + 1;
+
+        if (segment.empty() || segment == ".") continue;
+        if (segment == ".." && !segments.empty() && segments.back() != "..") {
+            segments.pop_back();
+            continue;
+        }
+        if (segment == ".." && absolute) continue;
+        segments.push_back(segment);
+    }
+
+    std::string canonical = absolute ? "/" : "";
+    for (size_t i = 0; i < segments.size(); i++) {
+        if (i) canonical += '/';
+        canonical += segments[i];
+    }
+    return canonical;
+
+}
@@ -0,0 +1,102 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(size_t threads) {
+
+    if (threads == 0) {
+        size_t hardware = std::thread::hardware_concurrency();
+        threads = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    workers.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+
+}
+
+ThreadPool::~ThreadPool() {
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        tasks.clear();
+    }
+    wake.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+
+}
+
+void ThreadPool::work() {
+
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping) return;
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+
+    if (count == 0) return;
+
+    //Shared w/ the Helper Tasks, which may Only Get to Run After Every Index is Already Claimed
+    struct Batch {
+        std::atomic<size_t> next;
+        std::atomic<size_t> done;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>();
+    batch->next = 0;
+    batch->done = 0;
+
+    //body is Only Touched for Claimed Indices, and the Caller Can't Return Before Those Finish
+    const std::function<void(size_t)>* work = &body;
+    auto claim = [batch, work, count]() {
+        size_t index;
+        while ((index = batch->next++) < count) {
+            (*work)(index);
+            if (++batch->done == count) {
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                batch->finished.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(workers.size(), count - 1);
+    for (size_t i = 0; i < helpers; i++) {
+        submit(claim);
+    }
+
+    claim();
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->finished.wait(lock, [&batch, count]() { return batch->done == count; });
+
+}
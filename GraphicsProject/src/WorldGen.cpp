@@ -0,0 +1,146 @@
+#include "WorldGen.h"
+#include "Noise.h"
+
+#include <algorithm>
+
+WorldGen::WorldGen(const std::vector<float>& buildingWeights, uint32_t worldSeed) : worldSeed(worldSeed) {
+
+    setBuildingWeights(buildingWeights);
+
+}
+
+void WorldGen::setBuildingWeights(const std::vector<float>& buildingWeights) {
+
+    buildingTable.build(buildingWeights);
+
+}
+
+void WorldGen::generate(const glm::ivec2& position, Chunk& chunk) const {
+
+    chunk.position = position;
+    chunk.seed = chunkSeed(position);
+    chunk.buildings.clear();
+    chunk.heightMap.clear();
+    chunk.normalMap.clear();
+
+    //Set Aside Spawn/Origin Chunk for Perlin Noise Park
+    if (position == glm::ivec2(0, 0)) {
+        chunk.heightMap = generateHeightMap(worldSeed, position, HEIGHTMAP_RESOLUTION, pool, &chunk.normalMap);
+        return;
+    }
+
+    //Calculate Building Positions on a 3x3 Grid Within the Chunk
+    const float halfChunkSize = CHUNK_SIZE / 2.0f;
+    const float buildingOffset = (halfChunkSize - (ROAD_WIDTH / 2.0f)) * 0.75;
+
+    chunk.buildings.reserve(BUILDINGS_PER_CHUNK);
+    for (int x = -1; x <= 1; x++) {
+        for (int z = -1; z <= 1; z++) {
+            Building building;
+            float baseX = x == 0 ? 0 : (x > 0 ? buildingOffset : -buildingOffset);
+            float baseZ = z == 0 ? 0 : (z > 0 ? buildingOffset : -buildingOffset);
+            building.position = glm::vec3(baseX, -50.0f, baseZ);
+            building.rotation = 0.0f;
+
+            uint32_t slot = static_cast<uint32_t>((x + 1) * 3 + (z + 1));
+            building.modelIndex = selectBuilding(chunk.seed, slot);
+
+            chunk.buildings.push_back(building);
+        }
+    }
+
+}
+
+uint32_t WorldGen::chunkSeed(const glm::ivec2& position) {
+
+    //Seed Generation is Deterministic, Based on World Space Coords, so that Chunks can be Reconstructed Faithfully
+    return static_cast<uint32_t>(
+        static_cast<uint32_t>(position.x) * static_cast<uint32_t>(12345) +
+        static_cast<uint32_t>(position.y) * static_cast<uint32_t>(67890)
+        );
+
+}
+
+std::vector<float> WorldGen::generateHeightMap(uint32_t worldSeed, const glm::ivec2& chunk, int resolution, ThreadPool* pool, std::vector<float>* normals) {
+
+    std::vector<float> heightMap(resolution * resolution);
+    if (normals) normals->resize(heightMap.size() * 3);
+
+    //Domain Offset for Variety, Drawn from the World Seed so Every Chunk Samples the Same Noise Field
+    uint64_t random = splitmix64(worldSeed);
+    double offsetX = static_cast<double>(random & 0xFFFFFF) * (1000.0 / 16777216.0);
+    double offsetY = static_cast<double>((random >> 24) & 0xFFFFFF) * (1000.0 / 16777216.0);
+
+    double noiseStep = static_cast<double>(NOISE_FREQUENCY) * CHUNK_SIZE / (resolution - 1); //Noise Units per Grid Step
+
+    //Samples Sit on a World Grid Indexed by Integers (Counted from the Chunk's Minimum Corner), so a Border Shared by
+    //Two Chunks Gets the Same Coordinates, and so the Same Heights, from Either Side
+    int firstX = chunk.x * (resolution - 1);
+    int firstY = chunk.y * (resolution - 1);
+
+    //Scale Points to get Noise Frequency in octaveNoise(...). Columns Share their x Across Rows
+    std::vector<float> sampleX(resolution);
+    for (int x = 0; x < resolution; x++) {
+        sampleX[x] = static_cast<float>(offsetX + static_cast<double>(firstX + x) * noiseStep);
+    }
+
+    //Height Values at Grid Points, a Row at a Time. Rows are Independent, so Tiles of Rows Run in Parallel
+    auto generateTile = [&](size_t tile) {
+        std::vector<float> rowY(resolution), gradientX, gradientY;
+        if (normals) {
+            gradientX.resize(resolution);
+            gradientY.resize(resolution);
+        }
+        int rowStart = static_cast<int>(tile) * HEIGHTMAP_TILE_ROWS;
+        int rowEnd = std::min(rowStart + HEIGHTMAP_TILE_ROWS, resolution);
+
+        for (int y = rowStart; y < rowEnd; y++) {
+            std::fill(rowY.begin(), rowY.end(), static_cast<float>(offsetY + static_cast<double>(firstY + y) * noiseStep));
+
+            float* row = &heightMap[y * resolution];
+
+            //Value and Gradient Together. height = 100 * noise^2, so dh/dSample = 200 * noise * dNoise, and Samples are NOISE_FREQUENCY per World Unit
+            if (normals) {
+                float* rowNormals = &(*normals)[static_cast<size_t>(y) * resolution * 3];
+                float slopeScale = 200.0f * NOISE_FREQUENCY;
+
+                octaveNoiseGradientBatch(sampleX.data(), rowY.data(), resolution, 6, 0.5f, row, gradientX.data(), gradientY.data());
+                for (int x = 0; x < resolution; x++) {
+                    float value = row[x];
+                    glm::vec3 normal = glm::normalize(glm::vec3(-value * gradientX[x] * slopeScale, 1.0f, -value * gradientY[x] * slopeScale));
+
+                    rowNormals[x * 3] = normal.x;
+                    rowNormals[x * 3 + 1] = normal.y;
+                    rowNormals[x * 3 + 2] = normal.z;
+                }
+            }
+            else {
+                octaveNoiseBatch(sampleX.data(), rowY.data(), resolution, 6, 0.5f, row);
+            }
+
+            for (int x = 0; x < resolution; x++) {
+                float value = row[x];
+                value = value * value;
+                row[x] = value * 100.0f;
+            }
+        }
+    };
+
+    size_t tiles = static_cast<size_t>((resolution + HEIGHTMAP_TILE_ROWS - 1) / HEIGHTMAP_TILE_ROWS);
+    if (pool) {
+        pool->parallelFor(tiles, generateTile);
+    }
+    else {
+        for (size_t tile = 0; tile < tiles; tile++) generateTile(tile);
+    }
+
+    return heightMap;
+
+}
+
+size_t WorldGen::selectBuilding(uint32_t chunkSeed, uint32_t slot) const {
+
+    //Stateless Hash of Chunk Seed and Building Slot, so Selection is O(1) and Allocation Free
+    return buildingTable.sample(hashCombine(chunkSeed, slot));
+
+}
@@ -0,0 +1,30 @@
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//Attrib: Walker's Alias Method (w/ Vose's Construction) for O(1) Sampling from a Discrete Distribution
+class AliasTable {
+
+public:
+
+    AliasTable() = default;
+    explicit AliasTable(const std::vector<float>& weights);
+
+    void build(const std::vector<float>& weights);
+
+    //Maps a Uniformly Random 64 Bit Value to an Index, Without Allocating or Keeping RNG State
+    size_t sample(uint64_t random) const;
+
+    size_t size() const { return probability.size(); }
+
+private:
+
+    std::vector<float> probability;
+    std::vector<uint32_t> alias;
+
+};
+
+#endif
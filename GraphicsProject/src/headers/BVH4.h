@@ -0,0 +1,265 @@
+#ifndef BVH4_H
+#define BVH4_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define BVH4_SSE 1
+#include <xmmintrin.h>
+#endif
+
+//Four Axis Aligned Boxes Stored Structure of Arrays, so One SSE Instruction Tests an Axis of all Four
+struct Box4 {
+    float minX[4], minY[4], minZ[4];
+    float maxX[4], maxY[4], maxZ[4];
+};
+
+//Ray w/ Precomputed Inverse Direction (Zero Components are Nudged so the Slab Test Never Multiplies 0 by Infinity)
+struct BVHRay {
+
+    glm::vec3 origin;
+    glm::vec3 direction;
+    glm::vec3 inverseDirection;
+
+    BVHRay(const glm::vec3& origin, const glm::vec3& direction) : origin(origin), direction(direction) {
+
+        for (int i = 0; i < 3; i++) {
+            float d = direction[i];
+            if (d > -1e-20f && d < 1e-20f) d = d < 0.0f ? -1e-20f : 1e-20f;
+            inverseDirection[i] = 1.0f / d;
+        }
+
+    }
+
+};
+
+//Bit i Set if the Ray Enters Box i Within [0, tMax], Entry Distances Written to tEntry
+inline int rayBox4(const Box4& boxes, const BVHRay& ray, float tMax, float tEntry[4]) {
+
+#ifdef BVH4_SSE
+    __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.minX), _mm_set1_ps(ray.origin.x)), _mm_set1_ps(ray.inverseDirection.x));
+    __m128 t2x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.maxX), _mm_set1_ps(ray.origin.x)), _mm_set1_ps(ray.inverseDirection.x));
+    __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.minY), _mm_set1_ps(ray.origin.y)), _mm_set1_ps(ray.inverseDirection.y));
+    __m128 t2y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.maxY), _mm_set1_ps(ray.origin.y)), _mm_set1_ps(ray.inverseDirection.y));
+    __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.minZ), _mm_set1_ps(ray.origin.z)), _mm_set1_ps(ray.inverseDirection.z));
+    __m128 t2z = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(boxes.maxZ), _mm_set1_ps(ray.origin.z)), _mm_set1_ps(ray.inverseDirection.z));
+
+    __m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1x, t2x), _mm_min_ps(t1y, t2y)), _mm_max_ps(_mm_min_ps(t1z, t2z), _mm_setzero_ps()));
+    __m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(t1x, t2x), _mm_max_ps(t1y, t2y)), _mm_min_ps(_mm_max_ps(t1z, t2z), _mm_set1_ps(tMax)));
+
+    _mm_storeu_ps(tEntry, tNear);
+    return _mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+#else
+    int mask = 0;
+    for (int i = 0; i < 4; i++) {
+        float t1x = (boxes.minX[i] - ray.origin.x) * ray.inverseDirection.x, t2x = (boxes.maxX[i] - ray.origin.x) * ray.inverseDirection.x;
+        float t1y = (boxes.minY[i] - ray.origin.y) * ray.inverseDirection.y, t2y = (boxes.maxY[i] - ray.origin.y) * ray.inverseDirection.y;
+        float t1z = (boxes.minZ[i] - ray.origin.z) * ray.inverseDirection.z, t2z = (boxes.maxZ[i] - ray.origin.z) * ray.inverseDirection.z;
+        float tNear = glm::max(glm::max(glm::min(t1x, t2x), glm::min(t1y, t2y)), glm::max(glm::min(t1z, t2z), 0.0f));
+        float tFar = glm::min(glm::min(glm::max(t1x, t2x), glm::max(t1y, t2y)), glm::min(glm::max(t1z, t2z), tMax));
+        tEntry[i] = tNear;
+        if (tNear <= tFar) mask |= 1 << i;
+    }
+    return mask;
+#endif
+
+}
+
+//Bit i Set if Box i Overlaps [boxMin, boxMax]
+inline int overlapBox4(const Box4& boxes, const glm::vec3& boxMin, const glm::vec3& boxMax) {
+
+#ifdef BVH4_SSE
+    __m128 inside = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.minX), _mm_set1_ps(boxMax.x)), _mm_cmpge_ps(_mm_loadu_ps(boxes.maxX), _mm_set1_ps(boxMin.x)));
+    inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.minY), _mm_set1_ps(boxMax.y)), _mm_cmpge_ps(_mm_loadu_ps(boxes.maxY), _mm_set1_ps(boxMin.y))));
+    inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxes.minZ), _mm_set1_ps(boxMax.z)), _mm_cmpge_ps(_mm_loadu_ps(boxes.maxZ), _mm_set1_ps(boxMin.z))));
+    return _mm_movemask_ps(inside);
+#else
+    int mask = 0;
+    for (int i = 0; i < 4; i++) {
+        if (boxes.minX[i] <= boxMax.x && boxes.maxX[i] >= boxMin.x &&
+            boxes.minY[i] <= boxMax.y && boxes.maxY[i] >= boxMin.y &&
+            boxes.minZ[i] <= boxMax.z && boxes.maxZ[i] >= boxMin.z) mask |= 1 << i;
+    }
+    return mask;
+#endif
+
+}
+
+//Bit i Set if Box i is Within sqrt(maxDistanceSq) of a Point, Squared Distances Written to distanceSq
+inline int pointBox4(const Box4& boxes, const glm::vec3& point, float maxDistanceSq, float distanceSq[4]) {
+
+#ifdef BVH4_SSE
+    __m128 zero = _mm_setzero_ps();
+    __m128 px = _mm_set1_ps(point.x), py = _mm_set1_ps(point.y), pz = _mm_set1_ps(point.z);
+    __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(boxes.minX), px), _mm_sub_ps(px, _mm_loadu_ps(boxes.maxX))), zero);
+    __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(boxes.minY), py), _mm_sub_ps(py, _mm_loadu_ps(boxes.maxY))), zero);
+    __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(boxes.minZ), pz), _mm_sub_ps(pz, _mm_loadu_ps(boxes.maxZ))), zero);
+    __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+    _mm_storeu_ps(distanceSq, d2);
+    return _mm_movemask_ps(_mm_cmple_ps(d2, _mm_set1_ps(maxDistanceSq)));
+#else
+    int mask = 0;
+    for (int i = 0; i < 4; i++) {
+        float dx = glm::max(glm::max(boxes.minX[i] - point.x, point.x - boxes.maxX[i]), 0.0f);
+        float dy = glm::max(glm::max(boxes.minY[i] - point.y, point.y - boxes.maxY[i]), 0.0f);
+        float dz = glm::max(glm::max(boxes.minZ[i] - point.z, point.z - boxes.maxZ[i]), 0.0f);
+        distanceSq[i] = dx * dx + dy * dy + dz * dz;
+        if (distanceSq[i] <= maxDistanceSq) mask |= 1 << i;
+    }
+    return mask;
+#endif
+
+}
+
+//Four Wide Bounding Volume Hierarchy over Axis Aligned Boxes
+//Built by Binned SAH into a Binary Tree, then Collapsed so Each Node Holds up to Four Children Tested Together w/ SSE
+//Primitive Agnostic: Queries Hand Leaf Primitive Indices to a Callback, which Does the Exact Test. Needs no GL Context
+class BVH4 {
+
+public:
+
+    static constexpr int LEAF_SIZE = 4;  //Primitives per Leaf Once Splitting Stops Paying Off
+    static constexpr int MAX_LEAF = 16;  //Leaves are Split Regardless of SAH Above this
+    static constexpr int SAH_BINS = 12;
+    static constexpr int MAX_DEPTH = 48; //Bounds the Traversal Stack
+    static constexpr int STACK_SIZE = MAX_DEPTH * 3 + 4;
+
+    struct Box {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    void build(const std::vector<Box>& primitives);
+    void clear();
+
+    bool empty() const { return nodes.empty(); }
+    const Box& bounds() const { return rootBounds; }
+
+    //visit(primitive, tMax) Tests One Primitive and Shrinks tMax on a Hit. Children are Visited Nearest First
+    template <typename Visit>
+    void traverseRay(const BVHRay& ray, float& tMax, Visit visit) const;
+
+    //visit(primitive) for Every Primitive whose Box Overlaps [boxMin, boxMax]
+    template <typename Visit>
+    void traverseBox(const glm::vec3& boxMin, const glm::vec3& boxMax, Visit visit) const;
+
+    //visit(primitive, maxDistanceSq) for Primitives whose Box is in Range, Nearest First, Shrinking the Range as it Finds Closer Ones
+    template <typename Visit>
+    void traversePoint(const glm::vec3& point, float& maxDistanceSq, Visit visit) const;
+
+private:
+
+    struct Node {
+        Box4 bounds;
+        uint32_t first[4]; //Child Node Index, or First Slot in primitiveOrder for a Leaf
+        uint32_t count[4]; //Primitives in a Leaf, 0 for an Inner Child
+        int childMask;     //Occupied Child Slots
+    };
+
+    struct BinaryNode {
+        Box bounds;
+        uint32_t left, right;
+        uint32_t first, count; //count > 0 for Leaves
+    };
+
+    struct StackEntry {
+        uint32_t first;
+        uint32_t count;
+        float key; //Entry Distance (Rays) or Squared Distance (Points), for Pruning Once the Range Shrinks
+    };
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> primitiveOrder;
+    Box rootBounds;
+
+    uint32_t buildBinary(std::vector<BinaryNode>& binary, const std::vector<Box>& primitives,
+        const std::vector<glm::vec3>& centroids, uint32_t first, uint32_t count, int depth);
+    uint32_t collapse(const std::vector<BinaryNode>& binary, uint32_t index);
+
+    //Push the Selected Children of a Node, Farthest First so the Nearest is Popped Next
+    static void pushOrdered(const Node& node, int mask, const float keys[4], StackEntry* stack, int& top);
+
+};
+
+template <typename Visit>
+void BVH4::traverseRay(const BVHRay& ray, float& tMax, Visit visit) const {
+
+    if (nodes.empty()) return;
+
+    StackEntry stack[STACK_SIZE];
+    int top = 0;
+    stack[top++] = { 0, 0, 0.0f };
+
+    while (top > 0) {
+        StackEntry entry = stack[--top];
+        if (entry.key > tMax) continue;
+
+        if (entry.count > 0) {
+            for (uint32_t i = entry.first; i < entry.first + entry.count; i++) visit(primitiveOrder[i], tMax);
+            continue;
+        }
+
+        const Node& node = nodes[entry.first];
+        float tEntry[4];
+        int mask = rayBox4(node.bounds, ray, tMax, tEntry) & node.childMask;
+        pushOrdered(node, mask, tEntry, stack, top);
+    }
+
+}
+
+template <typename Visit>
+void BVH4::traverseBox(const glm::vec3& boxMin, const glm::vec3& boxMax, Visit visit) const {
+
+    if (nodes.empty()) return;
+
+    uint32_t stack[STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const Node& node = nodes[stack[--top]];
+        int mask = overlapBox4(node.bounds, boxMin, boxMax) & node.childMask;
+
+        for (int i = 0; i < 4; i++) {
+            if (!(mask & (1 << i))) continue;
+            if (node.count[i] > 0) {
+                for (uint32_t j = node.first[i]; j < node.first[i] + node.count[i]; j++) visit(primitiveOrder[j]);
+            }
+            else {
+                stack[top++] = node.first[i];
+            }
+        }
+    }
+
+}
+
+template <typename Visit>
+void BVH4::traversePoint(const glm::vec3& point, float& maxDistanceSq, Visit visit) const {
+
+    if (nodes.empty()) return;
+
+    StackEntry stack[STACK_SIZE];
+    int top = 0;
+    stack[top++] = { 0, 0, 0.0f };
+
+    while (top > 0) {
+        StackEntry entry = stack[--top];
+        if (entry.key > maxDistanceSq) continue;
+
+        if (entry.count > 0) {
+            for (uint32_t i = entry.first; i < entry.first + entry.count; i++) visit(primitiveOrder[i], maxDistanceSq);
+            continue;
+        }
+
+        const Node& node = nodes[entry.first];
+        float distanceSq[4];
+        int mask = pointBox4(node.bounds, point, maxDistanceSq, distanceSq) & node.childMask;
+        pushOrdered(node, mask, distanceSq, stack, top);
+    }
+
+}
+
+#endif
@@ -8,6 +8,8 @@
 #include <memory>
 #include "Shader.h"
 #include "Model.h"
+#include "Camera.h"
+#include "HeightField.h"
 
 class Boid {
 public:
@@ -82,14 +84,19 @@ public:
     ~BoidManager();
 
     void initialize(int numBoids, float spawnRadius);
-    void update(float deltaTime);
+    void update(float deltaTime, const Camera& camera, const HeightField* ground = nullptr); //Height Limits Follow the Ground When Given
     void render(Shader& shader);
 
 private:
 
     std::vector<Boid> boids;
-    std::vector<glm::mat4> modelMatrices;
+    std::vector<glm::mat4> modelMatrices; //Grouped by LOD, Each Group Contiguous
+    std::vector<glm::mat4> lodMatrices[Mesh::LOD_COUNT];
+    std::vector<glm::vec2> groundPoints; //Boid x/z, Queried Together Each Update
+    std::vector<float> groundHeights;
+    size_t lodFirstInstance[Mesh::LOD_COUNT] = {};
     std::shared_ptr<Model> boidModel;
+    float boidRadius = 1.0f;
     GLuint instanceVBO;
 
     //Parameters
@@ -104,6 +111,7 @@ private:
     glm::vec3 calculateSeparation(Boid& boid);
     glm::vec3 calculateAlignment(Boid& boid);
     glm::vec3 calculateCohesion(Boid& boid);
+    void setInstanceOffset(size_t firstInstance);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef BUILDING_ASSEMBLER_H
+#define BUILDING_ASSEMBLER_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Model.h"
+#include "Hash.h"
+
+//Procedural Buildings from the Modular City Kit Parts (Walls, Roof Tiles, Awnings, Signs)
+//Each Seed Picks a Footprint, Floor Count, Facade and Details, then Every Placed Part is Transformed and Welded into
+//One Mesh per Material Colour, so an Assembled Building Occupies a Single Range in the Building Arena Like any Other Model
+//Recipes are Hashed by Content, so Seeds that Produce the Same Building Share One Model (and One Draw)
+class BuildingAssembler {
+
+public:
+
+    static constexpr float CELL_SIZE = 0.4f; //Width and Height of a Wall Part
+    static constexpr int MIN_CELLS = 2;      //Footprint Cells per Side (2+ Keeps Roof Corners Well Defined)
+    static constexpr int MAX_CELLS = 4;
+    static constexpr int MIN_FLOORS = 2;
+    static constexpr int MAX_FLOORS = 8;
+    static constexpr int TINT_COUNT = 4;     //Facade Colours Swapped in for the Kit's Default Wall Material
+
+    //One Material's Triangles from a Kit Part
+    struct PartMesh {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec3> normals;
+        std::vector<unsigned int> indices;
+        glm::vec3 colour;
+    };
+
+    BuildingAssembler(const std::string& partsDirectory);
+
+    //Index of the Building this Seed Assembles, Reusing an Existing One When the Content Matches
+    size_t assemble(uint32_t seed);
+
+    const std::vector<std::shared_ptr<Model>>& buildings() const { return uniqueBuildings; }
+    uint64_t contentHash(size_t building) const { return buildingHashes[building]; }
+
+private:
+
+    enum Part {
+        WALL_SOLID, WALL_DOOR_A, WALL_DOOR_B,
+        WALL_WINDOW_A, WALL_WINDOW_B, WALL_WINDOW_C, WALL_WINDOW_D, WALL_WINDOW_E, WALL_WINDOW_F,
+        ROOF_CENTER, ROOF_SIDE, ROOF_CORNER,
+        DETAIL_AWNING, SIGN_BILLBOARD,
+        PART_COUNT
+    };
+
+    //Positions are in Half Cells so Cell Centres and Cell Edges are Both Whole Numbers, Keeping Recipes Exactly Hashable
+    //Faces Turn +z, +x, -z, -x for 0-3 Quarter Turns, Matching the Kit's +z Facing Parts
+    struct Placement {
+        uint32_t part;
+        int32_t x, y, z;
+        uint32_t quarterTurns;
+    };
+
+    struct Recipe {
+        std::vector<Placement> placements;
+        uint32_t tint;
+    };
+
+    std::vector<std::vector<PartMesh>> parts; //Indexed by Part, Empty if the File Failed to Load
+    std::vector<std::shared_ptr<Model>> uniqueBuildings;
+    std::vector<uint64_t> buildingHashes;
+    std::unordered_map<uint64_t, size_t> buildingIndex; //Content Hash to Unique Building
+
+    Recipe design(uint32_t seed) const;
+    uint64_t hashRecipe(const Recipe& recipe) const;
+    std::shared_ptr<Model> build(const Recipe& recipe) const;
+
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef BUILDING_BATCH_H
+#define BUILDING_BATCH_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "Shader.h"
+#include "Model.h"
+
+//Packs Every Building Model into One Shared Vertex/Index Arena so all Building Types
+//can be Drawn w/ a Single glMultiDrawElementsIndirect (GL 4.3+), or a Per Model BaseVertex Loop on GL 3.3
+//A Model's Meshes Merge into One Range per LOD, so Instances are Drawn in (Model, LOD) Groups of One Draw Each
+class BuildingBatch {
+
+public:
+
+    BuildingBatch(const std::vector<std::shared_ptr<Model>>& models, size_t maxInstances);
+    ~BuildingBatch();
+
+    //modelMatrices[model * Mesh::LOD_COUNT + lod] Holds the Instance Transforms Drawn at that LOD
+    void render(Shader& shader, const std::vector<std::vector<glm::mat4>>& modelMatrices);
+
+    //Draw One Instance of One Model w/ Whatever Shader is Bound (Used for Offline Baking)
+    void renderModel(size_t modelIndex, const glm::mat4& transform);
+
+    bool usesIndirect() const { return multiDrawElementsIndirect != nullptr; }
+
+private:
+
+    //Per Mesh Diffuse Colour is Baked into the Vertex, so Draws Need no Uniform Changes Between Meshes
+    struct BatchVertex {
+        glm::vec3 Position;
+        glm::vec3 Normal;
+        glm::vec3 Colour;
+    };
+
+    //Layout Fixed by the GL Spec for Indirect Draws
+    struct DrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    //Whole Model (Every Mesh) at Each LOD
+    struct MeshRange {
+        GLuint indexCount[Mesh::LOD_COUNT];
+        GLuint firstIndex[Mesh::LOD_COUNT];
+        GLint baseVertex;
+    };
+
+    typedef void (APIENTRYP MultiDrawElementsIndirectProc)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+
+    std::vector<MeshRange> modelRanges;
+    size_t maxInstances;
+
+    GLuint VAO, VBO, EBO, instanceVBO, indirectBuffer = 0;
+    MultiDrawElementsIndirectProc multiDrawElementsIndirect = nullptr;
+
+    //Reused Every Frame to Avoid Allocations
+    std::vector<glm::mat4> packedMatrices;
+    std::vector<GLuint> baseInstances; //Per (Model, LOD) Group
+    std::vector<DrawElementsIndirectCommand> commands;
+
+    void loadIndirectSupport();
+    void setInstanceOffset(size_t firstInstance);
+
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef CDLOD_H
+#define CDLOD_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "ChunkTable.h"
+
+//Continuous Distance Dependent LOD (Strugar, 2010) Node Selection over Chunks w/ Height Tiles
+//Each Chunk is a Quadtree LEVELS Deep (Level LEVELS - 1 is the Whole Chunk, Level 0 the Finest). Every Selected
+//Node is Drawn as the Same Grid Patch Scaled to the Node, and Vertices Morph onto the Next Coarser Grid as they
+//Approach the Edge of their Level's Range, so Neighbouring Levels Meet w/o Cracks or Popping
+//Only a Min/Max Height per Node is Kept Here, the Heights Themselves Live in the Renderer's Height Tiles. Needs no GL Context
+class CDLOD {
+
+public:
+
+    static constexpr int LEVELS = 4;
+    static constexpr float MORPH_START = 0.66f; //Fraction of a Level's Range Band Before Morphing Begins
+
+    struct Node {
+        glm::vec2 origin; //World Space Min Corner (x, z)
+        float size;
+        int level;
+        glm::ivec2 chunk;
+        uint32_t tile;    //Caller's Tile Index (Height Texture Layer)
+        glm::vec3 boundsMin, boundsMax;
+    };
+
+    //leafRange is the Distance Level 0 Reaches, Each Coarser Level Doubles it
+    CDLOD(float chunkSize, float leafRange);
+
+    //heights is a resolution^2 Grid Spanning the Chunk (Edge Samples Count as 0), World Height = Sample + baseHeight
+    void setTile(const glm::ivec2& chunk, uint32_t tile, const float* heights, int resolution, float baseHeight);
+    void removeTile(const glm::ivec2& chunk);
+    bool hasTile(const glm::ivec2& chunk) const { return tileIndex.find(chunk) != nullptr; }
+    size_t tileCount() const { return tiles.size(); }
+
+    //Nodes of Every Tile include(chunk) Accepts, w/ Nodes Inside the View Frustum Ordered First
+    //Returns how Many are Inside (the Main Pass Draws Those, the Shadow Pass Draws All)
+    size_t select(const glm::vec3& camera, const glm::mat4& viewProjection, const std::function<bool(const glm::ivec2&)>& include,
+        std::vector<Node>& nodes) const;
+
+    float range(int level) const { return ranges[level]; }
+
+    //Distances Between which a Level's Vertices Morph to the Next Level's Grid (x = Start, y = End)
+    glm::vec2 morphRange(int level) const;
+
+    //Node Size at a Level
+    float nodeSize(int level) const { return chunkSize / static_cast<float>(1 << (LEVELS - 1 - level)); }
+
+    //Quads per Side of the Shared Grid Patch, so a Leaf Node's Quads Match the Height Tile's Sample Spacing
+    //(Even, for Morphing, and 16 Bit Indexable)
+    static int patchQuadsFor(int tileResolution);
+
+    //A Height Tile's Texels: Heights w/ the Edge Samples Flattened to 0, and Slopes (dh/dx, dh/dz per Sample) that are Level
+    //on the Edges and Elsewhere Come from normals (xyz per Height, Pointing Up) When Given, Central Differences Otherwise
+    static void tileTexels(const float* heights, const float* normals, int resolution, float chunkSize, std::vector<float>& texels,
+        std::vector<float>& slopes);
+
+private:
+
+    struct Tile {
+        glm::ivec2 chunk;
+        uint32_t tile;
+        std::vector<glm::vec2> heightRange[LEVELS]; //World Min/Max Height per Node, Row Major, (1 << (LEVELS - 1 - level))^2 Nodes
+    };
+
+    float chunkSize;
+    float ranges[LEVELS];
+    std::vector<Tile> tiles;
+    ChunkTable<uint32_t> tileIndex; //Chunk to Slot in tiles
+
+    void nodeBounds(const Tile& tile, int level, int x, int z, glm::vec3& boxMin, glm::vec3& boxMax) const;
+    bool selectNode(const Tile& tile, int level, int x, int z, const glm::vec3& camera, std::vector<Node>& nodes) const;
+    void addNode(const Tile& tile, int level, int x, int z, std::vector<Node>& nodes) const;
+
+};
+
+#endif
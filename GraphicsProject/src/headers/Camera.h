@@ -51,9 +51,12 @@ public:
 
     Camera(glm::vec3 position = glm::vec3(0.0f, 0.0f, 0.0f), float near = 0.5f, float far = 2500.0f, unsigned int height = 1080, unsigned int width = 1920, glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f), float yaw = YAW, float pitch = PITCH);
 
-    glm::mat4 viewMatrix();
+    glm::mat4 viewMatrix() const;
 
-    glm::mat4 Camera::projectionMatrix();
+    glm::mat4 projectionMatrix() const;
+
+    //Projected Diameter of a Sphere as a Fraction of the Screen Height (1 When the Camera is Inside it)
+    float screenCoverage(const glm::vec3& centre, float radius) const;
 
     void processKeyboard(Camera_Movement direction);
 
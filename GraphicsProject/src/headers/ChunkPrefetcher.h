@@ -0,0 +1,65 @@
+#ifndef CHUNK_PREFETCHER_H
+#define CHUNK_PREFETCHER_H
+
+#include <glm/glm.hpp>
+#include <chrono>
+#include <queue>
+#include <vector>
+
+#include "ChunkTable.h"
+
+//Predicts which Chunks the Camera will Reach Soon from its Smoothed Velocity
+//Chunks are Queued by the Time they'll Enter the View Square, w/ Chunks Ahead of the Camera Coming First on Ties
+//Only Chunks Within reach (Chebyshev, in Chunks) of the Current Center are Planned, since the Owner Drops Anything Farther
+//Needs no GL Context, the Owner Decides how Many Requests to Serve per Frame
+class ChunkPrefetcher {
+
+public:
+
+    struct Request {
+        glm::ivec2 position;
+        float arrivalTime; //Seconds Until the Chunk Enters the View Square
+        float priority;    //Arrival Time Penalised for Chunks Off the Direction of Travel (Lower is Sooner)
+    };
+
+    ChunkPrefetcher(float chunkSize, int viewDistance, int reach, float horizon);
+
+    //Sample the Camera Position, Velocity is Measured Against the Previous Sample
+    void observe(const glm::vec3& position);
+
+    //Rebuild the Queue of Chunks Predicted to Enter the View Square Within the Horizon
+    void plan(const glm::ivec2& centerChunk);
+
+    //Pop the Most Urgent Request, False Once the Queue is Empty
+    bool next(Request& request);
+
+    void setHorizon(float seconds) { horizon = seconds; }
+    float getHorizon() const { return horizon; }
+    const glm::vec3& getVelocity() const { return velocity; }
+
+private:
+
+    struct LaterFirst {
+        bool operator()(const Request& a, const Request& b) const { return a.priority > b.priority; }
+    };
+
+    static constexpr float VELOCITY_SMOOTHING = 0.2f; //Weight of the Newest Sample in the Running Average
+    static constexpr float MIN_SPEED = 1.0f;          //World Units per Second, Slower Cameras Aren't Extrapolated
+    static constexpr float DIRECTION_PENALTY = 0.5f;  //Seconds Added to Chunks Directly Behind the Direction of Travel
+
+    float chunkSize;
+    int viewDistance;
+    int reach;
+    float horizon;
+
+    glm::vec3 lastPosition;
+    glm::vec3 velocity = glm::vec3(0.0f);
+    std::chrono::steady_clock::time_point lastSample;
+    bool hasSample = false;
+
+    std::priority_queue<Request, std::vector<Request>, LaterFirst> queue;
+    ChunkTable<float> arrivals; //Earliest Predicted Arrival of Each Chunk in the Current Plan
+
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef CHUNK_STORE_H
+#define CHUNK_STORE_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "ChunkTable.h"
+#include "MappedFile.h"
+
+//On Disk Cache of Generated Chunks, Grouped into Region Files of REGION_SIZE x REGION_SIZE Chunks
+//
+//Region File Layout (Little Endian, All Records 4 Byte Aligned):
+//  RegionHeader  : Magic, Format Version, Content Signature, Region Coords, Slot Table of (Offset, Size) per Chunk
+//  Chunk Blobs   : ChunkHeader, BuildingRecord[buildingCount], float Heights[heightResolution^2],
+//                  float Normals[heightResolution^2 * 3] (xyz per Height, Only When hasNormals)
+//
+//Blobs are Appended and Read Back Through a Memory Mapping, so Loaded Records are Used in Place Without Copying
+class ChunkStore {
+
+public:
+
+    static constexpr int REGION_SIZE = 16;
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    struct BuildingRecord {
+        float position[3];
+        float rotation;
+        uint32_t modelIndex;
+    };
+
+    //Points Directly into the Mapped Region File. Valid Until the Next save() into the Same Region
+    struct ChunkView {
+        glm::ivec2 position;
+        uint32_t seed;
+        const BuildingRecord* buildings;
+        uint32_t buildingCount;
+        const float* heights;
+        const float* normals; //Null When None were Saved
+        uint32_t heightResolution;
+    };
+
+    //Signature Should Change Whenever Generation Rules Change, which Invalidates Existing Region Files
+    ChunkStore(const std::string& directory, uint32_t contentSignature);
+
+    bool load(const glm::ivec2& position, ChunkView& view);
+    bool save(const glm::ivec2& position, uint32_t seed,
+        const BuildingRecord* buildings, uint32_t buildingCount,
+        const float* heights = nullptr, uint32_t heightResolution = 0, const float* normals = nullptr);
+
+private:
+
+    struct ChunkSlot {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    struct RegionHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t signature;
+        int32_t regionX;
+        int32_t regionZ;
+        uint32_t reserved;
+        ChunkSlot slots[REGION_SIZE * REGION_SIZE];
+    };
+
+    struct ChunkHeader {
+        int32_t x;
+        int32_t z;
+        uint32_t seed;
+        uint32_t buildingCount;
+        uint32_t heightResolution;
+        uint32_t hasNormals;
+    };
+
+    struct Region {
+        MappedFile file;
+        bool checked = false; //Mapping has Been Attempted Since the Last Write
+        bool valid = false;   //Header Matched Magic, Version and Signature
+    };
+
+    std::string directory;
+    uint32_t signature;
+    ChunkTable<std::unique_ptr<Region>> regions;
+
+    glm::ivec2 regionCoords(const glm::ivec2& position) const;
+    int slotIndex(const glm::ivec2& position) const;
+    std::string regionPath(const glm::ivec2& region) const;
+    Region& getRegion(const glm::ivec2& region);
+    const RegionHeader* mapRegion(const glm::ivec2& region);
+
+};
+
+#endif
@@ -0,0 +1,227 @@
+#ifndef CHUNK_TABLE_H
+#define CHUNK_TABLE_H
+
+#include <glm/glm.hpp>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Hash.h"
+
+//Well Mixed 2D Hash for Chunk Coordinates (Packs Both Axes then Runs SplitMix64, so Diagonals Don't Collide)
+inline uint64_t hashChunkCoords(const glm::ivec2& v) {
+
+    return splitmix64((static_cast<uint64_t>(static_cast<uint32_t>(v.x)) << 32) | static_cast<uint32_t>(v.y));
+
+}
+
+//Open Addressing Hash Table Keyed by Chunk Coordinates
+//Linear Probing over a Flat Key Array w/ Backward Shift Deletion, so there are no Node Allocations or Tombstones
+//(INT_MIN, INT_MIN) is Reserved as the Empty Key
+template <typename T>
+class ChunkTable {
+
+public:
+
+    struct Entry {
+        const glm::ivec2& first;
+        T& second;
+    };
+
+    class iterator {
+
+    public:
+
+        iterator(ChunkTable* table, size_t slot) : table(table), slot(slot) { skipEmpty(); }
+
+        Entry operator*() const { return Entry{ table->keys[slot], table->values[slot] }; }
+        iterator& operator++() { slot++; skipEmpty(); return *this; }
+        bool operator!=(const iterator& other) const { return slot != other.slot; }
+        bool operator==(const iterator& other) const { return slot == other.slot; }
+
+    private:
+
+        ChunkTable* table;
+        size_t slot;
+
+        void skipEmpty() {
+            while (slot < table->keys.size() && table->keys[slot] == EMPTY_KEY) slot++;
+        }
+
+    };
+
+    explicit ChunkTable(size_t expectedSize = 16) {
+
+        size_t capacity = 16;
+        while (capacity * MAX_LOAD_NUM < expectedSize * MAX_LOAD_DEN) capacity *= 2;
+        keys.assign(capacity, EMPTY_KEY);
+        values.resize(capacity);
+
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, keys.size()); }
+
+    T* find(const glm::ivec2& key) {
+
+        size_t slot = findSlot(key);
+        return slot == NOT_FOUND ? nullptr : &values[slot];
+
+    }
+
+    const T* find(const glm::ivec2& key) const {
+
+        return const_cast<ChunkTable*>(this)->find(key);
+
+    }
+
+    bool contains(const glm::ivec2& key) const { return find(key) != nullptr; }
+
+    //Returns the Existing Value, or Default Constructs One
+    T& operator[](const glm::ivec2& key) {
+
+        assert(key != EMPTY_KEY);
+
+        if ((count + 1) * MAX_LOAD_DEN > keys.size() * MAX_LOAD_NUM) {
+            rehash(keys.size() * 2);
+        }
+
+        size_t mask = keys.size() - 1;
+        size_t slot = static_cast<size_t>(hashChunkCoords(key)) & mask;
+
+        while (keys[slot] != EMPTY_KEY) {
+            if (keys[slot] == key) return values[slot];
+            slot = (slot + 1) & mask;
+        }
+
+        keys[slot] = key;
+        count++;
+        return values[slot];
+
+    }
+
+    bool erase(const glm::ivec2& key) {
+
+        size_t slot = findSlot(key);
+        if (slot == NOT_FOUND) return false;
+
+        eraseSlot(slot);
+        return true;
+
+    }
+
+    //Erase Every Entry the Predicate Accepts. The Predicate may Move out of the Value Before it's Erased,
+    //and may be Called Twice on Kept Entries that Wrap Around the End of the Table
+    template <typename Predicate>
+    size_t eraseIf(Predicate predicate) {
+
+        size_t erased = 0;
+        size_t slot = 0;
+
+        while (slot < keys.size()) {
+            if (keys[slot] != EMPTY_KEY && predicate(keys[slot], values[slot])) {
+
+                //Backward Shift Fills this Slot with a Later Entry, so Check it Again Before Moving On
+                eraseSlot(slot);
+                erased++;
+
+            }
+            else {
+                slot++;
+            }
+        }
+
+        return erased;
+
+    }
+
+    void clear() {
+
+        keys.assign(keys.size(), EMPTY_KEY);
+        for (auto& value : values) value = T();
+        count = 0;
+
+    }
+
+private:
+
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+    static constexpr size_t MAX_LOAD_NUM = 3; //Keep Load Factor at or Below 3/4 so Probe Sequences Stay Short
+    static constexpr size_t MAX_LOAD_DEN = 4;
+
+    static const glm::ivec2 EMPTY_KEY;
+
+    std::vector<glm::ivec2> keys; //Probed Separately from the Values so a Lookup Only Touches 8 Bytes per Slot
+    std::vector<T> values;
+    size_t count = 0;
+
+    size_t findSlot(const glm::ivec2& key) const {
+
+        size_t mask = keys.size() - 1;
+        size_t slot = static_cast<size_t>(hashChunkCoords(key)) & mask;
+
+        while (keys[slot] != EMPTY_KEY) {
+            if (keys[slot] == key) return slot;
+            slot = (slot + 1) & mask;
+        }
+
+        return NOT_FOUND;
+
+    }
+
+    void eraseSlot(size_t hole) {
+
+        size_t mask = keys.size() - 1;
+        size_t next = (hole + 1) & mask;
+
+        //Shift Following Entries Back Into the Hole Unless they Already Sit at or Before their Home Slot
+        while (keys[next] != EMPTY_KEY) {
+            size_t home = static_cast<size_t>(hashChunkCoords(keys[next])) & mask;
+
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                keys[hole] = keys[next];
+                values[hole] = std::move(values[next]);
+                hole = next;
+            }
+
+            next = (next + 1) & mask;
+        }
+
+        keys[hole] = EMPTY_KEY;
+        values[hole] = T();
+        count--;
+
+    }
+
+    void rehash(size_t capacity) {
+
+        std::vector<glm::ivec2> oldKeys(capacity, EMPTY_KEY);
+        std::vector<T> oldValues(capacity);
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+
+        size_t mask = capacity - 1;
+        for (size_t i = 0; i < oldKeys.size(); i++) {
+            if (oldKeys[i] == EMPTY_KEY) continue;
+
+            size_t slot = static_cast<size_t>(hashChunkCoords(oldKeys[i])) & mask;
+            while (keys[slot] != EMPTY_KEY) slot = (slot + 1) & mask;
+
+            keys[slot] = oldKeys[i];
+            values[slot] = std::move(oldValues[i]);
+        }
+
+    }
+
+};
+
+template <typename T>
+const glm::ivec2 ChunkTable<T>::EMPTY_KEY = glm::ivec2(INT_MIN, INT_MIN);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+//Main Thread Job Queue for GL Side Work (Chunk Builds, Mesh and Texture Uploads, Model Loads)
+//Subsystems Submit Jobs with a Priority, then runFrame() Drains them in Priority Order Until the Frame's
+//Millisecond Budget is Spent. Anything Left Over Waits for the Next Frame, so Streaming Never Spikes a Frame
+class FrameScheduler {
+
+public:
+
+    enum Priority {
+        CRITICAL = 0, //Always Run this Frame, Regardless of Budget (e.g. the Chunk the Camera is Standing in)
+        HIGH,
+        NORMAL,
+        LOW           //Speculative Work such as Prefetching
+    };
+
+    explicit FrameScheduler(float budgetMilliseconds = 4.0f);
+
+    void submit(std::function<void()> job, Priority priority = NORMAL);
+
+    //Budget is Checked Between Jobs, so a Single Long Job can Still Overrun it. At Least One Job Runs per Call
+    void runFrame();
+
+    void setBudget(float milliseconds) { budget = milliseconds; }
+    float getBudget() const { return budget; }
+    size_t pending() const { return jobs.size(); }
+    float lastFrameMilliseconds() const { return lastFrameTime; }
+
+private:
+
+    struct Job {
+        std::function<void()> work;
+        Priority priority;
+        uint64_t sequence; //Submission Order, so Equal Priorities Run First In First Out
+    };
+
+    struct RunsLater {
+        bool operator()(const Job& a, const Job& b) const {
+            return a.priority != b.priority ? a.priority > b.priority : a.sequence > b.sequence;
+        }
+    };
+
+    std::priority_queue<Job, std::vector<Job>, RunsLater> jobs;
+    uint64_t nextSequence = 0;
+    float budget;
+    float lastFrameTime = 0.0f;
+
+};
+
+#endif
@@ -4,41 +4,85 @@
 #include <glad/glad.h> 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <functional>
+#include <list>
 #include <memory>
-#include <unordered_map>
-#include <random>
+#include <mutex>
 #include <string>
 #include <vector>
 #include "Shader.h"
 #include "Model.h"
 #include "Camera.h"
 #include "Terrain.h"
+#include "WorldGen.h"
+#include "Hash.h"
+#include "ChunkTable.h"
+#include "ChunkStore.h"
+#include "BuildingBatch.h"
+#include "OcclusionCuller.h"
+#include "ChunkPrefetcher.h"
+#include "FrameScheduler.h"
+#include "HLOD.h"
+#include "ImpostorAtlas.h"
+#include "BuildingAssembler.h"
+#include "SceneBVH.h"
+#include "ThreadPool.h"
+#include "HeightmapMesher.h"
+#include "TerrainLOD.h"
+#include "HeightField.h"
 
-// Hash function for ivec2 Data Types
-struct Vec2Hash {
+class Generator {
 
-    size_t operator()(const glm::ivec2& v) const {
+public:
 
-        return std::hash<int>()(v.x) ^ (std::hash<int>()(v.y) << 1);
+    //How Terrain w/ Heights (Currently Just the Spawn Chunk) is Drawn
+    enum TerrainMode {
+        TERRAIN_LOD,  //CDLOD: Height Tiles Displaced in terrainLOD.vert, Vertex Cost Bounded by Distance
+        PACKED_MESH,  //Fixed Grid Mesh of 4 Byte Vertices w/ 16 Bit Strip Indices, Built on the Workers, Uploaded in One Job
+        STREAMED_MESH //Fixed Grid Mesh of Float Vertices, Uploaded a Tile at a Time as the Workers Finish them
+    };
 
-    }
-};
+    //Chunk Builds, Heightmap Uploads and the Spire Load are Submitted to the Scheduler When One is Given, Otherwise they Run Immediately
+    Generator(Shader& shader, Shader& spawnShader, const std::vector<std::string>& buildingPaths, const std::vector<float>& buildingWeights = {},
+        FrameScheduler* scheduler = nullptr);
+    void update(const Camera& camera);
+    void render(Shader& shader, Shader& spawnShader, Shader& roadShader, bool shadowPass = false);
+    void renderImpostors(Shader& impostorShader);
 
-class Generator {
+    //CDLOD Terrain (terrainLOD.vert in the Main Pass, terrainLODDepth.vert in the Shadow Pass)
+    void renderTerrain(Shader& terrainShader, bool shadowPass = false);
+    void setPrefetchHorizon(float seconds) { prefetcher.setHorizon(seconds); }
 
-public:
+    //Chebyshev Chunk Distances Beyond which Chunks Switch to Their Proxy, then to 2x2 and 4x4 Cluster Proxies
+    void setHLODDistances(int chunkProxy, int cluster2x2, int cluster4x4);
 
-    Generator(Shader& shader, Shader& spawnShader, const std::vector<std::string>& buildingPaths);
-    void update(const Camera& camera);
-    void render(Shader& shader, Shader& spawnShader, Shader& roadShader);
+    //Chebyshev Chunk Distance Beyond which Buildings are Drawn as Impostors (Until their HLOD Proxy Takes Over)
+    void setImpostorDistance(int distance) { impostorDistance = distance; }
+
+    //Set Before the Spawn Chunk is Generated
+    void setTerrainMode(TerrainMode mode) { terrainMode = mode; }
+
+    //Geometry Queries Against Every Resident Building (Full Detail Meshes, Whatever LOD is Drawn)
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, SceneBVH::RayHit& hit) const;
+    size_t overlap(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<SceneBVH::BuildingRef>& results) const;
+    bool nearest(const glm::vec3& point, float maxDistance, SceneBVH::NearestHit& hit) const;
+
+    //Ground Height Queries (CPU Copy of Every Resident Chunk's Terrain, Flat Elsewhere)
+    const HeightField& terrainHeights() const { return heightField; }
     ~Generator();
 
 private:
 
-    struct BuildingData {
-        glm::vec3 position;
-        float rotation;
-        size_t modelIndex; 
+    typedef WorldGen::Building BuildingData;
+
+    struct BuildingCandidate {
+        glm::mat4 model;
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        float distance;
+        size_t modelIndex;
+        bool impostor; //Drawn as a Billboard if Visible
+        int lod;
     };
 
     struct ChunkData {
@@ -48,11 +92,22 @@ private:
     };
 
     // Constants
-    static constexpr float CHUNK_SIZE = 1000.0f;
-    static constexpr int BUILDINGS_PER_CHUNK = 9;
+    static constexpr float CHUNK_SIZE = WorldGen::CHUNK_SIZE;
+    static constexpr int BUILDINGS_PER_CHUNK = WorldGen::BUILDINGS_PER_CHUNK;
     static constexpr float BUILDING_SCALE = 100.0f;
-    static constexpr float ROAD_WIDTH = 100.0f;
-    static constexpr int VIEW_DISTANCE = 4;
+    static constexpr float ROAD_WIDTH = WorldGen::ROAD_WIDTH;
+    static constexpr int VIEW_DISTANCE = 8; //Affordable Since Only the Nearest Chunks Draw Full Detail Buildings
+    static constexpr int UNLOAD_DISTANCE = VIEW_DISTANCE + 2; //Hysteresis so Boundary Oscillation Doesn't Thrash Chunks
+    static constexpr size_t TERRAIN_TILES = 16; //Height Tile Layers for CDLOD Terrain
+    static constexpr size_t CHUNK_CACHE_BUDGET = 2 * 1024 * 1024; //Bytes of Evicted Chunks Kept for Reuse
+    static constexpr int HEIGHTMAP_RESOLUTION = WorldGen::HEIGHTMAP_RESOLUTION;
+    static constexpr float PREFETCH_HORIZON = 3.0f; //Seconds of Predicted Travel to Load Ahead of the Camera
+    static constexpr int PREFETCH_PER_FRAME = 1;    //Prefetch Requests Queued Each Frame, so Prefetching Never Floods the Scheduler
+    static constexpr size_t OCCLUDER_COUNT = 32; //Nearest Buildings Rasterised as Occluders Each Frame
+    static constexpr float OCCLUDER_SHRINK = 0.7f; //Occluder Boxes are Shrunk so they Stay Inside the Real Silhouette
+    static constexpr uint32_t GENERATOR_VERSION = 4; //Bump when Generation Rules Change to Invalidate the Chunk Store
+    static constexpr uint32_t ASSEMBLED_SEEDS = 10; //Modular Buildings Assembled at Startup (Duplicates Collapse, so Unique Models <= this)
+    static constexpr uint32_t ASSEMBLY_SEED = 0x4b1d5eedu; //Base of the Assembled Buildings' Design Seeds, Independent of GENERATOR_VERSION
 
     // Shaders
     Shader& shader;
@@ -60,9 +115,12 @@ private:
 
     //Models and Instance Matrics
     std::vector<std::shared_ptr<Model>> buildingModels;
-    std::vector<std::vector<glm::mat4>> modelMatrices;
+    //Instance Lists per (Model, LOD) Group, Indexed modelIndex * Mesh::LOD_COUNT + lod
+    std::vector<std::vector<glm::mat4>> modelMatrices;  //Camera Visible Instances (Main Pass)
+    std::vector<std::vector<glm::mat4>> shadowMatrices; //Every Instance in the View Square (Shadow Pass)
+    WorldGen worldGen; //Chunk Content (GL Free), One Building Weight Per Building Model
     
-    std::shared_ptr<Model> spireModel;
+    std::shared_ptr<Model> spireModel; //Null Until its Load Job has Run
     std::unique_ptr<Terrain> terrainTemplate;
     
     //Matrices
@@ -70,18 +128,100 @@ private:
     std::vector<glm::mat4> terrainMatrices;
     
     //Chunks
-    std::unordered_map<glm::ivec2, ChunkData, Vec2Hash> chunks;
+    ChunkTable<ChunkData> chunks;
+    glm::ivec2 centerChunk = glm::ivec2(0, 0);
+
+    //Residency Cache (Most Recently Evicted at the Front)
+    std::list<ChunkData> chunkCache;
+    ChunkTable<std::list<ChunkData>::iterator> chunkCacheIndex;
+    size_t chunkCacheBytes = 0;
+
+    //On Disk Chunk Store (Generate Once, then Load on Every Later Visit)
+    std::unique_ptr<ChunkStore> chunkStore;
     
+    //Deferred Work (Chunks Already Queued are Tracked so they aren't Submitted Twice)
+    FrameScheduler* scheduler;
+    ChunkTable<uint8_t> pendingChunks;
+
+    //Spawn Chunk Heightmap (Mesh is Cached in Terrain by Seed and Resolution). The Heights Come from the World Seed Alone
+    //(the Spawn Chunk's Own Seed is Always 0), so that's the Seed the Cache is Keyed on
+    uint32_t heightmapSeed = 0;
+    int heightmapResolution = 0;
+
+    //Background Workers for Heightmap Tiles (Heights and Mesh Data Only, Uploads Stay on the Main Thread)
+    ThreadPool workers;
+
+    //Tiles of a Streaming Heightmap Finished by the Workers but Not Yet Handed to the Scheduler
+    struct HeightmapStream {
+        uint32_t seed;
+        int tiles;
+        int handedOut = 0;
+        HeightmapMesher::MeshData mesh;
+        std::mutex mutex;
+        std::vector<int> finished;
+    };
+    std::shared_ptr<HeightmapStream> heightmapStream;
+
+    //Continuous LOD Terrain
+    std::unique_ptr<TerrainLOD> terrainLOD;
+    TerrainMode terrainMode = TERRAIN_LOD;
+
+    //Hierarchical LOD (Proxy per Chunk, Merged Proxies per 2x2 and 4x4 Cluster)
+    HLOD hlod;
+    int hlodDistances[HLOD::LEVELS] = { 3, 4, 6 };
+    std::vector<glm::vec3> modelColours; //Proxy Box Colour of Each Building Model
+    ChunkTable<uint8_t> pendingClusters[HLOD::LEVELS];
+    std::vector<HLOD::Draw> proxyDraws;        //Every Proxy Selected this Frame (Shadow Pass)
+    std::vector<HLOD::Draw> visibleProxyDraws; //Proxies Passing the Occlusion Test (Main Pass)
+
+    //Octahedral Impostors (Between Full Detail and HLOD Proxies)
+    std::unique_ptr<ImpostorAtlas> impostors;
+    int impostorDistance = 1;
+    std::vector<ImpostorAtlas::Instance> impostorInstances;
+    std::vector<HLOD::Draw> impostorShadowDraws; //Billboards Can't Cast Correct Shadows, so Impostor Chunks Cast their Proxy
+
+    //Spatial Queries (Model Space Tree per Building Model, Instanced per Resident Chunk)
+    SceneBVH sceneBVH;
+    HeightField heightField;
+
+    //Velocity Predictive Loading
+    ChunkPrefetcher prefetcher;
+
+    //Occlusion Culling
+    OcclusionCuller occlusionCuller;
+    std::vector<BuildingCandidate> candidates;
+    std::vector<size_t> occluderOrder;
+
     //Buffers
-    std::vector<GLuint> instanceVBOs;
+    std::unique_ptr<BuildingBatch> buildingBatch;
     GLuint terrainInstanceVBO;
 
-    uint32_t generateChunkSeed(const glm::ivec2& position) const;
     glm::ivec2 worldToChunkCoords(const glm::vec3& worldPos) const;
     std::vector<glm::ivec2> getVisibleChunks(const glm::ivec2& centerChunk, const glm::vec3& viewDir) const;
     void generateChunk(const glm::ivec2& position);
-    size_t selectBuildingWeighted(uint32_t seed, size_t numBuildingTypes);
+    bool loadStoredChunk(ChunkData& chunk);
+    void storeChunk(const ChunkData& chunk, const std::vector<float>& heightMap, const std::vector<float>& normalMap);
+    uint32_t contentSignature(const std::vector<std::string>& modelKeys, const std::vector<float>& buildingWeights) const;
+    bool isWithinDistance(const glm::ivec2& position, const glm::ivec2& center, int distance) const;
+    size_t chunkFootprint(const ChunkData& chunk) const;
+    void cacheChunk(ChunkData&& chunk);
+    bool restoreCachedChunk(const glm::ivec2& position);
     void setupInstanceBuffers();
+    void cullBuildings(const Camera& camera);
+    void prefetchChunks(const Camera& camera);
+    void schedule(std::function<void()> job, FrameScheduler::Priority priority);
+    bool requestChunk(const glm::ivec2& position, FrameScheduler::Priority priority);
+    void buildOriginMesh(std::vector<float> heightMap, std::vector<float> normalMap, int resolution, uint32_t seed);
+    void uploadFinishedTiles();
+    bool hasOriginTerrain(uint32_t seed, int resolution) const;
+    void insertChunk(ChunkData&& chunk);
+    void appendProxyBoxes(const ChunkData& chunk, const glm::vec3& offset, std::vector<HLOD::Box>& boxes) const;
+    void buildChunkProxy(const ChunkData& chunk);
+    void requestCluster(int level, const glm::ivec2& cell);
+    void buildClusterProxy(int level, const glm::ivec2& cell);
+    bool isClusterResident(int level, const glm::ivec2& cell) const;
+    int clusterDistance(int level, const glm::ivec2& cell) const;
+    bool selectProxy(const glm::ivec2& position);
 
 };
 
@@ -0,0 +1,77 @@
+#ifndef HLOD_H
+#define HLOD_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Shader.h"
+#include "Model.h"
+#include "ChunkTable.h"
+
+//Hierarchical LOD Proxies for Distant Chunks
+//Level 0 Merges One Chunk's Buildings into a Single Mesh, Levels 1 and 2 Merge 2x2 and 4x4 Chunk Clusters
+//Each Building is Simplified to a Colour Averaged Box (no Bottom Face), so a Whole Cluster is One Small Draw
+//Vertices Match the Building Arena Layout, so the Batched and Depth Shaders Draw Proxies Unchanged
+class HLOD {
+
+public:
+
+    static constexpr int LEVELS = 3;
+
+    struct Box {
+        glm::vec3 boundsMin; //Relative to the Proxy's Origin
+        glm::vec3 boundsMax;
+        glm::vec3 colour;
+    };
+
+    struct Draw {
+        int level;
+        glm::ivec2 cell;
+    };
+
+    HLOD();
+    ~HLOD();
+
+    //Cluster Containing a Chunk at a Level (Floor Division by 2^level)
+    static glm::ivec2 clusterOf(const glm::ivec2& chunk, int level);
+
+    //Index Weighted Mean of a Model's Mesh Colours, Used as its Proxy Colour
+    static glm::vec3 averageColour(const Model& model);
+
+    //Replaces Any Existing Proxy for the Cell. Boxes are Placed Relative to origin (World Space)
+    void build(int level, const glm::ivec2& cell, const glm::vec3& origin, const std::vector<Box>& boxes);
+    bool has(int level, const glm::ivec2& cell) const { return proxies[level].contains(cell); }
+    void release(int level, const glm::ivec2& cell);
+
+    //Release the Chunk's Own Proxy and Every Cluster that Contains it
+    void releaseChunk(const glm::ivec2& chunk);
+
+    //World Space Bounds, False if the Proxy Doesn't Exist
+    bool bounds(int level, const glm::ivec2& cell, glm::vec3& boundsMin, glm::vec3& boundsMax) const;
+
+    void render(Shader& shader, const std::vector<Draw>& draws);
+
+private:
+
+    struct Proxy {
+        GLuint VAO = 0, VBO = 0, EBO = 0;
+        GLsizei indexCount = 0;
+        glm::mat4 transform = glm::mat4(1.0f);
+        glm::vec3 boundsMin = glm::vec3(0.0f);
+        glm::vec3 boundsMax = glm::vec3(0.0f);
+    };
+
+    struct ProxyVertex {
+        glm::vec3 Position;
+        glm::vec3 Normal;
+        glm::vec3 Colour;
+    };
+
+    ChunkTable<Proxy> proxies[LEVELS];
+
+    void deleteProxy(Proxy& proxy);
+
+};
+
+#endif
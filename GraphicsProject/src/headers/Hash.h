@@ -0,0 +1,35 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+//Attrib: Sebastiano Vigna, SplitMix64 Finaliser. Stateless, so any Seed can be Hashed Independently
+inline uint64_t splitmix64(uint64_t x) {
+
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+
+}
+
+//Combine Two 32 Bit Values (e.g. a Chunk Seed and a Building Slot) into One Well Mixed 64 Bit Hash
+inline uint64_t hashCombine(uint32_t a, uint32_t b) {
+
+    return splitmix64((static_cast<uint64_t>(a) << 32) | b);
+
+}
+
+//FNV-1a over Raw Bytes, for Hashing Content (Strings, Records) Rather than Single Integers
+inline uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 0xCBF29CE484222325ull) {
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+    }
+    return hash;
+
+}
+
+#endif
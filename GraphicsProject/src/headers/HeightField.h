@@ -0,0 +1,51 @@
+#ifndef HEIGHT_FIELD_H
+#define HEIGHT_FIELD_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ChunkTable.h"
+
+//Ground Height and Normal Queries in World Space (Camera, Boids, Gameplay), Kept After the Terrain's GPU Upload
+//Each Chunk w/ Terrain Keeps its Height Grid Quantised to 16 Bits over its Own Height Range (2 Bytes per Sample),
+//w/ the Outer Ring Flattened as the Drawn Terrain Does. Chunks w/o a Height Grid are Flat at baseHeight
+//Heights are Bilinear Between Samples, Matching the CDLOD Terrain's Filtered Height Tiles. Needs no GL Context
+class HeightField {
+
+public:
+
+    HeightField(float chunkSize, float baseHeight);
+
+    //resolution^2 Heights Above baseHeight, Rows Along z, Spanning the Chunk Centred on chunk * chunkSize
+    void setChunk(const glm::ivec2& chunk, const float* heights, int resolution);
+    void removeChunk(const glm::ivec2& chunk);
+    bool hasChunk(const glm::ivec2& chunk) const { return fields.contains(chunk); }
+    size_t chunkCount() const { return fields.size(); }
+    size_t memoryBytes() const { return storedBytes; }
+
+    float sampleHeight(float x, float z) const;
+    glm::vec3 sampleNormal(float x, float z) const; //Unit, Pointing Up
+
+    //Many Points at Once (x/z Pairs), e.g. Every Boid. Neighbouring Points Usually Share a Chunk, so the Lookup is Reused
+    void sampleHeights(const glm::vec2* points, size_t count, float* heights, glm::vec3* normals = nullptr) const;
+
+private:
+
+    struct Field {
+        int resolution;
+        float heightMin, heightStep; //Height = heightMin + quantised * heightStep
+        std::vector<uint16_t> heights;
+    };
+
+    float chunkSize, baseHeight;
+    ChunkTable<Field> fields;
+    size_t storedBytes = 0;
+
+    glm::ivec2 chunkAt(float x, float z) const;
+    void sampleField(const Field& field, const glm::ivec2& chunk, float x, float z, float& height, glm::vec3* normal) const;
+
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef HEIGHTMAP_MESHER_H
+#define HEIGHTMAP_MESHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ThreadPool.h"
+
+//CPU Side Spawn Chunk Mesh (Positions, Normals, UVs, Indices) from a resolution x resolution Height Grid
+//Built in Tiles of TILE_ROWS Grid Rows. A Tile's Vertices and Indices are Contiguous Ranges of the Whole Mesh,
+//so Tiles can be Built on Different Threads and Uploaded into their Slice of the Buffers as they Finish
+//Needs no GL Context
+class HeightmapMesher {
+
+public:
+
+    static const int TILE_ROWS = 32;
+
+    struct MeshData {
+        int resolution = 0;
+        std::vector<float> vertices; //xyz
+        std::vector<float> normals;  //xyz
+        std::vector<float> uvs;      //uv
+        std::vector<unsigned int> indices;
+    };
+
+    //4 Byte Vertex: Height Quantised over the Mesh's Height Range, Octahedral Normal (y as the Octahedron's Axis)
+    //x/z and UVs Come from the Vertex's Index in the Grid, so Aren't Stored
+    struct PackedVertex {
+        uint16_t height;
+        uint8_t normal[2];
+    };
+
+    //Decoded Height = heightMin + (height / 65535) * heightRange
+    struct PackedMeshData {
+        int resolution = 0;
+        float heightMin = 0.0f;
+        float heightRange = 0.0f;
+        std::vector<PackedVertex> vertices;
+    };
+
+    //Vertex and Index Ranges of a Tile (in Vertices and Indices, not Floats)
+    struct Tile {
+        size_t firstVertex, vertexCount;
+        size_t firstIndex, indexCount;
+    };
+
+    static int tileCount(int resolution);
+    static Tile tile(int resolution, int index);
+
+    //Sizes Every Array for the Whole Mesh, so Tiles Only Write Inside their Own Ranges
+    static void allocate(MeshData& mesh, int resolution);
+
+    //Interior Normals are Copied from normals (xyz per Height, Pointing Up, e.g. WorldGen's Analytic Normals) When Given,
+    //so a Tile Only Reads its Own Rows. Otherwise they're Central Differences, and heightMap Must Cover the Full Grid,
+    //since Normals on a Tile's Edge Read the Neighbouring Rows. The Grid's Outer Ring is Flattened Either Way
+    static void buildTile(const float* heightMap, int index, MeshData& mesh, const float* normals = nullptr);
+
+    //Triangle List over the Grid's Quads, Written into a Tile's Range of indices (Sized for the Whole Grid)
+    static void tileIndices(int resolution, int index, unsigned int* indices);
+
+    //Every Tile's Indices as One Grid (Depends Only on the Resolution)
+    static void gridIndices(int resolution, std::vector<unsigned int>& indices);
+
+    //Restart Strip per Quad Row, the Same Triangles and Winding as gridIndices(...) in a Third the Indices. 16 Bit Whenever
+    //Every Vertex Index Sits Below the 0xFFFF Restart Index (Resolutions up to 255), 32 Bit w/ a 0xFFFFFFFF Restart Otherwise
+    static bool shortStripIndices(int resolution);
+    static void stripIndices(int resolution, std::vector<uint16_t>& indices);
+    static void stripIndices(int resolution, std::vector<uint32_t>& indices);
+
+    //Packed Vertices, Straight from the Heights (Normals as in buildTile, then Quantised)
+    static void buildPacked(const float* heightMap, int resolution, PackedMeshData& mesh, ThreadPool* pool = nullptr, const float* normals = nullptr);
+
+    static uint16_t quantiseHeight(float height, float heightMin, float heightRange);
+    static void encodeNormal(const float* normal, uint8_t* encoded);
+
+    //Whole Mesh, Tiles Spread Across the Pool (Serial w/o One)
+    static void build(const float* heightMap, int resolution, MeshData& mesh, ThreadPool* pool = nullptr, const float* normals = nullptr);
+
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef IMPOSTOR_ATLAS_H
+#define IMPOSTOR_ATLAS_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Shader.h"
+#include "Model.h"
+#include "BuildingBatch.h"
+#include "Octahedral.h"
+
+//Octahedral Impostors for Building Models
+//Each Model is Rendered Orthographically from FRAMES x FRAMES Hemi Octahedral View Directions into One Layer of
+//a Colour Atlas and a Normal Atlas, so Distant Instances can be Drawn as a Single Camera Facing Quad and Lit at Runtime
+//Atlases are Baked Once and Cached to Disk, Keyed on the Model Files and Bake Settings
+class ImpostorAtlas {
+
+public:
+
+    static constexpr int FRAMES = 8;
+    static constexpr int FRAME_SIZE = 64; //Pixels per Frame Side
+    static constexpr int ATLAS_SIZE = FRAMES * FRAME_SIZE;
+    static constexpr int MAX_MODELS = 16; //Size of the Bounding Sphere Uniform Array in impostor.vert
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    struct Instance {
+        glm::vec4 positionScale; //World Position of the Model Origin, Uniform Scale
+        float layer;             //Model Index
+    };
+
+    ImpostorAtlas(const std::vector<std::shared_ptr<Model>>& models, const std::vector<std::string>& modelPaths,
+        BuildingBatch& batch, const std::string& cacheDirectory, size_t maxInstances);
+    ~ImpostorAtlas();
+
+    void render(Shader& shader, const std::vector<Instance>& instances);
+
+    bool isReady() const { return ready; }
+    size_t layerCount() const { return layers; } //Models 0 to layerCount() - 1 Have Impostors
+
+private:
+
+    struct CacheHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t signature;
+        uint32_t layers;
+        uint32_t frames;
+        uint32_t frameSize;
+    };
+
+    size_t layers;
+    size_t maxInstances;
+    bool ready = false;
+
+    std::vector<glm::vec4> spheres; //Model Space Bounding Sphere (Centre, Radius) per Layer
+    GLuint colourAtlas = 0, normalAtlas = 0;
+    GLuint quadVAO = 0, quadVBO = 0, quadEBO = 0, instanceVBO = 0;
+
+    void createTextures(const unsigned char* colour, const unsigned char* normal);
+    bool bake(BuildingBatch& batch);
+    bool loadCache(const std::string& path, uint32_t signature);
+    void saveCache(const std::string& path, uint32_t signature);
+    void setupQuad();
+
+};
+
+#endif
@@ -12,6 +12,7 @@
 #include "Camera.h"
 #include "Skybox.h"
 #include "Generator.h"
+#include "FrameScheduler.h"
 #include "Boid.h"
 
 #include <iostream>
@@ -0,0 +1,42 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+//Read Only Memory Mapping of a Whole File (Win32 File Mappings or POSIX mmap)
+class MappedFile {
+
+public:
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return bytes != nullptr; }
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+
+};
+
+//Create Each Missing Directory Along the Path (No std::filesystem in C++11)
+void createDirectories(const std::string& path);
+
+#endif
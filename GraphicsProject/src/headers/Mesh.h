@@ -38,8 +38,19 @@ class Mesh {
 
 public:
 
+    //Detail Levels per Mesh, Each Targeting a Fraction of the Original Triangles
+    static constexpr int LOD_COUNT = 4;
+    static const float LOD_RATIOS[LOD_COUNT];
+    static const float LOD_COVERAGE[LOD_COUNT - 1]; //Screen Height Fraction Below which Each Coarser LOD Takes Over
+
+    //Pick a LOD from the Fraction of the Screen Height an Instance Covers (See Camera::screenCoverage)
+    static int selectLod(float screenCoverage);
+
     vector<Vertex>       vertices;
-    vector<unsigned int> indices;
+    vector<unsigned int> indices;    //Full Detail (LOD 0)
+    vector<unsigned int> lodIndices; //LODs 1+ Concatenated, Uploaded After indices into the Same EBO
+    unsigned int lodFirstIndex[LOD_COUNT]; //Offsets into indices + lodIndices
+    unsigned int lodIndexCount[LOD_COUNT];
     vector<Texture>      textures;
     glm::vec3 diffuseColor;
     unsigned int VAO;
@@ -52,6 +63,7 @@ private:
     
     unsigned int VBO, EBO;
 
+    void buildLods();
     void setupMesh();
 
 };
@@ -0,0 +1,18 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+
+//Quadric Error Metric Simplification (Garland & Heckbert) by Edge Collapse onto Existing Vertices
+//Only the Index Buffer Changes, so Every LOD Can Share the Original Vertex Buffer
+//Vertices at the Same Position are Welded for Topology, so Hard Edges and UV Seams Don't Block Collapses
+//Open Borders are Held in Place by Perpendicular Constraint Planes, and Collapses that Flip a Triangle are Rejected
+//Needs no GL Context
+
+//Returns a New Index List w/ at Most targetIndexCount Indices Where Reachable (Fewer Collapses if the Mesh Runs out of Valid Ones)
+std::vector<unsigned int> simplifyMesh(const std::vector<glm::vec3>& positions, const std::vector<glm::vec3>& normals,
+    const std::vector<unsigned int>& indices, size_t targetIndexCount);
+
+#endif
@@ -12,6 +12,7 @@
 
 #include <Mesh.h>
 #include <Shader.h>
+#include "TextureCache.h"
 
 #include <string>
 #include <fstream>
@@ -27,22 +28,34 @@ class Model {
 
 public:
     
-    vector<Texture> textures_loaded;	
+    vector<Texture> textures_loaded; //One per Distinct Texture, Each Holding a TextureCache Reference
     vector<Mesh>    meshes;
     string directory;
     bool gammaCorrection;
     glm::vec3 diffuseColor = glm::vec3(1.0f, 0.0f, 0.0f);
 
+    //Model Space Axis Aligned Bounds over all Meshes
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+
     Model(string const& path, bool gamma = false);
 
-    void render(Shader& shader, bool instanced = false, size_t instanceCount = 0);
+    //Wrap Meshes Built in Code (e.g. Assembled Buildings)
+    Model(vector<Mesh> meshes);
+
+    void render(Shader& shader, bool instanced = false, size_t instanceCount = 0, int lod = 0);
+
+    //Drops the Model's Texture References (Explicit, as Meshes are Copied Between Models). Call Once it Won't be Drawn Again
+    void releaseTextures();
 
 private:
 
-    const aiScene* scene;
+    const aiScene* scene = nullptr;
 
     void loadModel(string const& path);
 
+    void computeBounds();
+
     void processNode(aiNode* node, const aiScene* scene);
 
     Mesh processMesh(aiMesh* mesh, const aiScene* scene);
@@ -0,0 +1,37 @@
+#ifndef MODEL_BVH_H
+#define MODEL_BVH_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+
+#include "BVH4.h"
+
+//Bottom Level of the Scene BVH: One Tree per Building Model over its Triangles, in Model Space
+//Shared by Every Instance of the Model, Queries Arrive Already Transformed into Model Space. Needs no GL Context
+class ModelBVH {
+
+public:
+
+    ModelBVH(const std::vector<glm::vec3>& positions, const std::vector<unsigned int>& indices);
+
+    //Nearest Hit Closer than tMax (in Units of the Ray Direction), Shrinking tMax and Writing the Face Normal
+    bool raycast(const BVHRay& ray, float& tMax, glm::vec3& normal) const;
+
+    //True if Any Triangle Intersects the Box (Separating Axis Test)
+    bool overlaps(const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+
+    //Closest Surface Point Within sqrt(maxDistanceSq), Shrinking maxDistanceSq
+    bool nearest(const glm::vec3& point, float& maxDistanceSq, glm::vec3& closest) const;
+
+    const BVH4::Box& bounds() const { return tree.bounds(); }
+    size_t triangleCount() const { return corners.size() / 3; }
+
+private:
+
+    std::vector<glm::vec3> corners; //Three per Triangle, so a Leaf Reads Contiguous Memory
+    BVH4 tree;
+
+};
+
+#endif
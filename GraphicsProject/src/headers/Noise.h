@@ -0,0 +1,42 @@
+#ifndef NOISE_H
+#define NOISE_H
+
+#include <cstddef>
+
+//2D Perlin Noise and its Fractal Sum, Shared by World Generation and Anything Else that Needs Terrain Heights
+//Pure Functions of their Inputs, so Needs no GL Context
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define NOISE_AVX2 1
+#endif
+
+float perlinNoise(float x, float y);
+
+float octaveNoise(float x, float y, int octaves, float persistence);
+
+//Value and its Analytic Gradient (d/dx, d/dy into gradient[0], gradient[1]) in One Evaluation
+//Values are Bit Identical to perlinNoise(...) and octaveNoise(...)
+float perlinNoiseGradient(float x, float y, float* gradient);
+float octaveNoiseGradient(float x, float y, int octaves, float persistence, float* gradient);
+
+//Fractal Sum over count Points (x[i], y[i]) into out[i], Eight at a Time w/ AVX2 when the CPU Supports it
+//Results are Bit Identical to Calling octaveNoise(...) per Point
+void octaveNoiseBatch(const float* x, const float* y, size_t count, int octaves, float persistence, float* out);
+
+//Plain Loop over octaveNoise(...), the Reference the AVX2 Path is Checked Against
+void octaveNoiseBatchScalar(const float* x, const float* y, size_t count, int octaves, float persistence, float* out);
+
+//Fractal Sum and its Gradient over count Points (Slopes into gradientX[i], gradientY[i]), Eight at a Time w/ AVX2 when Supported
+//Results are Bit Identical to Calling octaveNoiseGradient(...) per Point
+void octaveNoiseGradientBatch(const float* x, const float* y, size_t count, int octaves, float persistence, float* out,
+    float* gradientX, float* gradientY);
+void octaveNoiseGradientBatchScalar(const float* x, const float* y, size_t count, int octaves, float persistence, float* out,
+    float* gradientX, float* gradientY);
+
+bool noiseUsesAVX2();
+
+//Turns the AVX2 Path Off (or Back On, When Supported) so Benchmarks can Time the Scalar Path Through the Same Calls
+//Set Before Generating, Not While Other Threads are Sampling
+void setNoiseSIMD(bool enabled);
+
+#endif
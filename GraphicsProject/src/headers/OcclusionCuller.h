@@ -0,0 +1,65 @@
+#ifndef OCCLUSION_CULLER_H
+#define OCCLUSION_CULLER_H
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+//CPU Software Occlusion Culling: Rasterises Box Occluders into a Small Depth Buffer, then Tests Boxes Against it
+//Depth is NDC z Remapped to [0, 1] (0 = Near Plane), Stored per Pixel and as a Max Depth per 8x8 Tile
+//Occluder Triangles are Set Up and Binned into 32x32 Pixel Bins as they're Added, then finishOccluders() Rasterises
+//Bin by Bin (4 Pixels at a Time w/ SSE2), so Each Bin's Depth Stays in Cache While Every Triangle Touching it is Drawn
+//Needs no GL Context, so it can Run Headless
+class OcclusionCuller {
+
+public:
+
+    static constexpr int WIDTH = 256;
+    static constexpr int HEIGHT = 128;
+    static constexpr int TILE_SIZE = 8;
+    static constexpr int BIN_SIZE = 32;
+
+    OcclusionCuller();
+
+    //Clears the Depth Buffer for a New View
+    void beginFrame(const glm::mat4& viewProjection);
+
+    //Rasterise a World Space Box. Occluders Crossing the Near Plane are Skipped
+    void addOccluder(const glm::vec3& boxMin, const glm::vec3& boxMax);
+
+    //Rasterise the Binned Occluders and Rebuild the Per Tile Max Depth, Call Once After the Last Occluder
+    void finishOccluders();
+
+    //False Only if the Box is Outside the View or Entirely Behind Rasterised Occluders
+    bool isVisible(const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+
+    const std::vector<float>& depthBuffer() const { return depth; }
+
+private:
+
+    static constexpr int TILES_X = WIDTH / TILE_SIZE;
+    static constexpr int TILES_Y = HEIGHT / TILE_SIZE;
+    static constexpr int BINS_X = WIDTH / BIN_SIZE;
+    static constexpr int BINS_Y = HEIGHT / BIN_SIZE;
+
+    //Edge Functions w(p) = A * p.x + B * p.y + C (Non Negative Inside), Depth z(p) = zA * p.x + zB * p.y + zC
+    struct Triangle {
+        float A[3], B[3], C[3];
+        float zA, zB, zC;
+        int minX, maxX, minY, maxY; //Pixel Bounds, Clamped to the Buffer
+    };
+
+    glm::mat4 viewProjection;
+    std::vector<float> depth;
+    std::vector<float> tileMaxDepth;
+    std::vector<Triangle> triangles;
+    std::vector<uint32_t> bins[BINS_X * BINS_Y]; //Triangle Indices Overlapping Each Bin (Capacity Kept Across Frames)
+
+    //Screen Space Position (Pixels) and Depth of Each Corner, Returns how Many Corners are Behind the Near Plane
+    int projectCorners(const glm::vec3& boxMin, const glm::vec3& boxMax, glm::vec3 corners[8]) const;
+    void setupTriangle(const glm::vec3& v0, const glm::vec3& v1, const glm::vec3& v2);
+    void rasteriseTriangle(const Triangle& triangle, int binX, int binY);
+
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef OCTAHEDRAL_H
+#define OCTAHEDRAL_H
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+//Hemi Octahedral Mapping Between Upper Hemisphere Directions (y Up) and the [-1, 1] Square
+//Impostor Frames are Laid Out on an N x N Grid over this Square, so Neighbouring Frames are Neighbouring Views
+//impostor.vert Mirrors these Functions, Keep them in Sync
+
+inline glm::vec2 encodeHemiOctahedral(glm::vec3 direction) {
+
+    //Views from Below the Horizon Reuse the Horizon Frames
+    direction.y = std::max(direction.y, 0.0f);
+    direction /= std::fabs(direction.x) + direction.y + std::fabs(direction.z);
+    return glm::vec2(direction.x + direction.z, direction.x - direction.z);
+
+}
+
+inline glm::vec3 decodeHemiOctahedral(const glm::vec2& encoded) {
+
+    glm::vec2 p = glm::vec2(encoded.x + encoded.y, encoded.x - encoded.y) * 0.5f;
+    return glm::normalize(glm::vec3(p.x, 1.0f - std::fabs(p.x) - std::fabs(p.y), p.y));
+
+}
+
+//Frame Containing a Direction on a frames x frames Grid
+inline glm::ivec2 octahedralFrame(const glm::vec3& direction, int frames) {
+
+    glm::vec2 uv = encodeHemiOctahedral(direction) * 0.5f + 0.5f;
+    return glm::clamp(glm::ivec2(glm::floor(uv * static_cast<float>(frames))), glm::ivec2(0), glm::ivec2(frames - 1));
+
+}
+
+//View Direction (Object Towards Viewer) at the Centre of a Frame
+inline glm::vec3 octahedralFrameDirection(const glm::ivec2& frame, int frames) {
+
+    glm::vec2 uv = (glm::vec2(frame) + 0.5f) / static_cast<float>(frames);
+    return decodeHemiOctahedral(uv * 2.0f - 1.0f);
+
+}
+
+//Right and Up Axes of the Image Plane Facing a Direction. Shared by Baking and Billboarding so the Two Line Up
+inline void octahedralFrameBasis(const glm::vec3& direction, glm::vec3& right, glm::vec3& up) {
+
+    right = glm::cross(glm::vec3(0.0f, 1.0f, 0.0f), direction);
+    float length = glm::length(right);
+    right = length > 1e-4f ? right / length : glm::vec3(1.0f, 0.0f, 0.0f);
+    up = glm::cross(direction, right);
+
+}
+
+//Orthographic Bake of a Model w/ a Bounding Sphere (centre, radius): the Sphere Fills the Frame, Seen from 2 Radii Out
+inline glm::mat4 octahedralBakeProjection(float radius) {
+
+    return glm::ortho(-radius, radius, -radius, radius, 0.0f, radius * 4.0f);
+
+}
+
+inline glm::mat4 octahedralBakeView(const glm::ivec2& frame, int frames, const glm::vec3& centre, float radius) {
+
+    glm::vec3 direction = octahedralFrameDirection(frame, frames);
+    glm::vec3 right, up;
+    octahedralFrameBasis(direction, right, up);
+    return glm::lookAt(centre + direction * radius * 2.0f, centre, up);
+
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef SCENE_BVH_H
+#define SCENE_BVH_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "BVH4.h"
+#include "ModelBVH.h"
+#include "ChunkTable.h"
+
+//Two Level BVH for Ray, Overlap and Nearest Point Queries Against Resident Buildings
+//Top Level: BVH4 over Resident Chunk Bounds, Rebuilt Lazily on the First Query After Chunks Change (One Box per Chunk)
+//Per Chunk: Instance Bounds in SIMD Groups of Four, Each Instance Referencing a Shared Model Space ModelBVH
+//Instances are Translation + Uniform Scale, Matching how Generator Places Buildings. Needs no GL Context
+class SceneBVH {
+
+public:
+
+    struct Instance {
+        glm::vec3 position;
+        float scale;
+        uint32_t model;
+    };
+
+    //Building by Chunk and Slot in the Chunk's Building List
+    struct BuildingRef {
+        glm::ivec2 chunk;
+        uint32_t building;
+    };
+
+    struct RayHit {
+        BuildingRef building;
+        float distance;
+        glm::vec3 position;
+        glm::vec3 normal;
+    };
+
+    struct NearestHit {
+        BuildingRef building;
+        float distance;
+        glm::vec3 position;
+    };
+
+    explicit SceneBVH(std::vector<std::shared_ptr<const ModelBVH>> models = {});
+
+    void setModels(std::vector<std::shared_ptr<const ModelBVH>> models);
+    void insertChunk(const glm::ivec2& chunk, const std::vector<Instance>& instances);
+    void removeChunk(const glm::ivec2& chunk);
+    size_t chunkCount() const { return chunks.size(); }
+
+    //Nearest Surface Hit Along a Ray (direction Needn't be Normalised, Distances are in World Units)
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, RayHit& hit) const;
+
+    //Buildings w/ Geometry Inside the Box, Appended to results. Returns the Number Found
+    size_t overlap(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<BuildingRef>& results) const;
+
+    //Closest Building Surface Point Within maxDistance
+    bool nearest(const glm::vec3& point, float maxDistance, NearestHit& hit) const;
+
+private:
+
+    struct ChunkEntry {
+        glm::ivec2 position;
+        std::vector<Instance> instances;
+        std::vector<uint32_t> buildingSlots; //Index in the Caller's List (Instances w/o Geometry are Skipped)
+        std::vector<Box4> instanceBounds; //World Space, Four per Group (Unused Lanes Masked Off)
+        BVH4::Box bounds;
+    };
+
+    std::vector<std::shared_ptr<const ModelBVH>> models;
+    std::vector<ChunkEntry> chunks;
+    ChunkTable<uint32_t> chunkIndex; //Chunk to Slot in chunks
+
+    //Top Level is Rebuilt on Demand, so Streaming Many Chunks in One Frame Costs One Rebuild
+    mutable BVH4 topLevel;
+    mutable bool topLevelDirty = false;
+
+    void refreshTopLevel() const;
+    static int laneMask(size_t group, size_t instanceCount);
+
+};
+
+#endif
@@ -9,11 +9,14 @@
 #include <stbi/stb_image.h>
 #include <string>
 #include <iostream>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 #include "Shader.h"
 #include "Camera.h"
 #include "Model.h"
+#include "HeightmapMesher.h"
 
 class Terrain {
 
@@ -21,11 +24,24 @@ public:
 
     Terrain(Shader& shader);
     void renderInstanced(Shader& shader, const std::vector<glm::mat4>& modelMatrices);
-    void renderHeightmap(Shader& shader);
+    void renderHeightmap(Shader& shader, uint32_t seed, int resolution);
     void setupInstancedRendering(size_t maxInstances);
-    void generateHeightmapMesh(int resolution = 100);
     void deleteBuffers();
 
+    //Spawn Chunk Heightmap Meshes are Cached by (Seed, Resolution), so Rebuilding an Already Uploaded Mesh is a No-Op
+    //Float Meshes are Begun Empty and Streamed in a Tile at a Time (Drawn Once Every Tile has Arrived)
+    bool hasHeightmapMesh(uint32_t seed, int resolution) const;
+    bool isHeightmapMeshReady(uint32_t seed, int resolution) const;
+    void beginHeightmapMesh(uint32_t seed, int resolution);
+    void uploadHeightmapTile(uint32_t seed, const HeightmapMesher::MeshData& data, int tile);
+    void releaseHeightmapMesh(uint32_t seed, int resolution);
+
+    //Packed Alternative: One Interleaved 4 Byte Vertex (Quantised Height, Octahedral Normal) Drawn as Restart Strips
+    //over a Strip Grid Shared per Resolution (16 Bit Indices up to 255x255)
+    void buildPackedHeightmapMesh(const HeightmapMesher::PackedMeshData& data, uint32_t seed);
+
+    static const size_t HEIGHTMAP_CACHE_SIZE = 2; //Uploaded Meshes Kept Before the Least Recently Drawn is Freed
+
 
 private:
 
@@ -70,22 +86,33 @@ private:
 
     };
 
-    GLuint terrainVAO, terrainVBO, terrainEBO, grassID, roadID, pathID;
+    GLuint terrainVAO, terrainVBO, terrainEBO, roadID = 0, pathID = 0;
     GLuint terrainNormal, terrainUV, instanceVBO;
 
 
-    //Perlin Noise
+    //Spawn Chunk Heightmap
+
+    struct HeightmapMesh {
+        GLuint VAO, VBO, EBO;
+        GLuint normal, uv;
+        bool packed;          //Packed Meshes Own Only their VBO, the Strip Grid is Shared
+        float heightMin, heightRange;
+        GLenum mode, indexType;
+        unsigned int indexCount;
+        uint64_t lastUsed;
+        std::vector<bool> uploadedTiles;
+        int tilesRemaining;
+    };
+
+    std::unordered_map<uint64_t, HeightmapMesh> heightmapMeshes;
+    uint64_t heightmapClock = 0;
+    GLuint grassID = 0; //Loaded on the First Heightmap Build, Shared by Every Cached Mesh
 
-    GLuint heightmapVAO, heightmapVBO, heightmapEBO;
-    GLuint heightmapNormal, heightmapUV;
-    unsigned int heightmapIndexCount;
+    std::unordered_map<int, GLuint> heightmapStrips; //Shared Strip Grid per Resolution (Packed Meshes)
 
-    float fade(float t);
-    float lerp(float a, float b, float t);
-    float grad(int hash, float x, float y);
-    float noise(float x, float y);
-    float octaveNoise(float x, float y, int octaves, float persistence);
-    std::vector<float> generateHeightMap(int resolution);
+    static uint64_t heightmapKey(uint32_t seed, int resolution);
+    HeightmapMesh& addHeightmapMesh(uint32_t seed, int resolution);
+    void deleteHeightmapMesh(HeightmapMesh& mesh);
 
 };
 #endif
\ No newline at end of file
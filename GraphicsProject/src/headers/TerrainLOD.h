@@ -0,0 +1,72 @@
+#ifndef TERRAIN_LOD_H
+#define TERRAIN_LOD_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Shader.h"
+#include "CDLOD.h"
+#include "ChunkTable.h"
+
+//CDLOD Terrain Renderer: One Shared Grid Patch, Instanced Once per Selected Quadtree Node
+//Heights Live in an R32F Texture Array (One Layer per Chunk w/ Terrain) and are Applied in terrainLOD.vert,
+//which also Morphs Vertices Between Levels. Normals Come from a Matching RG16F Array of Slopes (dh/dx, dh/dz), which
+//Filter Linearly, so the Shader Needs One Tap Instead of Differencing Neighbouring Heights
+//Vertex Cost is Bounded by the Node Count, Independent of Height Tile Resolution
+class TerrainLOD {
+
+public:
+
+    static constexpr float LEAF_RANGE = 400.0f; //Distance Covered by the Finest Level
+    static constexpr float BASE_HEIGHT = -50.0f; //Matches the Flat Road Tiles
+
+    TerrainLOD(float chunkSize, int tileResolution, size_t maxTiles);
+    ~TerrainLOD();
+
+    //tileResolution^2 Heights Spanning the Chunk. Edge Samples are Flattened so the Tile Meets the Road Tiles
+    //normals (xyz per Height, Pointing Up, e.g. WorldGen's Analytic Normals) are Optional, w/o Them Slopes are Central Differences
+    bool setTile(const glm::ivec2& chunk, const float* heights, int resolution, const float* normals = nullptr);
+    void removeTile(const glm::ivec2& chunk);
+    bool hasTile(const glm::ivec2& chunk) const { return lod.hasTile(chunk); }
+
+    //Selects Nodes for this Frame and Uploads their Instance Data
+    void select(const glm::vec3& camera, const glm::mat4& viewProjection, const std::function<bool(const glm::ivec2&)>& include);
+
+    //Main Pass Draws Nodes Inside the Frustum, the Shadow Pass Draws Every Selected Node
+    void render(Shader& shader, bool shadowPass = false);
+
+    size_t selectedNodes() const { return nodes.size(); }
+
+private:
+
+    //Per Node Instance Data (Attribute Locations 3 and 4)
+    struct NodeInstance {
+        glm::vec4 node; //Origin x, Origin z, Size, Level
+        glm::vec4 tile; //Chunk Min x, Chunk Min z, Layer, Unused
+    };
+
+    CDLOD lod;
+    float chunkSize;
+    int tileResolution;
+    int patchQuads;
+    size_t maxTiles;
+    size_t maxNodes;
+
+    GLuint patchVAO, patchVBO, patchEBO, instanceVBO;
+    GLuint heightTiles, slopeTiles, grassID;
+    GLsizei patchIndexCount;
+
+    ChunkTable<uint32_t> tileLayers;
+    std::vector<uint32_t> freeLayers;
+
+    glm::vec3 selectedCamera = glm::vec3(0.0f);
+    std::vector<CDLOD::Node> nodes;
+    std::vector<NodeInstance> instances;
+    size_t visibleNodes = 0;
+
+};
+
+#endif
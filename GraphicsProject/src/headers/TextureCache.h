@@ -0,0 +1,36 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+//Process Wide Cache of 2D Textures, so Every Image is Decoded and Uploaded Once However Many Models or Terrains Use it
+//Files are Keyed by Canonical Path, Other Sources (e.g. Embedded Model Images) by a Key the Caller Builds from Content
+//Reference Counted: Every acquire(...) or retain(...) Needs a Matching release(...), and the Last Release Deletes the Texture
+//Main Thread Only (Needs the GL Context)
+class TextureCache {
+
+public:
+
+    //Image File (directory + '/' + path), Loaded w/ TextureFromFile(...) on First Use
+    static GLuint acquireFile(const std::string& path, const std::string& directory, bool gamma = false);
+
+    //Any Other Source. upload Only Runs on a Miss, and Must Return a New Texture for the Cache to Own
+    static GLuint acquire(const std::string& key, const std::function<GLuint()>& upload);
+
+    //Another Reference to a Texture Already in the Cache (False, and Nothing Held, Otherwise)
+    static bool retain(GLuint texture);
+
+    static void release(GLuint texture);
+
+    static size_t textureCount();
+    static size_t referenceCount(GLuint texture);
+
+    //Lexical Only (Unified Separators, "." and ".." Folded), so Two Spellings of One File Share an Entry
+    static std::string canonicalPath(const std::string& path);
+
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Fixed Set of Worker Threads for CPU Only Work (Heightmaps, Mesh Data). Tasks Must Not Touch GL,
+//Anything that Needs the Context Goes Back Through the FrameScheduler on the Main Thread
+class ThreadPool {
+
+public:
+
+    //0 Threads = One Less than the Hardware Thread Count (the Main Thread Helps in parallelFor), at Least One
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //Fire and Forget. Tasks Not Yet Started When the Pool is Destroyed are Dropped
+    void submit(std::function<void()> task);
+
+    //Runs body(i) for Every i in [0, count) Across the Workers and the Calling Thread, Returning Once All are Done
+    //The Caller Claims Indices Too, so Calling this from Inside a Task Can't Deadlock
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    size_t size() const { return workers.size(); }
+
+private:
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    void work();
+
+};
+
+#endif
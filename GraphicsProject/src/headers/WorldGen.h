@@ -0,0 +1,77 @@
+#ifndef WORLD_GEN_H
+#define WORLD_GEN_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "AliasTable.h"
+#include "Hash.h"
+#include "ThreadPool.h"
+
+//Chunk Content Generation (Building Placement and the Spawn Chunk Heightmap), Split from Generator so it Runs
+//and can be Benchmarked w/o a GL Context. Output Depends Only on the Chunk Position and the Building Weights
+class WorldGen {
+
+public:
+
+    static constexpr float CHUNK_SIZE = 1000.0f;
+    static constexpr int BUILDINGS_PER_CHUNK = 9;
+    static constexpr float ROAD_WIDTH = 100.0f;
+    static constexpr int HEIGHTMAP_RESOLUTION = 100;
+    static constexpr float NOISE_FREQUENCY = 0.00297f; //Noise Units per World Unit (0.03 per Grid Step at HEIGHTMAP_RESOLUTION)
+    static constexpr uint32_t DEFAULT_WORLD_SEED = 1;
+
+    struct Building {
+        glm::vec3 position; //Relative to the Chunk Origin
+        float rotation;
+        size_t modelIndex;
+    };
+
+    struct Chunk {
+        glm::ivec2 position;
+        uint32_t seed;
+        std::vector<Building> buildings;
+        std::vector<float> heightMap; //HEIGHTMAP_RESOLUTION^2 Heights for the Spawn Chunk, Empty Elsewhere
+        std::vector<float> normalMap; //Unit Normal (xyz) per Height, from the Noise's Analytic Gradient
+    };
+
+    WorldGen() = default;
+    explicit WorldGen(const std::vector<float>& buildingWeights, uint32_t worldSeed = DEFAULT_WORLD_SEED);
+
+    //One Weight per Building Model
+    void setBuildingWeights(const std::vector<float>& buildingWeights);
+
+    //Heightmap Rows are Split Across the Pool When One is Set (Output is Identical Either Way)
+    //Normals, When Asked for, Come from the Same Noise Evaluations as the Heights (No Neighbouring Samples Needed,
+    //so Every Row Stands Alone). They're the Smooth Surface's, Pointing Up, w/ x/z Spanning CHUNK_SIZE
+    void setThreadPool(ThreadPool* threadPool) { pool = threadPool; }
+
+    //Picks the Terrain's Noise Field (Building Placement Depends Only on Chunk Positions)
+    void setWorldSeed(uint32_t seed) { worldSeed = seed; }
+    uint32_t getWorldSeed() const { return worldSeed; }
+
+    void generate(const glm::ivec2& position, Chunk& chunk) const;
+
+    static uint32_t chunkSeed(const glm::ivec2& position);
+
+    //Heights for Any Chunk, Sampled from One World Space Noise Field per World Seed. Needs Nothing but its Arguments,
+    //so Chunks can be Generated Apart (and in Parallel), and Neighbours Generated at the Same Resolution Share their
+    //Border Rows Exactly. Heights are Unclamped at the Edges (Flattening to the Road Tiles is Left to the Drawing)
+    static std::vector<float> generateHeightMap(uint32_t worldSeed, const glm::ivec2& chunk, int resolution, ThreadPool* pool = nullptr,
+        std::vector<float>* normals = nullptr);
+
+    static const int HEIGHTMAP_TILE_ROWS = 32; //Rows per Parallel Task
+
+private:
+
+    AliasTable buildingTable; //Weighted Model Selection
+    ThreadPool* pool = nullptr;
+    uint32_t worldSeed = DEFAULT_WORLD_SEED;
+
+    size_t selectBuilding(uint32_t chunkSeed, uint32_t slot) const;
+
+};
+
+#endif
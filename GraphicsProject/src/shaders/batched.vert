@@ -0,0 +1,28 @@
+#version 330 core
+
+layout (location = 0) in vec3 vertexPosition;
+layout (location = 1) in vec3 vertexNormal;
+layout (location = 3) in vec3 vertexColour;
+layout (location = 7) in mat4 instanceMatrix;
+
+out vec2 TexCoords;
+out vec3 FragPos;
+out vec4 FragPosLightSpace;
+out vec3 Normal;
+out vec3 VertexColour;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform mat4 lightSpaceMatrix;
+
+//Building Arena Vertices Carry their Mesh's Diffuse Colour, so no Per Mesh Uniforms are Needed
+void main() {
+
+    TexCoords = vec2(0.0);
+    FragPos = vec3(instanceMatrix * vec4(vertexPosition, 1.0));
+    Normal = mat3(transpose(inverse(instanceMatrix))) * vertexNormal;
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+    FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
+    VertexColour = vertexColour;
+
+}
\ No newline at end of file
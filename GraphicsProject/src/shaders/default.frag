@@ -6,6 +6,7 @@ in vec2 TexCoords;
 in vec3 FragPos;
 in vec3 Normal;
 in vec4 FragPosLightSpace;
+in vec3 VertexColour;
 
 uniform sampler2D textureSampler;
 uniform sampler2D depthMap;
@@ -67,6 +68,9 @@ void main() {
     else if (useTexture == 2) {
         colour = texture(texture_diffuse1, TexCoords).rgb;
     }
+    else if (useTexture == 3) {
+        colour = VertexColour;
+    }
     else {
         colour = diffuseColour;
     }
@@ -9,6 +9,7 @@ out vec2 TexCoords;
 out vec3 FragPos;
 out vec4 FragPosLightSpace;
 out vec3 Normal;
+out vec3 VertexColour;
 
 uniform mat4 view;
 uniform mat4 projection;
@@ -21,5 +22,6 @@ void main() {
     Normal = mat3(transpose(inverse(instanceMatrix))) * vertexNormal;
     gl_Position = projection * view * vec4(FragPos, 1.0);
     FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
+    VertexColour = vec3(1.0);
 
 }
\ No newline at end of file
@@ -0,0 +1,36 @@
+#version 330 core
+
+out vec4 fragColour;
+
+in vec3 AtlasCoords;
+in vec3 FragPos;
+
+uniform sampler2DArray colourAtlas;
+uniform sampler2DArray normalAtlas;
+
+uniform vec3 lightDir;
+uniform vec3 viewPosition;
+
+void main() {
+
+    vec4 colour = texture(colourAtlas, AtlasCoords);
+    if (colour.a < 0.5) {
+        discard;
+    }
+
+    //Baked Normals are in Model Space, which Matches World Space as Buildings are Unrotated
+    vec3 normal = normalize(texture(normalAtlas, AtlasCoords).rgb * 2.0 - 1.0);
+    vec3 lightDirNorm = normalize(-lightDir);
+    vec3 viewDir = normalize(viewPosition - FragPos);
+    vec3 halfwayDir = normalize(lightDirNorm + viewDir);
+
+    //Same Lighting Terms as default.frag, Without Shadows
+    vec3 ambient = 0.2 * colour.rgb;
+    float diff = max(dot(normal, lightDirNorm), 0.0);
+    vec3 diffuse = 0.5 * diff * colour.rgb;
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), 32.0);
+    vec3 specular = 0.6 * spec * vec3(1.0);
+
+    fragColour = vec4(ambient + diffuse + specular, 1.0);
+
+}
@@ -0,0 +1,53 @@
+#version 330 core
+
+layout (location = 0) in vec2 corner;
+layout (location = 7) in vec4 instancePositionScale;
+layout (location = 8) in float instanceLayer;
+
+out vec3 AtlasCoords;
+out vec3 FragPos;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 viewPosition;
+uniform vec4 modelSpheres[16];
+uniform int frames;
+
+//Mirrors Octahedral.h, Keep them in Sync
+vec2 encodeHemiOctahedral(vec3 direction) {
+
+    direction.y = max(direction.y, 0.0);
+    direction /= abs(direction.x) + direction.y + abs(direction.z);
+    return vec2(direction.x + direction.z, direction.x - direction.z);
+
+}
+
+vec3 decodeHemiOctahedral(vec2 encoded) {
+
+    vec2 p = vec2(encoded.x + encoded.y, encoded.x - encoded.y) * 0.5;
+    return normalize(vec3(p.x, 1.0 - abs(p.x) - abs(p.y), p.y));
+
+}
+
+void main() {
+
+    vec4 sphere = modelSpheres[int(instanceLayer)];
+    float scale = instancePositionScale.w;
+    vec3 centre = instancePositionScale.xyz + sphere.xyz * scale;
+
+    //Pick the Baked Frame Closest to the Current View Direction
+    vec3 toViewer = normalize(viewPosition - centre);
+    vec2 uv = encodeHemiOctahedral(toViewer) * 0.5 + 0.5;
+    vec2 frame = clamp(floor(uv * float(frames)), vec2(0.0), vec2(float(frames - 1)));
+    vec3 direction = decodeHemiOctahedral((frame + 0.5) / float(frames) * 2.0 - 1.0);
+
+    //Quad Lies in the Frame's Image Plane, so it Lines Up w/ the Bake
+    vec3 right = cross(vec3(0.0, 1.0, 0.0), direction);
+    right = length(right) > 1e-4 ? normalize(right) : vec3(1.0, 0.0, 0.0);
+    vec3 up = cross(direction, right);
+
+    FragPos = centre + (right * corner.x + up * corner.y) * sphere.w * scale;
+    AtlasCoords = vec3((frame + corner * 0.5 + 0.5) / float(frames), instanceLayer);
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+
+}
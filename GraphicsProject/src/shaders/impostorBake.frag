@@ -0,0 +1,15 @@
+#version 330 core
+
+layout (location = 0) out vec4 bakedColour;
+layout (location = 1) out vec4 bakedNormal;
+
+in vec3 Normal;
+in vec3 VertexColour;
+
+void main() {
+
+    //Alpha Marks Coverage, Normals are Packed into [0, 1]
+    bakedColour = vec4(VertexColour, 1.0);
+    bakedNormal = vec4(normalize(Normal) * 0.5 + 0.5, 1.0);
+
+}
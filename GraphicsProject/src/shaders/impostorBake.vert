@@ -0,0 +1,21 @@
+#version 330 core
+
+layout (location = 0) in vec3 vertexPosition;
+layout (location = 1) in vec3 vertexNormal;
+layout (location = 3) in vec3 vertexColour;
+layout (location = 7) in mat4 instanceMatrix;
+
+out vec3 Normal;
+out vec3 VertexColour;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+//Renders One Building Model into an Impostor Frame. Lighting is Left to the Runtime Shader
+void main() {
+
+    Normal = mat3(transpose(inverse(instanceMatrix))) * vertexNormal;
+    VertexColour = vertexColour;
+    gl_Position = projection * view * instanceMatrix * vec4(vertexPosition, 1.0);
+
+}
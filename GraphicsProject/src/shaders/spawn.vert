@@ -3,6 +3,8 @@
 layout (location = 0) in vec3 vertexPos;
 layout (location = 1) in vec3 vertexNormal;
 layout (location = 2) in vec2 vertexTexCoords;
+layout (location = 5) in float packedHeight;  //Packed Spawn Chunk: [0, 1] Across the Mesh's Height Range
+layout (location = 6) in vec2 packedNormal;   //Packed Spawn Chunk: Octahedral, [0, 1]
 
 out vec2 TexCoords;
 out vec3 FragPos;
@@ -14,11 +16,50 @@ uniform mat4 view;
 uniform mat4 projection;
 uniform mat4 lightSpaceMatrix;
 
+//Spawn Chunk from Packed Vertices (Terrain::buildPackedHeightmapMesh): the Grid Position Comes from gl_VertexID
+uniform int heightResolution;
+uniform float heightMin;
+uniform float heightRange;
+uniform int usePackedVertices;
+
+//Attrib: Cigolle et al., A Survey of Efficient Representations for Independent Unit Vectors (y as the Octahedron's Axis)
+vec3 octahedralDecode(vec2 encoded) {
+
+    vec2 e = encoded * 2.0 - 1.0;
+    vec3 n = vec3(e.x, 1.0 - abs(e.x) - abs(e.y), e.y);
+    if (n.y < 0.0) {
+        vec2 signs = vec2(n.x >= 0.0 ? 1.0 : -1.0, n.z >= 0.0 ? 1.0 : -1.0);
+        n.xz = (1.0 - abs(n.zx)) * signs;
+    }
+    return normalize(n);
+
+}
+
 void main() {
 
-    FragPos = vec3(model * vec4(vertexPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * vertexNormal;
-    TexCoords = vertexTexCoords;
+    vec3 position = vertexPos;
+    vec3 normal = vertexNormal;
+    vec2 texCoords = vertexTexCoords;
+
+    //Same Grid and Flattened Edges as HeightmapMesher
+    if (usePackedVertices == 1) {
+
+        int last = heightResolution - 1;
+        int x = gl_VertexID % heightResolution;
+        int z = gl_VertexID / heightResolution;
+        float gridSize = 1000.0 / float(last);
+        bool isEdge = x == 0 || z == 0 || x == last || z == last;
+
+        float height = isEdge ? 0.0 : heightMin + packedHeight * heightRange;
+        position = vec3(float(x) * gridSize - 500.0, height - 50.0, float(z) * gridSize - 500.0);
+        normal = octahedralDecode(packedNormal);
+        texCoords = vec2(float(x), float(z)) / float(last) * 10.0;
+
+    }
+
+    FragPos = vec3(model * vec4(position, 1.0));
+    Normal = mat3(transpose(inverse(model))) * normal;
+    TexCoords = texCoords;
     FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
     gl_Position = projection * view * vec4(FragPos, 1.0);
 
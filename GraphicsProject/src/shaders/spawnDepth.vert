@@ -1,12 +1,34 @@
 #version 330 core
 
 layout (location = 0) in vec3 vertexPosition;
+layout (location = 5) in float packedHeight; //Packed Spawn Chunk (as in spawn.vert)
 
 uniform mat4 lightSpaceMatrix;
 uniform mat4 model;
 
+//Spawn Chunk from Packed Vertices (Positions Only, as in spawn.vert)
+uniform int heightResolution;
+uniform float heightMin;
+uniform float heightRange;
+uniform int usePackedVertices;
+
 void main() {
 
-    gl_Position = lightSpaceMatrix * model * vec4(vertexPosition, 1.0);
+    vec3 position = vertexPosition;
+
+    if (usePackedVertices == 1) {
+
+        int last = heightResolution - 1;
+        int x = gl_VertexID % heightResolution;
+        int z = gl_VertexID / heightResolution;
+        float gridSize = 1000.0 / float(last);
+        bool isEdge = x == 0 || z == 0 || x == last || z == last;
+
+        float height = heightMin + packedHeight * heightRange;
+        position = vec3(float(x) * gridSize - 500.0, (isEdge ? 0.0 : height) - 50.0, float(z) * gridSize - 500.0);
+
+    }
+
+    gl_Position = lightSpaceMatrix * model * vec4(position, 1.0);
 
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#version 330 core
+
+//CDLOD Terrain: One Grid Patch per Quadtree Node, Displaced by the Chunk's Height Tile
+
+layout (location = 0) in vec2 gridPosition; //[0, 1] Across the Patch
+layout (location = 3) in vec4 node;         //Origin x, Origin z, Size, Level
+layout (location = 4) in vec4 tile;         //Chunk Min x, Chunk Min z, Layer
+
+out vec2 TexCoords;
+out vec3 FragPos;
+out vec3 Normal;
+out vec4 FragPosLightSpace;
+
+uniform mat4 view;
+uniform mat4 projection;
+uniform mat4 lightSpaceMatrix;
+
+uniform sampler2DArray heightTiles;
+uniform sampler2DArray slopeTiles; //dh/dx, dh/dz per Height Sample
+uniform vec3 cameraPosition;
+uniform vec2 morphRanges[4];
+uniform float chunkSize;
+uniform float tileResolution;
+uniform float patchQuads;
+uniform float baseHeight;
+
+//Texel Centres Sit on the Height Grid's Samples, so Bilinear Filtering Matches the Spawn Chunk Mesh's Triangles
+vec2 tileCoords(vec2 local) {
+
+    return (local * (tileResolution - 1.0) + 0.5) / tileResolution;
+
+}
+
+float sampleHeight(vec2 local) {
+
+    return texture(heightTiles, vec3(tileCoords(local), tile.z)).r;
+
+}
+
+void main() {
+
+    vec2 world = node.xy + gridPosition * node.z;
+    float height = sampleHeight((world - tile.xy) / chunkSize) + baseHeight;
+
+    //Morph Odd Grid Vertices onto their Even Neighbours as the Node Nears the End of its Level's Range
+    vec2 range = morphRanges[int(node.w)];
+    float distanceToCamera = distance(cameraPosition, vec3(world.x, height, world.y));
+    float morph = clamp((distanceToCamera - range.x) / (range.y - range.x), 0.0, 1.0);
+
+    vec2 oddOffset = fract(gridPosition * patchQuads * 0.5) * 2.0 / patchQuads;
+    world -= oddOffset * node.z * morph;
+
+    vec2 local = (world - tile.xy) / chunkSize;
+    height = sampleHeight(local) + baseHeight;
+
+    //Slopes are Filtered Like the Heights, and the Surface y = h(x, z) has Normal (-dh/dx, 1, -dh/dz)
+    vec2 slope = texture(slopeTiles, vec3(tileCoords(local), tile.z)).rg;
+    Normal = normalize(vec3(-slope.x, 1.0, -slope.y));
+
+    FragPos = vec3(world.x, height, world.y);
+    TexCoords = local * 10.0;
+    FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+
+}
@@ -0,0 +1,41 @@
+#version 330 core
+
+//Shadow Pass Version of terrainLOD.vert (Same Displacement and Morph, Position Only)
+
+layout (location = 0) in vec2 gridPosition;
+layout (location = 3) in vec4 node;
+layout (location = 4) in vec4 tile;
+
+uniform mat4 lightSpaceMatrix;
+
+uniform sampler2DArray heightTiles;
+uniform vec3 cameraPosition;
+uniform vec2 morphRanges[4];
+uniform float chunkSize;
+uniform float tileResolution;
+uniform float patchQuads;
+uniform float baseHeight;
+
+float sampleHeight(vec2 local) {
+
+    vec2 uv = (local * (tileResolution - 1.0) + 0.5) / tileResolution;
+    return texture(heightTiles, vec3(uv, tile.z)).r;
+
+}
+
+void main() {
+
+    vec2 world = node.xy + gridPosition * node.z;
+    float height = sampleHeight((world - tile.xy) / chunkSize) + baseHeight;
+
+    vec2 range = morphRanges[int(node.w)];
+    float distanceToCamera = distance(cameraPosition, vec3(world.x, height, world.y));
+    float morph = clamp((distanceToCamera - range.x) / (range.y - range.x), 0.0, 1.0);
+
+    vec2 oddOffset = fract(gridPosition * patchQuads * 0.5) * 2.0 / patchQuads;
+    world -= oddOffset * node.z * morph;
+
+    height = sampleHeight((world - tile.xy) / chunkSize) + baseHeight;
+    gl_Position = lightSpaceMatrix * vec4(world.x, height, world.y, 1.0);
+
+}